@@ -22,6 +22,7 @@ def config_template() -> dict:
             }
         ],
         "cleanup": True,
+        "component-workers": 4,
         "concurrent-runs": True,
         "contraction-output-stem": "Contraction",
         "contraction-predicates": [
@@ -41,9 +42,11 @@ def config_template() -> dict:
         "maxNeighbours": 5,
         "memgraph-host": "localhost",
         "memgraph-port": 7687,
+        "memgraph-connections": 4,
         "memgraph-user": "",
         "memgraph-password": "",
         "merge-workers": 2,
+        "neighbour-workers": 4,
         "neighbouring-files-predicate": "WSF",
         "neighbouring-predicates": [],
         "splits": 0,
@@ -7,6 +7,7 @@
 #include "JobDAG.hpp"
 #include "JobWriter.hpp"
 #include "JobGeneratorConfig.hpp"
+#include "NeighbouringFilesIndex.hpp"
 
 class JobGenerator{
 private:
@@ -52,20 +53,39 @@ private:
         return fileToCoordinate;
     }
 
-    std::vector<NeighboursJob> generateNeighboursJobs(const std::unordered_map<std::filesystem::path,FilterJob> & inputToFilterJobMap,JobDAG_t & jobDag) noexcept {
-        auto filteredFilenameMapper = [this](std::filesystem::path const & path){
-            return this->workingDirectory / fishnet::util::PathHelper::appendToFilename(path,"_filtered").filename().replace_extension(".shp");
-        };
+    /**
+     * @brief Computes the neighbouring files of each input, using a spatial hash over the coordinates in the filenames of the known predicate types
+     * 
+     * @param inputs input files
+     * @return std::unordered_map<std::filesystem::path,std::unordered_set<std::filesystem::path>> map from each input to its neighbouring inputs
+     */
+    std::unordered_map<std::filesystem::path,std::unordered_set<std::filesystem::path>> neighbouringFiles(fishnet::util::forward_range_of<std::filesystem::path> auto && inputs) const {
+        switch(config.neighbouringFilesPredicateType) {
+            case NeighbouringFilesPredicateType::TILES:
+                return NeighbouringFilesIndex<NeighbouringFileTilesPredicate>(inputs).adjacency();
+            case NeighbouringFilesPredicateType::WSF:
+                return NeighbouringFilesIndex<NeighbouringWSFFilesPredicate>(inputs).adjacency();
+            default:
+                break;
+        }
         std::unordered_map<std::filesystem::path,std::unordered_set<std::filesystem::path>> dependencyMap;
-        for(const auto & [lhsInput,_] : inputToFilterJobMap){
+        for(const auto & lhsInput : inputs){
             dependencyMap.try_emplace(lhsInput,std::unordered_set<std::filesystem::path>());
-            for(const auto & [rhsInput,_] : inputToFilterJobMap){
+            for(const auto & rhsInput : inputs){
                 if(lhsInput == rhsInput)
                     continue;
                 if( config.neighbouringFilesPredicate(lhsInput,rhsInput))
                     dependencyMap.at(lhsInput).insert(rhsInput);
             }
         }
+        return dependencyMap;
+    }
+
+    std::vector<NeighboursJob> generateNeighboursJobs(const std::unordered_map<std::filesystem::path,FilterJob> & inputToFilterJobMap,JobDAG_t & jobDag) noexcept {
+        auto filteredFilenameMapper = [this](std::filesystem::path const & path){
+            return this->workingDirectory / fishnet::util::PathHelper::appendToFilename(path,"_filtered").filename().replace_extension(".shp");
+        };
+        auto dependencyMap = neighbouringFiles(std::views::keys(inputToFilterJobMap));
         std::unordered_map<std::filesystem::path,NeighboursJob> inputToNeighboursJobMap;
         for(const auto & [input,filterJob]: inputToFilterJobMap){
             NeighboursJob job;
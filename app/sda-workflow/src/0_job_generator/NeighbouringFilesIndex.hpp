@@ -0,0 +1,81 @@
+#pragma once
+#include <filesystem>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <fishnet/Vec2D.hpp>
+#include <fishnet/CollectionConcepts.hpp>
+#include "NeighbouringFilesPredicates.hpp"
+
+/**
+ * @brief Predicate on files, which are neighbouring if their grid coordinates (parsed from the filename) differ by at most RADIUS on each axis
+ */
+template<typename P>
+concept GridNeighbouringFilesPredicate = requires(const P & predicate, std::filesystem::path const & file, fishnet::geometry::Vec2D<int> coordinate){
+    {predicate.coordinate(file)} -> std::same_as<std::optional<fishnet::geometry::Vec2D<int>>>;
+    {predicate.areNeighbours(coordinate,coordinate)} -> std::convertible_to<bool>;
+    {P::RADIUS} -> std::convertible_to<int>;
+};
+
+/**
+ * @brief Spatial hash over the grid coordinates of files, to find neighbouring files without testing every pair of files.
+ * The filename of each file is parsed once, files are bucketed by their coordinate and only the (2*RADIUS+1)^2 surrounding buckets are tested with the predicate.
+ * Files without a coordinate in their filename have no neighbours, as for the predicate itself.
+ * @tparam P grid neighbouring files predicate, e.g. NeighbouringFileTilesPredicate or NeighbouringWSFFilesPredicate
+ */
+template<GridNeighbouringFilesPredicate P>
+class NeighbouringFilesIndex{
+private:
+    using Coordinate = fishnet::geometry::Vec2D<int>;
+    P predicate;
+    std::vector<std::pair<std::filesystem::path,std::optional<Coordinate>>> files;
+    std::unordered_map<int64_t,std::vector<size_t>> cells; // packed coordinate -> indices in files
+
+    static int64_t cellKey(int x, int y) noexcept {
+        return (int64_t(x) << 32) | int64_t(uint32_t(y));
+    }
+
+    template<typename F>
+    void forEachNeighbour(size_t index, F && f) const {
+        const auto & [file,coordinate] = files[index];
+        if(not coordinate)
+            return;
+        for(int dx = -P::RADIUS; dx <= P::RADIUS; ++dx) {
+            for(int dy = -P::RADIUS; dy <= P::RADIUS; ++dy) {
+                auto cell = cells.find(cellKey(coordinate->x+dx,coordinate->y+dy));
+                if(cell == cells.end())
+                    continue;
+                for(size_t other: cell->second) {
+                    const auto & [otherFile,otherCoordinate] = files[other];
+                    if(otherFile != file && predicate.areNeighbours(coordinate.value(),otherCoordinate.value()))
+                        f(otherFile);
+                }
+            }
+        }
+    }
+
+public:
+    NeighbouringFilesIndex(fishnet::util::forward_range_of<std::filesystem::path> auto && paths, P predicate = P()):predicate(std::move(predicate)){
+        for(const auto & path: paths) {
+            auto coordinate = this->predicate.coordinate(path);
+            if(coordinate)
+                cells[cellKey(coordinate->x,coordinate->y)].push_back(files.size());
+            files.emplace_back(path,coordinate);
+        }
+    }
+
+    /**
+     * @brief Get the neighbouring files of each indexed file
+     *
+     * @return std::unordered_map<std::filesystem::path,std::unordered_set<std::filesystem::path>> map from each file to the set of its neighbouring files
+     */
+    std::unordered_map<std::filesystem::path,std::unordered_set<std::filesystem::path>> adjacency() const {
+        std::unordered_map<std::filesystem::path,std::unordered_set<std::filesystem::path>> result;
+        result.reserve(files.size());
+        for(size_t i = 0; i < files.size(); ++i) {
+            auto & neighbours = result[files[i].first];
+            forEachNeighbour(i,[&neighbours](const std::filesystem::path & neighbour){neighbours.insert(neighbour);});
+        }
+        return result;
+    }
+};
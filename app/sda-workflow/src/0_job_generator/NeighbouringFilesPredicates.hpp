@@ -10,52 +10,78 @@ enum class NeighbouringFilesPredicateType {
     TILES, WSF
 };
 
+namespace __impl {
+/**
+ * @brief Parses the coordinate from a filename of the form <name>_<x>_<y>.<extension>
+ * 
+ * @param input filename
+ * @param pattern compiled regular expression with the x and y coordinate as 2nd and 3rd group
+ * @return std::optional<fishnet::geometry::Vec2D<int>> coordinate, or empty if the filename does not match the pattern
+ */
+static std::optional<fishnet::geometry::Vec2D<int>> coordinateFromFilename(const std::string & input, const std::regex & pattern) noexcept {
+    std::smatch matches;
+    if (std::regex_match(input, matches, pattern) && matches.size() == 4) {
+        int x = std::stoi(matches[2].str());
+        int y = std::stoi(matches[3].str());
+        return fishnet::geometry::Vec2D(x,y);
+    }
+    return std::nullopt;
+}
+}
+
 struct NeighbouringFileTilesPredicate{
-    
+    /**
+     * @brief Maximum difference of the tile coordinates of neighbouring files, per axis
+     */
+    constexpr static int RADIUS = 1;
+
     std::optional<fishnet::geometry::Vec2D<int>> tileCoordinateFromFilenames(const std::string & input)const noexcept{
-        std::regex pattern(R"((.+)_(-?\d+)_(-?\d+)\.shp)");
-        std::smatch matches;
+        static const std::regex pattern(R"((.+)_(-?\d+)_(-?\d+)\.shp)"); // compiled once, matching on a const regex is thread-safe
+        return __impl::coordinateFromFilename(input,pattern);
+    }
 
-        if (std::regex_match(input, matches, pattern) && matches.size() == 4) {
-            int x = std::stoi(matches[2].str());
-            int y = std::stoi(matches[3].str());
-            return fishnet::geometry::Vec2D(x,y);
-        }
-        return std::nullopt;
+    std::optional<fishnet::geometry::Vec2D<int>> coordinate(std::filesystem::path const & file) const noexcept {
+        return tileCoordinateFromFilenames(file.filename().string());
+    }
+
+    bool areNeighbours(fishnet::geometry::Vec2D<int> lhs, fishnet::geometry::Vec2D<int> rhs) const noexcept {
+        return lhs.distance(rhs) <= 1.5;
     }
 
     bool operator()(std::filesystem::path const & lhs, std::filesystem::path const & rhs) const noexcept {
-        auto l = tileCoordinateFromFilenames(lhs.filename().string());
-        auto r = tileCoordinateFromFilenames(rhs.filename().string());
+        auto l = coordinate(lhs);
+        auto r = coordinate(rhs);
         if(l and r){
-            return l->distance(r.value()) <= 1.5;
+            return areNeighbours(l.value(),r.value());
         }   
         return false;
     }
 };
 
 struct NeighbouringWSFFilesPredicate{
+    /**
+     * @brief Maximum difference of the coordinates of neighbouring files, per axis
+     */
+    constexpr static int RADIUS = 2;
 
     std::optional<fishnet::geometry::Vec2D<int>> spatialCoordinatesFromFilename(const std::string & input)const noexcept{
-        std::regex pattern(R"((.+)_(-?\d+)_(-?\d+)\..+)");
-        std::smatch matches;
+        static const std::regex pattern(R"((.+)_(-?\d+)_(-?\d+)\..+)"); // compiled once, matching on a const regex is thread-safe
+        return __impl::coordinateFromFilename(input,pattern);
+    }
 
-        if (std::regex_match(input, matches, pattern) && matches.size() == 4) {
-            int x = std::stoi(matches[2].str());
-            int y = std::stoi(matches[3].str());
-            return fishnet::geometry::Vec2D(x,y);
-        }
-        return std::nullopt;
+    std::optional<fishnet::geometry::Vec2D<int>> coordinate(std::filesystem::path const & file) const noexcept {
+        return spatialCoordinatesFromFilename(file.filename().string());
     }
 
+    bool areNeighbours(fishnet::geometry::Vec2D<int> lhs, fishnet::geometry::Vec2D<int> rhs) const noexcept {
+        return abs(lhs.x-rhs.x) <= RADIUS && abs(lhs.y-rhs.y) <= RADIUS;
+    }
 
     bool operator()(std::filesystem::path const & lhs, std::filesystem::path const & rhs) const noexcept {
-        auto l = spatialCoordinatesFromFilename(lhs.filename().string());
-        auto r = spatialCoordinatesFromFilename(rhs.filename().string());
+        auto l = coordinate(lhs);
+        auto r = coordinate(rhs);
         if(l and r){
-            auto leftCoordinate = l.value();
-            auto rightCoordinate = r.value();
-            return abs(leftCoordinate.x-rightCoordinate.x) <= 2 && abs(leftCoordinate.y-rightCoordinate.y) <= 2;
+            return areNeighbours(l.value(),r.value());
         }   
         return false;
     }
@@ -11,5 +11,5 @@ concept Executor= std::convertible_to<E,Executor_t>  && requires(E & executor,Ca
 };
 
 enum class ExecutorType{
-    CWLTOIL, CWLTOOL
+    CWLTOIL, CWLTOOL, INPROCESS
 };
\ No newline at end of file
@@ -0,0 +1,190 @@
+#pragma once
+#include <memory>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <thread>
+#include <nlohmann/json.hpp>
+#include <magic_enum.hpp>
+#include <fishnet/ThreadPool.hpp>
+#include <fishnet/Polygon.hpp>
+#include <fishnet/MultiPolygon.hpp>
+#include <fishnet/Shapefile.hpp>
+#include <fishnet/GISFactory.hpp>
+#include "Job.hpp"
+#include "Executor.hpp"
+#include "SettlementFilterTask.h"
+#include "FindNeighboursTask.h"
+#include "ConnectedComponentsTask.h"
+#include "ContractionTask.h"
+#include "AnalysisTask.h"
+#include "MergeShapefilesTask.h"
+
+/**
+ * @brief Executor running the tasks of the jobs directly in this process on a thread pool, instead of starting cwltool / toil for each job.
+ * The tasks are configured from the same job files (json) as the cwl executors.
+ * Split jobs are delegated to the shapefile splitter executable, since it is not available as a task.
+ * The tasks share the memgraph session of this process, which has to be set before the first job is executed,
+ * and the worker threads of each task are capped, such that the concurrent tasks do not oversubscribe the cores.
+ */
+class InProcessExecutor{
+private:
+    using PolygonType = fishnet::geometry::Polygon<double>;
+    using MultiPolygonType = fishnet::geometry::MultiPolygon<PolygonType>;
+    constexpr static const char * FILTER_OUTPUT_SUFFIX = "_filtered.shp";
+
+    std::string splitterCommand;
+    size_t workersPerTask;
+    Callback_t callback;
+    std::shared_ptr<fishnet::util::ThreadPool> pool; // shared, since executors have to be copyable. Declared last to join before the callback is destroyed
+
+    static std::filesystem::path filePath(const json & file) {
+        return file.at("path").get<std::string>();
+    }
+
+    static std::vector<fishnet::Shapefile> shapefiles(const json & files) {
+        std::vector<fishnet::Shapefile> result;
+        for(const auto & file: files) {
+            result.emplace_back(filePath(file));
+        }
+        return result;
+    }
+
+    static json parse(const std::filesystem::path & path) {
+        std::ifstream is {path};
+        if(not is)
+            throw std::runtime_error("Could not open file: "+path.string());
+        return json::parse(is);
+    }
+
+    static size_t workflowID(const json & jobDesc) {
+        size_t id = jobDesc.contains("workflowID") ? jobDesc.at("workflowID").get<size_t>() : 0;
+        size_t session = MemgraphConnection::hasSession() ? MemgraphConnection::getSession().id() : 0;
+        if(id != session) // the session is shared by all tasks, therefore it must not be changed by a task
+            throw std::runtime_error("Job of workflow session "+std::to_string(id)+" can not be executed in session "+std::to_string(session));
+        return id;
+    }
+
+    void split(const json & jobDesc) const {
+        std::stringstream command;
+        command << splitterCommand
+                << " -i " << filePath(jobDesc.at("shpFile"))
+                << " -o " << std::filesystem::path(jobDesc.at("outputDir").get<std::string>())
+                << " -s " << jobDesc.at("splits").get<uint32_t>()
+                << " -x " << jobDesc.value("xOffset",0)
+                << " -y " << jobDesc.value("yOffset",0);
+        if(std::system(command.str().c_str()) != 0)
+            throw std::runtime_error("Split command failed: "+command.str());
+    }
+
+    static void filter(const json & jobDesc) {
+        auto config = FilterConfig<PolygonType>(parse(filePath(jobDesc.at("config"))));
+        auto input = fishnet::GISFactory::asShapefile(filePath(jobDesc.at("shpFile")));
+        auto task = input.transform([&config](const auto & input){
+            fishnet::Shapefile output {config.workingDirectory / std::filesystem::path(input.getPath().stem().string() + FILTER_OUTPUT_SUFFIX)};
+            return SettlementFilterTask<PolygonType>(std::move(config),input,output);
+        });
+        getExpectedOrThrowError(task).run();
+    }
+
+    void neighbours(const json & jobDesc) const {
+        FindNeighboursConfig config {parse(filePath(jobDesc.at("config")))};
+        config.workers = std::min(config.workers,workersPerTask);
+        FindNeighboursTask<PolygonType> task {std::move(config),fishnet::Shapefile(filePath(jobDesc.at("primaryInput"))),workflowID(jobDesc)};
+        for(auto && shapefile: shapefiles(jobDesc.value("additionalInput",json::array()))) {
+            task.addShapefile(std::move(shapefile));
+        }
+        task.run();
+    }
+
+    void components(const json & jobDesc) const {
+        auto configFile = filePath(jobDesc.at("config"));
+        ConnectedComponentsConfig config {parse(configFile)};
+        config.workers = std::min(config.workers,workersPerTask);
+        ConnectedComponentsTask task {std::move(config),std::filesystem::path(jobDesc.at("jobDirectory").get<std::string>()),std::move(configFile),workflowID(jobDesc)};
+        task.run();
+    }
+
+    void contraction(const json & jobDesc) const {
+        ContractionConfig config {parse(filePath(jobDesc.at("config")))};
+        config.workers = static_cast<u_int8_t>(std::min<size_t>(config.workers,workersPerTask));
+        std::vector<ComponentReference> components;
+        for(auto componentId: jobDesc.value("components",std::vector<uint64_t>())) {
+            components.push_back(ComponentReference{int64_t(componentId)});
+        }
+        fishnet::Shapefile output {config.workingDirectory / std::filesystem::path(jobDesc.at("outputStem").get<std::string>()+".shp")};
+        ContractionTask<PolygonType> task {std::move(config),std::move(components),output,workflowID(jobDesc)};
+        for(auto && input: shapefiles(jobDesc.at("shpFiles"))) {
+            task.addInput(std::move(input));
+        }
+        task.run();
+    }
+
+    static void analysis(const json & jobDesc) {
+        AnalysisConfig config {parse(filePath(jobDesc.at("config")))};
+        fishnet::Shapefile output {config.workingDirectory / std::filesystem::path(jobDesc.at("outputStem").get<std::string>()+".shp")};
+        AnalysisTask<MultiPolygonType> task {std::move(config),fishnet::Shapefile(filePath(jobDesc.at("shpFile"))),output,workflowID(jobDesc)};
+        task.run();
+    }
+
+    static void merge(const json & jobDesc) {
+        auto inputs = shapefiles(jobDesc.at("shpFiles"));
+        if(inputs.empty())
+            throw std::runtime_error("No input files provided");
+        MergeShapefilesTask<MultiPolygonType> task {std::move(inputs),fishnet::Shapefile(jobDesc.at("outputPath").get<std::string>())};
+        task.run();
+    }
+
+    void run(const Job & job) const {
+        json jobDesc = parse(job.file);
+        switch(job.type) {
+            case JobType::SPLIT:
+                return split(jobDesc);
+            case JobType::FILTER:
+                return filter(jobDesc);
+            case JobType::NEIGHBOURS:
+                return neighbours(jobDesc);
+            case JobType::COMPONENTS:
+                return components(jobDesc);
+            case JobType::CONTRACTION:
+                return contraction(jobDesc);
+            case JobType::ANALYSIS:
+                return analysis(jobDesc);
+            case JobType::MERGE:
+                return merge(jobDesc);
+            default:
+                throw std::runtime_error("No task for job type: "+std::string(magic_enum::enum_name(job.type)));
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new In Process Executor
+     *
+     * @param numThreads number of jobs executed concurrently
+     * @param splitterCommand command of the shapefile splitter, used for split jobs
+     */
+    InProcessExecutor(size_t numThreads, std::string && splitterCommand = "FishnetShapefileSplitter")
+    :splitterCommand(std::move(splitterCommand)),
+    workersPerTask(std::max<size_t>(1,std::thread::hardware_concurrency()/std::max<size_t>(1,numThreads))),
+    pool(std::make_shared<fishnet::util::ThreadPool>(numThreads)){}
+
+    void setCallback(Callback_t && callback){
+        this->callback = std::move(callback);
+    }
+
+    void operator()(Job job){
+        pool->submit([this,job=std::move(job)]()mutable{
+            try{
+                run(job);
+                job.updateStatus(JobState::SUCCEED);
+            }catch(const std::exception & error) {
+                std::cerr << "Job " << job.id << " (" << job.file.filename() << ") failed:" << std::endl << error.what() << std::endl;
+                job.updateStatus(JobState::FAILED);
+            }
+            callback(job);
+        });
+    }
+};
+static_assert(Executor<InProcessExecutor>);
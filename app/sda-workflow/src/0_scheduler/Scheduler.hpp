@@ -1,5 +1,9 @@
 #pragma once
-#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <unordered_map>
+#include <optional>
+#include <fishnet/ConnectionPool.hpp>
 #include "JobDAG.hpp"
 #include "CwlToolExecutor.hpp"
 #include "Executor.hpp"
@@ -31,79 +35,111 @@ using SchedulerObserver_t = std::function<void(const Scheduler &)>;
 class Scheduler {
 private:
     friend class SchedulerLog;
+    /**
+     * @brief In-memory state of a job during a call to schedule()
+     */
+    struct Execution {
+        Job job;
+        size_t unfinishedParents = 0;
+        std::vector<size_t> children = {};
+    };
+
     mutable std::mutex mutex;
+    std::condition_variable finishedCondition;
+    std::deque<Job> finishedJobs; // jobs reported by the executor, consumed by schedule()
     JobDAG_t dag;
     Executor_t executor;
     JobType lastJobType;
-    std::atomic_uint16_t activeThreads = 0;
     SchedulerLog log;
     size_t threadConcurrency;
     std::vector<SchedulerObserver_t> listener = {};
+    std::optional<MemgraphConnectionPool> connectionPool; // if present, queries are issued concurrently on leased connections
 
-
-    bool isFinished(const Job & job) const noexcept {
+    static bool isFinished(const Job & job) noexcept {
         return job.state == JobState::FAILED || job.state == JobState::SUCCEED;
     }
 
-    bool isRunnable(const Job & job) const noexcept {
+    static bool isRunnable(const Job & job) noexcept {
         return job.state == JobState::RUNNABLE;
     }
 
-    bool canBeScheduled( Job & job) const noexcept {
-        if(job.type > lastJobType){
-            updateJobState(job,JobState::ABORTED);
-            return false;
-        }
-        if(not isRunnable(job) || activeThreads >= threadConcurrency)
-            return false;
-        return this->dag.inDegree(job) == 0 || std::ranges::all_of(dag.getReachableFrom(job),[this](const Job & parent){return this->isFinished(parent);});
-    }
-
-    void updateJobState(Job & job, JobState newState)const noexcept {
+    void updateJobState(Job & job, JobState newState) noexcept {
         if(job.state != newState){
             job.updateStatus(newState);
-            persistJobState(job);
+            if(connectionPool) {
+                persistJobState(job);
+            }else {
+                std::lock_guard lock {this->mutex};
+                persistJobState(job);
+            }
             printOnJobStateChange(job);
         }
     }
 
     void persistJobState(const Job & job) const noexcept{
-        this->getDAG().getAdjacencyContainer().updateJobState(job);
+        if(not connectionPool) {
+            this->getDAG().getAdjacencyContainer().updateJobState(job);
+            return;
+        }
+        try{
+            connectionPool->lease()->executeAndDiscard(JobAdjacency::updateJobStateQuery(job));
+        }catch(const std::runtime_error & error) {
+            std::cerr << "Could not persist state of job " << job.id << ":" << std::endl << error.what() << std::endl;
+        }
     }
 
     auto onFinishedCallback() noexcept{
         return [this](const Job & job){
-            std::lock_guard lock {this->mutex};
-            this->persistJobState(job);
-            printOnJobStateChange(job);
-            if(job.state==JobState::FAILED)
-                this->log.failedJobs.push_back(job);
-            this->activeThreads--;
+            if(this->connectionPool)
+                this->persistJobState(job); // does not require the lock, since the connection is not shared
+            {
+                std::lock_guard lock {this->mutex};
+                if(not this->connectionPool)
+                    this->persistJobState(job);
+                printOnJobStateChange(job);
+                this->finishedJobs.push_back(job);
+            }
+            this->finishedCondition.notify_one();
         };
     }
 
-    bool hasRunnableJobs() const noexcept {
-        std::lock_guard lock {this->mutex};
-        const MemgraphConnection & connection = this->dag.getAdjacencyContainer().getConnection();
-        if(connection.execute(CipherQuery().match(Node{.name="j",.label=Label::Job,.attributes="state:\"RUNNABLE\""}).ret("j.id"))){
-            auto result = connection->FetchAll();
-            return result.has_value() && result->size() > 0;
-        }   
-        return false;
+    /**
+     * @brief Loads the jobs and their dependencies from the DAG once, aborting jobs behind the last job type.
+     * Jobs without unfinished parents are added to the ready queue.
+     */
+    std::unordered_map<size_t,Execution> loadExecutions(std::deque<size_t> & ready) {
+        std::unordered_map<size_t,Execution> executions;
+        for(const Job & job: dag.getNodes()){
+            executions.try_emplace(job.id,Execution{.job=job});
+        }
+        for(const auto & edge: dag.getEdges()){
+            auto from = executions.find(edge.getFrom().id);
+            auto to = executions.find(edge.getTo().id);
+            if(from == executions.end() || to == executions.end())
+                continue;
+            from->second.children.push_back(to->first);
+            if(not isFinished(from->second.job))
+                to->second.unfinishedParents++;
+        }
+        for(auto & [id,execution]: executions){
+            if(lastJobType < execution.job.type){
+                updateJobState(execution.job,JobState::ABORTED);
+                continue;
+            }
+            if(isRunnable(execution.job) && execution.unfinishedParents == 0)
+                ready.push_back(id);
+        }
+        return executions;
     }
 
-    bool jobsAreRunning() const noexcept {
+    void notifyListeners() {
         std::lock_guard lock {this->mutex};
-        const MemgraphConnection & connection = this->dag.getAdjacencyContainer().getConnection();
-        if(connection.execute(CipherQuery().match(Node{.name="j",.label=Label::Job,.attributes="state:\"RUNNING\""}).ret("j.id"))){
-            auto result = connection->FetchAll();
-            return result.has_value() && result->size() > 0;
-        }   
-        return false;
+        std::ranges::for_each(this->listener,[this](auto && o){o(*this);});
     }
     
 public:
-    Scheduler(JobDAG_t && dag,Executor auto && executor,JobType lastJobType,size_t concurrency):dag(std::move(dag)),lastJobType(lastJobType),threadConcurrency(concurrency){
+    Scheduler(JobDAG_t && dag,Executor auto && executor,JobType lastJobType,size_t concurrency, std::optional<MemgraphConnectionPool> && connectionPool = std::nullopt)
+    :dag(std::move(dag)),lastJobType(lastJobType),threadConcurrency(concurrency),connectionPool(std::move(connectionPool)){
          static_assert(std::convertible_to<decltype(this->onFinishedCallback()),Callback_t>);
          if(concurrency==0)
             this->threadConcurrency = std::thread::hardware_concurrency();
@@ -111,29 +147,50 @@ public:
          this->executor = std::move(executor);
     }
 
+    /**
+     * @brief Runs all runnable jobs of the DAG, respecting their dependencies, until no job can be scheduled anymore.
+     * The DAG is loaded once per call; afterwards the scheduler only reacts to jobs reported as finished by the executor,
+     * starting the children whose parents have all finished. At most threadConcurrency jobs are executed at the same time.
+     */
     void schedule() {
-        while(hasRunnableJobs() || jobsAreRunning()){
-            std::vector<Job> jobsToRun;
-            {
-                std::lock_guard lock {this->mutex};
-                for(auto & job: dag.getNodes()){
-                    if(canBeScheduled(job)){
-                        activeThreads++;
-                        jobsToRun.push_back(job);
-                        updateJobState(job,JobState::RUNNING);
-                    }
-                }
-            }
-            for(const auto & job: jobsToRun) {
-                executor(job);
+        std::deque<size_t> ready;
+        auto executions = loadExecutions(ready);
+        size_t running = 0;
+        while(true) {
+            while(not ready.empty() && running < threadConcurrency) {
+                auto & execution = executions.at(ready.front());
+                ready.pop_front();
+                updateJobState(execution.job,JobState::RUNNING);
+                running++;
+                executor(execution.job);
             }
+            notifyListeners();
+            if(running == 0)
+                break;
+            std::deque<Job> finished;
             {
-                std::lock_guard lock {this->mutex};
-                std::ranges::for_each(this->listener,[this](auto && o){o(*this);});
+                std::unique_lock lock {this->mutex};
+                finishedCondition.wait(lock,[this]{return not this->finishedJobs.empty();});
+                finished.swap(this->finishedJobs);
+            }
+            for(const Job & job: finished) {
+                running--;
+                auto it = executions.find(job.id);
+                if(it == executions.end())
+                    continue;
+                auto & execution = it->second;
+                execution.job.updateStatus(job.state);
+                if(job.state == JobState::FAILED)
+                    this->log.failedJobs.push_back(job);
+                if(not isFinished(execution.job))
+                    continue;
+                for(size_t childId: execution.children) {
+                    auto & child = executions.at(childId);
+                    if(--child.unfinishedParents == 0 && isRunnable(child.job))
+                        ready.push_back(childId);
+                }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
-        std::ranges::for_each(this->listener,[this](auto && o){o(*this);});
     }
 
     void addListener(SchedulerObserver_t && schedulerObserver){
@@ -5,6 +5,7 @@
 #include "Job.hpp"
 #include "CwlToilExecutor.hpp"
 #include "CwlToolExecutor.hpp"
+#include "InProcessExecutor.hpp"
 #include "Scheduler.hpp"
 
 class SchedulerConfig:public MemgraphTaskConfig{
@@ -12,6 +13,7 @@ private:
     constexpr static const char * LAST_JOB_TYPE_KEY = "last-job-type";
     constexpr static const char * EXECUTOR_KEY = "executor";
     constexpr static const char * CONCURRENCY_KEY="hardware-concurrency";
+    constexpr static const char * SPLITTER_KEY = "splitter";
 public:
     JobType lastJobType;
     ExecutorType executorType;
@@ -41,6 +43,12 @@ public:
             concurrency = std::thread::hardware_concurrency();
     }
 
+    std::optional<MemgraphConnectionPool> connectionPool() const {
+        if(connections <= 1)
+            return std::nullopt;
+        return std::optional<MemgraphConnectionPool>(std::in_place,params,connections);
+    }
+
     Scheduler getSchedulerWithExecutorType (JobDAG_t && dag) {
         switch(executorType){
             case ExecutorType::CWLTOIL: {
@@ -48,14 +56,21 @@ public:
                 executorDesc.at("cwl-directory").get_to(cwlDirectory);
                 std::string flags;
                 executorDesc.at("flags").get_to(flags);
-                return Scheduler(std::move(dag),CwlToilExecutor(std::move(cwlDirectory),std::move(flags)),lastJobType,concurrency);
+                return Scheduler(std::move(dag),CwlToilExecutor(std::move(cwlDirectory),std::move(flags)),lastJobType,concurrency,connectionPool());
             }
             case ExecutorType::CWLTOOL:{
                 std::string cwlDir;
                 executorDesc.at("cwl-directory").get_to(cwlDir);
                 std::string flags;
                 executorDesc.at("flags").get_to(flags);
-                return Scheduler(std::move(dag),CwlToolExecutor(std::move(cwlDir),std::move(flags)),lastJobType,concurrency);
+                return Scheduler(std::move(dag),CwlToolExecutor(std::move(cwlDir),std::move(flags)),lastJobType,concurrency,connectionPool());
+            }
+            case ExecutorType::INPROCESS:{
+                std::string splitter = "FishnetShapefileSplitter";
+                if(executorDesc.contains(SPLITTER_KEY))
+                    executorDesc.at(SPLITTER_KEY).get_to(splitter);
+                size_t numThreads = concurrency == 0 ? std::thread::hardware_concurrency() : concurrency;
+                return Scheduler(std::move(dag),InProcessExecutor(numThreads,std::move(splitter)),lastJobType,concurrency,connectionPool());
             }
             default:
                 throw std::runtime_error("Could not create scheduler from executor type.\n"+this->jsonDescription.dump());
@@ -27,7 +27,7 @@ template<typename GeometryType>
 static std::optional<fishnet::util::BiPredicate_t<GeometryType>> fromBinaryType(BinaryFilterType type, json const & filterDesc){
     switch(type){
         case BinaryFilterType::InsidePolygonFilter:
-            return InsidePolygonFilter();
+            return InsidePolygonFilter<typename GeometryType::numeric_type>();
     }
     return std::nullopt;
 }
@@ -15,15 +15,19 @@ struct FindNeighboursConfig: public MemgraphTaskConfig{
     constexpr static const char * MAX_DISTANCE_KEY = "maxDistanceMeters";
     constexpr static const char * NEIGHBOURING_PREDICATES_KEY = "neighbouring-predicates";
     constexpr static const char * MAX_NEIGHBOURS_KEY ="maxNeighbours";
+    constexpr static const char * WORKERS_KEY = "neighbour-workers";
 
     double maxEdgeDistance;
     size_t maxNeighbours;
+    size_t workers = 1;
 
     FindNeighboursConfig()=default;
 
     FindNeighboursConfig(const json & configDescription):MemgraphTaskConfig(configDescription){
         jsonDescription.at(MAX_DISTANCE_KEY).get_to(this->maxEdgeDistance);
         jsonDescription.at(MAX_NEIGHBOURS_KEY).get_to(this->maxNeighbours);
+        if(jsonDescription.contains(WORKERS_KEY)) // optional, sequential neighbour search by default
+            jsonDescription.at(WORKERS_KEY).get_to(this->workers);
     }
 
     /**
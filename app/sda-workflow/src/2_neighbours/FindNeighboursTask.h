@@ -1,5 +1,9 @@
 #pragma once
 #include <vector>
+#include <optional>
+#include <cmath>
+#include <span>
+#include <ranges>
 #include <fishnet/Shapefile.hpp>
 #include <fishnet/ShapeGeometry.hpp>
 #include <fishnet/VectorIO.hpp>
@@ -50,6 +54,37 @@ private:
         }
     };
 
+    using BoundingBoxSettlement = fishnet::geometry::BoundingBoxPolygon<SettlementPolygon<P>>;
+
+    /**
+     * @brief Neighbouring predicate of the task: the bounding boxes have to overlap, the polygons have to be within the maximum edge distance and fulfill the configured predicates.
+     * The distances of all candidates of a polygon are decided at once, see DistanceBiPredicate::withinDistance().
+     */
+    struct NeighbouringPredicate{
+        DistanceBiPredicate<DistanceFunction> distance;
+        fishnet::util::AllOfPredicate<P,P> configured;
+
+        bool operator()(const BoundingBoxSettlement & lhs, const BoundingBoxSettlement & rhs) const noexcept {
+            return lhs.getBoundingBox().overlap(rhs.getBoundingBox()) && distance(lhs.getPolygon(),rhs.getPolygon()) && configured(lhs.getPolygon(),rhs.getPolygon());
+        }
+
+        std::vector<bool> batch(const BoundingBoxSettlement & current, std::span<const BoundingBoxSettlement * const> candidates) const {
+            std::vector<size_t> overlapping;
+            for(size_t i = 0; i < candidates.size(); ++i) {
+                if(current.getBoundingBox().overlap(candidates[i]->getBoundingBox()))
+                    overlapping.push_back(i);
+            }
+            auto within = distance.withinDistance(current.getPolygon(),overlapping | std::views::transform([&candidates](size_t i) -> const SettlementPolygon<P> & {
+                return candidates[i]->getPolygon();
+            }));
+            std::vector<bool> result(candidates.size(),false);
+            for(size_t j = 0; j < overlapping.size(); ++j) {
+                result[overlapping[j]] = within[j] && configured(current.getPolygon(),candidates[overlapping[j]]->getPolygon());
+            }
+            return result;
+        }
+    };
+
 public:
     FindNeighboursTask(FindNeighboursConfig && config,fishnet::Shapefile primaryInput, size_t workflowID):Task(workflowID),config(std::move(config)),primaryInput(std::move(primaryInput)){
         this->desc["type"]="NEIGHBOURS";
@@ -62,11 +97,37 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Expands the box by the maximum edge distance, converted from meters to units of the spatial reference with the distance function.
+     * The margins are doubled and the horizontal margin is measured on the parallel closest to a pole, such that the result contains
+     * at least all points within the maximum edge distance of the box.
+     * @param box bounding box of the primary input
+     * @return std::optional<Rectangle<number>> expanded box, empty if the margins can not be determined
+     */
+    std::optional<fishnet::geometry::Rectangle<number>> expandByMaxEdgeDistance(const fishnet::geometry::Rectangle<number> & box) const {
+        constexpr static double safetyFactor = 2;
+        constexpr static double minimumProbeLength = 1e-6;
+        auto marginAlong = [this](fishnet::geometry::Vec2DReal from, fishnet::geometry::Vec2DReal to){
+            return safetyFactor * config.maxEdgeDistance * from.distance(to) / distanceFunction(from,to);
+        };
+        double height = std::max<double>(box.top() - box.bottom(),minimumProbeLength);
+        double marginY = marginAlong({box.left(),box.bottom()},{box.left(),box.bottom()+height});
+        double top = box.top() + marginY;
+        double bottom = box.bottom() - marginY;
+        double polewardY = std::abs(top) > std::abs(bottom) ? top : bottom;
+        double width = std::max<double>(box.right() - box.left(),minimumProbeLength);
+        double marginX = marginAlong({box.left(),polewardY},{box.left()+width,polewardY});
+        if(not std::isfinite(marginX) || not std::isfinite(marginY))
+            return std::nullopt;
+        return fishnet::geometry::Rectangle<number>(box.left()-marginX,top,box.right()+marginX,bottom);
+    }
+
     std::vector<SettlementPolygon<P>> readInput(auto const & graph)  {
         std::vector<SettlementPolygon<P>> polygons;
-        auto layer = fishnet::VectorIO::read<P>(primaryInput); // load polygons from primary shapefile
-        distanceFunction = distanceFunctionForSpatialReference(layer.getSpatialReference());
-        if(layer.isEmpty()){
+        auto primaryStream = fishnet::VectorIO::stream<P>(primaryInput); // stream polygons from primary shapefile
+        distanceFunction = distanceFunctionForSpatialReference(primaryStream.getSpatialReference());
+        auto primaryFeature = primaryStream.begin();
+        if(primaryFeature == primaryStream.end()){
             return polygons;
         }
         PrimaryInputAABB inputBoundingBox;
@@ -74,44 +135,50 @@ public:
         if(not primaryFileRef){
             throw std::runtime_error("Could not create file reference for shp file:\n"+primaryInput.getPath().string());
         }
-        auto primaryOptFishnetIdField = layer.getSizeField(Task::FISHNET_ID_FIELD);
+        auto primaryOptFishnetIdField = primaryStream.getSchema().getSizeField(Task::FISHNET_ID_FIELD);
         if(not primaryOptFishnetIdField) {
             throw std::runtime_error("Could not find FISHNET_ID field in shp file: \n"+primaryInput.getPath().string());
         }
-        for(const auto & feature : layer.getFeatures()) {
+        for(; primaryFeature != primaryStream.end(); ++primaryFeature) {
+            const auto & feature = *primaryFeature;
             auto optId = feature.getAttribute(primaryOptFishnetIdField.value()); // read FISHNET_ID of feature
             if(not optId){
                 throw std::runtime_error("No id exists for feature with geometry:\n"+feature.getGeometry().toString());
             }
             inputBoundingBox.update(feature.getGeometry());
-            polygons.emplace_back(optId.value(),primaryFileRef.value(),std::move(feature.getGeometry())); // create settlement wrapper containing its unique id and geometry
+            polygons.emplace_back(optId.value(),primaryFileRef.value(),feature.getGeometry()); // create settlement wrapper containing its unique id and geometry
         }
         DistanceBiPredicate distanceToPrimaryInput {distanceFunction,config.maxEdgeDistance};
         fishnet::geometry::Rectangle<number> primaryInputAABB = inputBoundingBox.asShape();
+        auto spatialFilter = expandByMaxEdgeDistance(primaryInputAABB);
         std::vector<std::string> additionalInputStrings;
         std::ranges::for_each(additionalInput,[&additionalInputStrings](auto const & file){additionalInputStrings.push_back(file.getPath().filename().string());});
         this->desc["additional-inputs"]=additionalInputStrings;
         for(const auto & shp : additionalInput) {
-            auto neighbourLayer = fishnet::VectorIO::read<P>(shp); // load polygons from shapefile
-            if(not layer.getSpatialReference().IsSame(&neighbourLayer.getSpatialReference()))
-                throw std::runtime_error("Spatial reference of neighbouring file does not match!\nExpecting: "+std::string(layer.getSpatialReference().GetName())+"\nActual: "+neighbourLayer.getSpatialReference().GetName());
-            if(neighbourLayer.isEmpty())
+            auto neighbourStream = fishnet::VectorIO::stream<P>(shp); // stream polygons from shapefile
+            if(not primaryStream.getSpatialReference().IsSame(&neighbourStream.getSpatialReference()))
+                throw std::runtime_error("Spatial reference of neighbouring file does not match!\nExpecting: "+std::string(primaryStream.getSpatialReference().GetName())+"\nActual: "+neighbourStream.getSpatialReference().GetName());
+            if(spatialFilter)
+                neighbourStream.setSpatialFilter(spatialFilter.value()); // features out of range of the primary input are skipped by OGR
+            auto neighbourFeature = neighbourStream.begin();
+            if(neighbourFeature == neighbourStream.end())
                 continue;
             auto fileRef = graph.getAdjacencyContainer().getDatabaseConnection().addFileReference(shp.getPath()); // load file reference from database
             if(not fileRef){
                 throw std::runtime_error("Could not create file reference for shp file:\n"+shp.getPath().string());
             }
-            auto optFishnetIdField = neighbourLayer.getSizeField(Task::FISHNET_ID_FIELD);
+            auto optFishnetIdField = neighbourStream.getSchema().getSizeField(Task::FISHNET_ID_FIELD);
             if(not optFishnetIdField) {
                 throw std::runtime_error("Could not find FISHNET_ID field in shp file: \n"+shp.getPath().string());
             }
-            for(const auto & feature : neighbourLayer.getFeatures()) {
+            for(; neighbourFeature != neighbourStream.end(); ++neighbourFeature) {
+                const auto & feature = *neighbourFeature;
                 auto optId = feature.getAttribute(optFishnetIdField.value()); // read FISHNET_ID of feature
                 if(not optId){
                     throw std::runtime_error("No id exists for feature with geometry:\n"+feature.getGeometry().toString());
                 }
                 if(distanceToPrimaryInput(primaryInputAABB,feature.getGeometry())) // consider only polygons in range of the primary input
-                    polygons.emplace_back(optId.value(),fileRef.value(),std::move(feature.getGeometry())); // create settlement wrapper containing its unique id and geometry
+                    polygons.emplace_back(optId.value(),fileRef.value(),feature.getGeometry()); // create settlement wrapper containing its unique id and geometry
             }
         }
         return polygons;
@@ -130,14 +197,10 @@ public:
             double scale = (maxEdgeDistanceVar / distanceMetersTopLeftBotLeft) +1;
             return fishnet::geometry::BoundingBoxPolygon(settPolygon,aaBB.scale(scale));
         };
-        fishnet::util::AllOfPredicate<P,P> neighbouringPredicate;
-        /* add all neighbouring predicates to composite predicate */
-        neighbouringPredicate.add(DistanceBiPredicate(distanceFunction,config.maxEdgeDistance));
-        std::ranges::for_each(config.initNeighbouringPredicates<P>(),[&neighbouringPredicate](const auto & predicate){neighbouringPredicate.add(predicate);});
-        auto shortCircuitPredicate = [neighbouringPredicate= std::move(neighbouringPredicate)](const fishnet::geometry::BoundingBoxPolygon<SettlementPolygon<P>> & lhs, const fishnet::geometry::BoundingBoxPolygon<SettlementPolygon<P>> & rhs){
-            return lhs.getBoundingBox().overlap(rhs.getBoundingBox()) && neighbouringPredicate(lhs.getPolygon(),rhs.getPolygon());
-        };
-        auto result = fishnet::geometry::findNeighbouringPolygonsTemplate(polygons,shortCircuitPredicate,boundingBoxPolygonWrapper,config.maxNeighbours);    
+        NeighbouringPredicate neighbouringPredicate {DistanceBiPredicate(distanceFunction,config.maxEdgeDistance),{}};
+        /* add all configured neighbouring predicates to composite predicate */
+        std::ranges::for_each(config.initNeighbouringPredicates<P>(),[&neighbouringPredicate](const auto & predicate){neighbouringPredicate.configured.add(predicate);});
+        auto result = fishnet::geometry::findNeighbouringPolygonsTemplate(polygons,neighbouringPredicate,boundingBoxPolygonWrapper,config.maxNeighbours,config.workers);    
         this->desc["Adjacencies"]=result.size();
         graph.addNodes(polygons);
         graph.addEdges(result);
@@ -1,5 +1,7 @@
+#pragma once
 #include <fishnet/GraphFactory.hpp>
 #include <fishnet/BFSAlgorithm.hpp>
+#include <fishnet/UnionFind.hpp>
 #include <fishnet/PathHelper.h>
 #include <fishnet/MemgraphClient.hpp>
 #include <fishnet/Task.hpp>
@@ -75,14 +77,13 @@ public:
         MemgraphClient memgraphClient = MemgraphClient(MemgraphConnection::create(config.params,workflowID).value_or_throw());
         auto nodesList = memgraphClient.nodes();
         auto adjMap = memgraphClient.edges();
-        auto graph = fishnet::graph::GraphFactory::UndirectedGraph<size_t>();
-        graph.addNodes(nodesList);
+        std::vector<std::pair<NodeIdType,NodeIdType>> edges;
         for(auto && [node,neigbours]:adjMap){ 
             for(auto neighbour: neigbours){ // use by value since datatype is very cheap to copy
-                graph.addEdge(node,neighbour); //
+                edges.emplace_back(node,neighbour);
             }
         }
-        auto components = fishnet::graph::BFS::connectedComponents(graph).get();
+        auto components = fishnet::graph::UnionFind::connectedComponents<NodeIdType>(nodesList,edges,config.workers); // concurrent union-find, using the configured number of workers
         this->desc["Connected Components"]=components.size();
         std::vector<ComponentReference> componentIds;
         for (const auto & nodesOfComponent : components) {
@@ -1,4 +1,6 @@
 #pragma once
+#include <optional>
+#include <unordered_set>
 #include <fishnet/ShapeGeometry.hpp>
 #include <fishnet/Shapefile.hpp>
 #include <fishnet/VectorIO.hpp>
@@ -7,7 +9,7 @@
 #include <fishnet/CompositePredicate.hpp>
 
 #include <fishnet/CachingMemgraphAdjacency.hpp>
-#include <fishnet/MemgraphAdjacency.hpp>
+#include <fishnet/MemgraphClient.hpp>
 #include <fishnet/Task.hpp>
 #include "SettlementPolygon.hpp"
 #include "ContractionConfig.hpp"
@@ -16,7 +18,9 @@
 /**
  * @brief Implementation of the contraction task. 
  * The graph of all settlements stored in the input files (and part of specified connected components) are first loaded from the database.
- * Edges between settlements fulfilling the composite contraction predicate are contracted, and the adjacent settlements merged into a single entity (e.g. a Multi-Polygon containing all settlements)
+ * The input files are streamed and only the settlements of the specified components are kept, i.e. the source graph is bounded by the components assigned to this job.
+ * Edges between settlements fulfilling the composite contraction predicate are contracted, and the adjacent settlements merged into a single entity (e.g. a Multi-Polygon containing all settlements).
+ * The merged settlements are streamed to the output file component by component, the contracted graph is never materialized.
  * @tparam P polygon type of the settlements
  */
 template<fishnet::geometry::IPolygon P>
@@ -55,6 +59,7 @@ public:
 
     /**
      * @brief Helper function to read the settlements from the shape files and load their relationships from the memgraph database.
+     * The inputs are streamed, settlements which are not part of the components of this job are skipped.
      * Additionally sets the out parameter spatialRef, to the spatial reference system used in the inputs 
      * @param adj IN_OUT memgraph adjacency instance, loads the settlement relationships
      * @param spatialRef IN_OUT spatial reference used for the ouput shapefile, set according to input spatial reference
@@ -66,27 +71,31 @@ public:
         std::vector<std::string> inputStrings;
         std::ranges::for_each(this->inputs,[&inputStrings](auto const & file){inputStrings.push_back(file.getPath().filename().string());});
         this->desc["inputs"]=inputStrings;
+        auto nodeIds = components.empty() ? adj.getDatabaseConnection().nodes() : adj.getDatabaseConnection().nodesOfComponents(components);
+        const std::unordered_set<NodeIdType> nodeIdSet {nodeIds.begin(),nodeIds.end()};
         for(const auto & shp : inputs) {
-            auto layer = fishnet::VectorIO::read<P>(shp);
+            auto stream = fishnet::VectorIO::stream<P>(shp);
             if(spatialRef.IsEmpty())
-                spatialRef = layer.getSpatialReference();
-            if(not spatialRef.IsSame(&layer.getSpatialReference()))
-                throw std::runtime_error("Spatial reference of files do not match!\nExpecting: "+std::string(spatialRef.GetName())+"\nActual: "+layer.getSpatialReference().GetName());
-            if(layer.isEmpty())
-                continue;
-            auto fileRef = adj.getDatabaseConnection().addFileReference(shp.getPath());
-            if(not fileRef){
-                throw std::runtime_error("Could not read file reference for shp file:\n"+shp.getPath().string());
-            }
-            auto optFishnetIdField = layer.getSizeField(Task::FISHNET_ID_FIELD);
+                spatialRef = stream.getSpatialReference();
+            if(not spatialRef.IsSame(&stream.getSpatialReference()))
+                throw std::runtime_error("Spatial reference of files do not match!\nExpecting: "+std::string(spatialRef.GetName())+"\nActual: "+stream.getSpatialReference().GetName());
+            auto optFishnetIdField = stream.getSchema().getSizeField(Task::FISHNET_ID_FIELD);
             if(not optFishnetIdField) {
                 throw std::runtime_error("Could not find FISHNET_ID field in shp file: \n"+shp.getPath().string());
             }
-            for(const auto & feature : layer.getFeatures()) {
+            std::optional<FileReference> fileRef; // only referenced once a settlement of this job is found in the file
+            for(auto & feature : stream) {
                 auto optId = feature.getAttribute(optFishnetIdField.value());
                 if(not optId){
                     throw std::runtime_error("No id exists for feature with geometry:\n"+ feature.getGeometry().toString());
                 }
+                if(not nodeIdSet.contains(optId.value()))
+                    continue;
+                if(not fileRef) {
+                    fileRef = adj.getDatabaseConnection().addFileReference(shp.getPath());
+                    if(not fileRef)
+                        throw std::runtime_error("Could not read file reference for shp file:\n"+shp.getPath().string());
+                }
                 polygons.emplace_back(optId.value(),fileRef.value(),std::move(feature.getGeometry()));
             }   
         }
@@ -96,21 +105,40 @@ public:
         return polygons;
     }
 
+    /**
+     * @brief Helper function to store the contracted edges in the database.
+     * The result graph is undirected, therefore each edge is stored in both directions, such that the adjacency can be queried from either settlement
+     * @param client database client
+     * @param resultNodes references to the merged settlements, index: component-id
+     * @param resultEdges contracted edges as pairs of component-ids, each edge once
+     * @return true if the edges could be inserted
+     */
+    static bool insertResultEdges(const MemgraphClient & client, const std::vector<NodeReference> & resultNodes, const std::vector<std::pair<int,int>> & resultEdges) {
+        if(resultEdges.empty())
+            return true;
+        std::vector<std::pair<NodeReference,NodeReference>> edgeReferences;
+        edgeReferences.reserve(2*resultEdges.size());
+        for(const auto & [from,to]: resultEdges) {
+            edgeReferences.emplace_back(resultNodes.at(size_t(from)),resultNodes.at(size_t(to)));
+            edgeReferences.emplace_back(resultNodes.at(size_t(to)),resultNodes.at(size_t(from)));
+        }
+        return client.insertEdges(edgeReferences);
+    }
+
     void run() override {
         if(inputs.empty()){
             throw std::runtime_error( "No input file provided");
         }
         MemgraphConnection memgraphConnection = MemgraphConnection::create(config.params,workflowID).value_or_throw();
         auto memgraphAdjSrc = CachingMemgraphAdjacency<SourceNodeType>(MemgraphClient(MemgraphConnection(memgraphConnection)));
-        auto memgraphAdjRes = MemgraphAdjacency<ResultNodeType>(MemgraphClient(MemgraphConnection(memgraphConnection)));
+        auto resultClient = MemgraphClient(MemgraphConnection(memgraphConnection));
         OGRSpatialReference ref; // set by readInputs function, used as spatial reference for output layer
-        auto settlements = readInputs(memgraphAdjSrc,ref);
+        readInputs(memgraphAdjSrc,ref); // settlements are held by the adjacency, the returned copy is dropped immediately
         auto outputFileRef = memgraphAdjSrc.getDatabaseConnection().addFileReference(output.getPath());
         if(not outputFileRef)
             throw std::runtime_error( "Could not create file reference for output in Database: "+output.getPath().string());
         auto sourceGraph = fishnet::graph::GraphFactory::UndirectedGraph<SourceNodeType>(std::move(memgraphAdjSrc));
         this->desc["#Nodes-before-contraction"]=fishnet::util::size(sourceGraph.getNodes());
-        auto resultGraph = fishnet::graph::GraphFactory::UndirectedGraph<ResultNodeType>(std::move(memgraphAdjRes));
         /*Reduce function used to merge a connected component of nodes (SourceNodeType), solely connected via to-be-contracted edges, into a single node of the ResultNodeType*/
         auto reduceFunction = IDReduceFunction(outputFileRef.value());
         auto contractionPredicate = fishnet::util::AllOfPredicate<SourceNodeType,SourceNodeType>();
@@ -118,19 +146,34 @@ public:
         std::ranges::for_each(config.initContractionPredicates<P>(distanceFunctionForSpatialReference(ref)),[&contractionPredicate](auto && p){contractionPredicate.add(
             [predicate=std::move(p)](const SourceNodeType & lhs, const SourceNodeType & rhs){return predicate(static_cast<P>(lhs),static_cast<P>(rhs));});
         });
-        /* Contract the graph according to the composite contraction predicate. Old adjacencies are removed from the database as well to allow the reuse of ids, while remaining consistency. */
-        fishnet::graph::contractInPlace(sourceGraph,contractionPredicate,reduceFunction,resultGraph,config.workers);
-        auto outputLayer = fishnet::VectorIO::empty<ResultGeometryType>(ref);
-        auto idFieldExp = outputLayer.addSizeField(Task::FISHNET_ID_FIELD); // add id field to output as well
+        auto outputSchema = fishnet::VectorIO::empty<ResultGeometryType>(ref);
+        auto idFieldExp = outputSchema.addSizeField(Task::FISHNET_ID_FIELD); // add id field to output as well
         if(not idFieldExp)
             throw std::runtime_error(idFieldExp.error());
         const auto & idField = idFieldExp.value();
-        for(const auto & node: resultGraph.getNodes()){
-            fishnet::Feature f {static_cast<ResultGeometryType>(node)};
-            f.addAttribute(idField,node.key());
-            outputLayer.addFeature(std::move(f));
-        }
-        this->desc["#Nodes-after-contraction"]=outputLayer.size();
-        fishnet::VectorIO::overwrite(outputLayer, output); 
+        auto writer = fishnet::VectorIO::openWriter(outputSchema,output);
+        std::vector<NodeReference> resultNodes; // index: component-id of the merged settlement
+        std::vector<std::pair<int,int>> resultEdges; // pairs of component-ids
+        /* Contract the graph according to the composite contraction predicate. 
+        Components are merged independently and written to the output as soon as they are merged, only references to the merged settlements are kept for the database. */
+        int components = fishnet::graph::contractStreaming(sourceGraph,contractionPredicate,reduceFunction,
+            [&writer,&idField,&resultNodes](int componentId, ResultNodeType && node){
+                if(resultNodes.size() <= size_t(componentId))
+                    resultNodes.resize(componentId+1);
+                resultNodes[componentId] = NodeReference{node.key(),node.file()};
+                fishnet::Feature<ResultGeometryType> f {static_cast<ResultGeometryType &&>(std::move(node))};
+                f.addAttribute(idField,resultNodes[componentId].nodeId);
+                writer.write(f);
+            },
+            [&resultEdges](int from, int to){resultEdges.emplace_back(from,to);},
+            config.workers);
+        writer.close();
+        /* Old adjacencies are removed from the database to allow the reuse of ids, while remaining consistency. */
+        sourceGraph.clear();
+        if(not resultNodes.empty() && not resultClient.insertNodes(resultNodes))
+            throw std::runtime_error("Could not insert contracted settlements into the database");
+        if(not insertResultEdges(resultClient,resultNodes,resultEdges))
+            throw std::runtime_error("Could not insert edges between contracted settlements into the database");
+        this->desc["#Nodes-after-contraction"]=components;
     }
 };
\ No newline at end of file
@@ -14,7 +14,7 @@
 /**
  * @brief Implementation of the analysis task.
  * The settlement shapes with their id are loaded from the input file (as Polygons or MultiPolygons, depending on the contraction step).
- * Their relationships are loaded from the memgraph database.
+ * Their relationships are loaded from the memgraph database and copied into an immutable CSR graph.
  * The selected centrality measures are applied to the settlement graph and the computed values stored as fields in the output file.
  * If desired the edges between the settlements get visualized in separate file.
  * @tparam ShapeType 
@@ -94,7 +94,8 @@ public:
             return;
         }
         memgraphAdj.loadNodes(settlements); //load settlement relationships
-        auto graph = fishnet::graph::GraphFactory::UndirectedGraph<NodeType>(std::move(memgraphAdj));
+        /*The measures only read the graph: copy it into an immutable CSR graph with contiguous neighbourhoods and release the database adjacency*/
+        auto graph = fishnet::graph::GraphFactory::CSRGraph(fishnet::graph::GraphFactory::UndirectedGraph<NodeType>(std::move(memgraphAdj)));
         std::future<void> edgesTask;
         if(config.visualizeEdges) { 
             edgesTask = std::async(std::launch::async,[this,&graph,&outputRef]{
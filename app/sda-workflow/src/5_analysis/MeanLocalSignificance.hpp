@@ -33,11 +33,17 @@ struct MeanLocalSignificance{
         const auto & nodes = source.getNodes();
         auto threadPoolSize = std::min(static_cast<size_t>(std::thread::hardware_concurrency()/2),static_cast<size_t>(fishnet::util::size(nodes)/NODES_PER_THREAD + 1));
         if(threadPoolSize > 1){
-            fishnet::util::ThreadPool pool {threadPoolSize};
+            std::vector<const std::remove_cvref_t<std::ranges::range_reference_t<decltype(nodes)>> *> nodePointers;
             for(const auto & node: nodes){
-                pool.submit([&computeMeanLocalSig,&node]{computeMeanLocalSig(node);});
+                nodePointers.push_back(&node);
+            }
+            auto computeNode = [&computeMeanLocalSig,&nodePointers](size_t i){computeMeanLocalSig(*nodePointers[i]);};
+            if(auto * currentPool = fishnet::util::ThreadPool::current()){ // task runs on the pool of the in-process executor
+                currentPool->parallelFor(0,nodePointers.size(),computeNode,NODES_PER_THREAD);
+            }else{
+                fishnet::util::ThreadPool pool {threadPoolSize};
+                pool.parallelFor(0,nodePointers.size(),computeNode,NODES_PER_THREAD);
             }
-            pool.join();
         }else{
             std::ranges::for_each(nodes,computeMeanLocalSig);
         }
@@ -1,3 +1,4 @@
+#pragma once
 #include <future>
 #include <fishnet/GDALInitializer.hpp>
 #include <fishnet/VectorIO.hpp>
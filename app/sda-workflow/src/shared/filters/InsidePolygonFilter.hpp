@@ -1,19 +1,71 @@
 #pragma once
 #include <fishnet/ShapeGeometry.hpp>
 #include <fishnet/ContainedOrInHoleFilter.hpp>
+#include <fishnet/PreparedRing.hpp>
 #include "Filter.hpp"
 #include <nlohmann/json.hpp>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm>
 
 /**
  * @brief Binary Filter, testing if the other polygons contain another or are inside a hole
- * 
+ * The boundaries of large enclosing polygons are prepared once and reused for every polygon tested against them.
+ * Prepared boundaries are identified by the address of the enclosing polygon, which is stable while the polygon filter sweeps over the polygons,
+ * the hash of the boundary guards against reused addresses.
+ * Copies of the filter share the prepared boundaries.
+ * @tparam T numeric type of the polygons
  */
+template<fishnet::math::Number T = fishnet::math::DEFAULT_NUMERIC>
 class InsidePolygonFilter{
 private:
-    static inline fishnet::geometry::ContainedOrInHoleFilter filter{};
+    constexpr static size_t PREPARED_BOUNDARY_THRESHOLD = 64; // minimum number of segments of a boundary to be prepared
+    constexpr static size_t MAX_PREPARED_BOUNDARIES = 1024;
+
+    struct PreparedBoundary{
+        size_t hash;
+        std::shared_ptr<const fishnet::geometry::PreparedRing<T>> ring;
+    };
+
+    struct PreparedBoundaries{
+        std::mutex mutex;
+        std::unordered_map<const void *,PreparedBoundary> boundaries;
+    };
+
+    std::shared_ptr<PreparedBoundaries> prepared = std::make_shared<PreparedBoundaries>();
+
+    std::shared_ptr<const fishnet::geometry::PreparedRing<T>> preparedBoundary(fishnet::geometry::IPolygon auto const & polygon) const {
+        const auto & boundary = polygon.getBoundary();
+        const size_t hash = boundary.hashValue();
+        std::lock_guard lock {prepared->mutex};
+        auto & boundaries = prepared->boundaries;
+        if(auto it = boundaries.find(std::addressof(polygon)); it != boundaries.end() && it->second.hash == hash)
+            return it->second.ring;
+        if(boundaries.size() >= MAX_PREPARED_BOUNDARIES)
+            boundaries.clear();
+        auto ring = std::make_shared<const fishnet::geometry::PreparedRing<T>>(boundary);
+        boundaries.insert_or_assign(std::addressof(polygon),PreparedBoundary{hash,ring});
+        return ring;
+    }
 public:
-    static inline bool operator()(fishnet::geometry::IPolygon auto const & lhs, fishnet::geometry::IPolygon auto const & rhs ) noexcept {
-        return filter(lhs,rhs);
+    /**
+     * @brief Equal to ContainedOrInHoleFilter, the boundary of a large polygon lhs is tested through its prepared ring
+     *
+     * @param lhs potentially enclosing polygon
+     * @param rhs polygon under test
+     * @return false if rhs is equal to lhs, contained in lhs or inside a hole of lhs
+     */
+    bool operator()(fishnet::geometry::IPolygon auto const & lhs, fishnet::geometry::IPolygon auto const & rhs ) const {
+        if(lhs.getBoundary().getSegments().size() < PREPARED_BOUNDARY_THRESHOLD)
+            return fishnet::geometry::ContainedOrInHoleFilter()(lhs,rhs);
+        if(lhs == rhs or lhs.isInHole(rhs))
+            return false;
+        const auto & otherBoundary = rhs.getBoundary();
+        bool contained = preparedBoundary(lhs)->contains(otherBoundary) && std::ranges::none_of(lhs.getHoles(),[&otherBoundary](const auto & hole){
+            return hole.crosses(otherBoundary) || otherBoundary.contains(hole);
+        });
+        return not contained;
     }
 
     static BinaryFilterType type() noexcept {
@@ -23,5 +75,5 @@ public:
     static std::optional<InsidePolygonFilter> fromJson(const nlohmann::json & json) {
         return InsidePolygonFilter();
     }
-    
-};
\ No newline at end of file
+
+};
@@ -4,7 +4,8 @@
 #include "Filter.hpp"
 
 /**
- * @brief Filters polygons depending on their area in m² using projection to calculated the area in metric units
+ * @brief Filters polygons depending on their area in m² using projection to calculated the area in metric units.
+ * The transformations to the projection are cached per thread (see WGS84Ellipsoid::area()).
  * @deprecated
  */
 class ProjectedAreaFilter {
@@ -46,7 +46,7 @@ private:
         MERGE,MATCH
     };
 
-    CipherQuery queryJob(const Job & job, QueryType queryType,std::string_view varName = "j") const noexcept {
+    static CipherQuery queryJob(const Job & job, QueryType queryType,std::string_view varName = "j") noexcept {
         switch(queryType){
             case QueryType::MERGE:
             {
@@ -132,8 +132,18 @@ public:
         });
     }
 
+    /**
+     * @brief Query persisting the state of the job, which can be executed on any connection (e.g. leased from a MemgraphConnectionPool)
+     * 
+     * @param job 
+     * @return CipherQuery 
+     */
+    static CipherQuery updateJobStateQuery(const Job & job) noexcept {
+        return queryJob(job,QueryType::MATCH,"j").append("SET j.state=$state").set("state",mg::Value(magic_enum::enum_name(job.state)));
+    }
+
     bool updateJobState(const Job & job) const noexcept {
-        return dbConnection.executeAndDiscard(queryJob(job,QueryType::MATCH,"j").append("SET j.state=$state").set("state",mg::Value(magic_enum::enum_name(job.state))));
+        return dbConnection.executeAndDiscard(updateJobStateQuery(job));
     }
 
     bool removeNode(const Job & job) const noexcept{
@@ -2,6 +2,10 @@
 #include <fishnet/ShapeGeometry.hpp>
 #include <fishnet/WGS84Ellipsoid.hpp>
 #include "NeighbourPredicateType.hpp"
+#include <vector>
+#include <numeric>
+#include <tuple>
+#include <algorithm>
 
 /**
  * @brief Distance BiPredicate Functor.
@@ -15,9 +19,53 @@ struct DistanceBiPredicate{
 
     bool operator()(fishnet::geometry::Shape auto const & lhs, fishnet::geometry::Shape auto const & rhs) const noexcept {
         auto [l,r] = fishnet::geometry::closestPoints(lhs,rhs);
-        return l == r || distanceFunction(l,r) <= maxDistanceInMeters;
+        if constexpr(requires {distanceFunction.withinDistance(l,r,maxDistanceInMeters);})
+            return distanceFunction.withinDistance(l,r,maxDistanceInMeters);
+        else
+            return l == r || distanceFunction(l,r) <= maxDistanceInMeters;
     }      
 
+    /**
+     * @brief Tests many candidates against the same shape.
+     * The closest point pairs are grouped by their point on lhs, such that each group is decided by a single one-to-many query of the distance function, if available.
+     * @param lhs shape
+     * @param candidates range of shapes
+     * @return std::vector<bool> true at the index of each candidate within the maximum distance of lhs
+     */
+    std::vector<bool> withinDistance(fishnet::geometry::Shape auto const & lhs, std::ranges::forward_range auto const & candidates) const {
+        std::vector<std::pair<fishnet::geometry::Vec2DReal,fishnet::geometry::Vec2DReal>> closest;
+        for(const auto & rhs: candidates) {
+            closest.push_back(fishnet::geometry::closestPoints(lhs,rhs));
+        }
+        std::vector<size_t> order(closest.size());
+        std::iota(order.begin(),order.end(),0);
+        std::ranges::sort(order,[&closest](size_t i, size_t j){
+            return std::tie(closest[i].first.x,closest[i].first.y) < std::tie(closest[j].first.x,closest[j].first.y);
+        });
+        std::vector<bool> result(closest.size(),false);
+        std::vector<fishnet::geometry::Vec2DReal> points;
+        for(size_t begin = 0, end = 0; begin < order.size(); begin = end) {
+            const auto & l = closest[order[begin]].first;
+            points.clear();
+            for(end = begin; end < order.size() && closest[order[end]].first.x == l.x && closest[order[end]].first.y == l.y; ++end) {
+                points.push_back(closest[order[end]].second);
+            }
+            if constexpr(requires {{distanceFunction.withinDistance(l,points,maxDistanceInMeters)} -> std::same_as<std::vector<bool>>;}) {
+                auto within = distanceFunction.withinDistance(l,points,maxDistanceInMeters);
+                for(size_t i = begin; i < end; ++i) {
+                    result[order[i]] = within[i-begin];
+                }
+            }
+            else {
+                for(size_t i = begin; i < end; ++i) {
+                    const auto & r = closest[order[i]].second;
+                    result[order[i]] = l == r || distanceFunction(l,r) <= maxDistanceInMeters;
+                }
+            }
+        }
+        return result;
+    }
+
     static NeighbouringPredicateType type() {
         return NeighbouringPredicateType::DistanceBiPredicate;
     }
@@ -27,6 +75,20 @@ struct WGS84Distance{
     static auto operator()(const fishnet::geometry::Vec2DReal & lhs, const fishnet::geometry::Vec2DReal & rhs) noexcept {
         return fishnet::WGS84Ellipsoid::distance(lhs,rhs);
     }
+
+    /**
+     * @brief Short-range test, decided by the local tangent plane approximation whenever its error bound allows
+     */
+    static bool withinDistance(const fishnet::geometry::Vec2DReal & lhs, const fishnet::geometry::Vec2DReal & rhs, double maxDistanceInMeters) noexcept {
+        return fishnet::WGS84Ellipsoid::withinDistance(lhs,rhs,maxDistanceInMeters);
+    }
+
+    /**
+     * @brief One-to-many short-range test, points not decided by the local tangent plane approximation are decided by the batched exact distances
+     */
+    static std::vector<bool> withinDistance(const fishnet::geometry::Vec2DReal & lhs, const std::vector<fishnet::geometry::Vec2DReal> & points, double maxDistanceInMeters) {
+        return fishnet::WGS84Ellipsoid::withinDistance(lhs,points,maxDistanceInMeters);
+    }
 };
 
 struct MetricDistance{
@@ -35,7 +97,41 @@ struct MetricDistance{
     }
 };
 
-using DistanceFunction = std::function<fishnet::math::DEFAULT_FLOATING_POINT(const fishnet::geometry::Vec2DReal &, const fishnet::geometry::Vec2DReal &)>;
+/**
+ * @brief Distance function in meters for a coordinate system, either WGS84Distance or MetricDistance.
+ * Dispatches to the concrete function without type erasure, such that DistanceBiPredicate uses WGS84Distance::withinDistance() for geographic coordinates.
+ */
+class DistanceFunction {
+private:
+    bool geographic;
+public:
+    DistanceFunction(MetricDistance = {}) noexcept:geographic(false){}
+
+    DistanceFunction(WGS84Distance) noexcept:geographic(true){}
+
+    fishnet::math::DEFAULT_FLOATING_POINT operator()(const fishnet::geometry::Vec2DReal & lhs, const fishnet::geometry::Vec2DReal & rhs) const noexcept {
+        if(geographic)
+            return WGS84Distance()(lhs,rhs);
+        return MetricDistance()(lhs,rhs);
+    }
+
+    bool withinDistance(const fishnet::geometry::Vec2DReal & lhs, const fishnet::geometry::Vec2DReal & rhs, double maxDistanceInMeters) const noexcept {
+        if(geographic)
+            return WGS84Distance::withinDistance(lhs,rhs,maxDistanceInMeters);
+        return lhs == rhs || MetricDistance()(lhs,rhs) <= maxDistanceInMeters;
+    }
+
+    std::vector<bool> withinDistance(const fishnet::geometry::Vec2DReal & lhs, const std::vector<fishnet::geometry::Vec2DReal> & points, double maxDistanceInMeters) const {
+        if(geographic)
+            return WGS84Distance::withinDistance(lhs,points,maxDistanceInMeters);
+        std::vector<bool> result;
+        result.reserve(points.size());
+        for(const auto & rhs: points) {
+            result.push_back(lhs == rhs || MetricDistance()(lhs,rhs) <= maxDistanceInMeters);
+        }
+        return result;
+    }
+};
 
 static DistanceFunction distanceFunctionForSpatialReference(const OGRSpatialReference & spatialRef) {
     if(spatialRef.IsEmpty())
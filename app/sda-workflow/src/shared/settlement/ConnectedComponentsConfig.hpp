@@ -5,12 +5,16 @@ class ConnectedComponentsConfig : public MemgraphTaskConfig {
 public:
     constexpr static const char * CONTRACTION_STEM_KEY = "contraction-output-stem";
     constexpr static const char * ANALYSIS_STEM_KEY = "analysis-output-stem";
+    constexpr static const char * WORKERS_KEY = "component-workers";
 
     std::string contractionOutputStem;
     std::string analysisOutputStem;
+    size_t workers = 1;
 
     ConnectedComponentsConfig(const json & configDescription):MemgraphTaskConfig(configDescription){
         this->jsonDescription.at(CONTRACTION_STEM_KEY).get_to(contractionOutputStem);
         this->jsonDescription.at(ANALYSIS_STEM_KEY).get_to(analysisOutputStem);
+        if(this->jsonDescription.contains(WORKERS_KEY)) // optional, sequential union-find by default
+            this->jsonDescription.at(WORKERS_KEY).get_to(this->workers);
     }
 };
\ No newline at end of file
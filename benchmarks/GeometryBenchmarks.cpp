@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <fishnet/Ring.hpp>
+#include <fishnet/PolygonNeighbours.hpp>
+#include <fishnet/PolygonFilter.hpp>
+#include <fishnet/PolygonDistance.hpp>
+#include "SyntheticData.hpp"
+
+using namespace fishnet;
+using namespace fishnet::geometry;
+using namespace fishnet::benchmarks;
+
+static void RingConstruction(benchmark::State & state) {
+    auto points = starShapedPoints(size_t(state.range(0)));
+    for(auto _ : state) {
+        Ring<double> ring {points};
+        benchmark::DoNotOptimize(ring);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(RingConstruction)->RangeMultiplier(4)->Range(16,16384)->Complexity();
+
+static void PolygonNeighbours(benchmark::State & state) {
+    auto polygons = polygonGrid(size_t(state.range(0)));
+    auto workers = size_t(state.range(1));
+    for(auto _ : state) {
+        auto neighbours = findNeighbouringPolygons(polygons,1.1,8,workers);
+        benchmark::DoNotOptimize(neighbours);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(PolygonNeighbours)->ArgsProduct({{256,1024,4096},{1,4}})->ArgNames({"polygons","workers"})->UseRealTime();
+
+static void PolygonFilter(benchmark::State & state) {
+    auto polygons = polygonGrid(size_t(state.range(0)));
+    auto notContained = [](const Polygon<double> & other, const Polygon<double> & polygon){return not other.contains(polygon);};
+    auto minimumArea = [](const Polygon<double> & polygon){return polygon.area() >= 50;};
+    for(auto _ : state) {
+        auto filtered = filter(polygons,notContained,minimumArea);
+        benchmark::DoNotOptimize(filtered);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(PolygonFilter)->RangeMultiplier(4)->Range(256,16384);
+
+static void ClosestPoints(benchmark::State & state) {
+    std::mt19937 generator {SEED};
+    auto vertices = size_t(state.range(0));
+    Polygon<double> lhs {Ring<double>(starShapedPoints(vertices,Point(0,0),100,generator))};
+    Polygon<double> rhs {Ring<double>(starShapedPoints(vertices,Point(250,50),100,generator))};
+    for(auto _ : state) {
+        auto points = closestPoints(lhs,rhs);
+        benchmark::DoNotOptimize(points);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(ClosestPoints)->RangeMultiplier(4)->Range(16,4096)->Complexity();
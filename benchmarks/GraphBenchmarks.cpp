@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+#include <fishnet/BFSAlgorithm.hpp>
+#include <fishnet/UnionFind.hpp>
+#include <fishnet/Contraction.hpp>
+#include "SyntheticData.hpp"
+
+using namespace fishnet;
+using namespace fishnet::graph;
+using namespace fishnet::benchmarks;
+
+static void BFSConnectedComponents(benchmark::State & state) {
+    auto graph = randomGeometricGraph(size_t(state.range(0)));
+    for(auto _ : state) {
+        auto components = BFS::connectedComponents(graph);
+        benchmark::DoNotOptimize(components);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BFSConnectedComponents)->RangeMultiplier(4)->Range(1024,65536);
+
+static void UnionFindConnectedComponents(benchmark::State & state) {
+    auto graph = randomGeometricGraph(size_t(state.range(0)));
+    auto workers = size_t(state.range(1));
+    for(auto _ : state) {
+        auto components = UnionFind::connectedComponents(graph,workers);
+        benchmark::DoNotOptimize(components);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(UnionFindConnectedComponents)->ArgsProduct({{1024,16384,65536},{1,4}})->ArgNames({"nodes","workers"})->UseRealTime();
+
+static void Contraction(benchmark::State & state) {
+    auto graph = randomGeometricGraph(size_t(state.range(0)));
+    auto workers = u_int8_t(state.range(1));
+    auto closeNodes = [](const Point & lhs, const Point & rhs){return lhs.distance(rhs) <= 0.5;};
+    auto midpoint = [](const Point & lhs, const Point & rhs){return Point((lhs.x+rhs.x)/2,(lhs.y+rhs.y)/2);};
+    for(auto _ : state) {
+        auto contracted = contract(graph,closeNodes,midpoint,workers);
+        benchmark::DoNotOptimize(contracted);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(Contraction)->ArgsProduct({{1024,16384},{1,4}})->ArgNames({"nodes","workers"})->UseRealTime();
@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+#include <map>
+#include <fishnet/VectorIO.hpp>
+#include <fishnet/WGS84Ellipsoid.hpp>
+#include <fishnet/TemporaryDirectiory.h>
+#include "SyntheticData.hpp"
+
+using namespace fishnet;
+using namespace fishnet::geometry;
+using namespace fishnet::benchmarks;
+
+/**
+ * @brief Polygons of roughly 100m in diameter around (10°E,45°N), in WGS84 coordinates
+ */
+static std::vector<Polygon<double>> lonLatPolygons(size_t count) {
+    return polygonGrid(count,16,0.001,Point(10,45));
+}
+
+/**
+ * @brief Shapefile containing count synthetic polygons, written once per count into a temporary directory removed on exit
+ */
+static const Shapefile & syntheticShapefile(size_t count) {
+    static util::AutomaticTemporaryDirectory directory;
+    static std::map<size_t,Shapefile> files;
+    if(not files.contains(count)) {
+        VectorLayer<Polygon<double>> layer {WGS84Ellipsoid::spatialReference};
+        layer.addAllGeometry(lonLatPolygons(count));
+        Shapefile destination {directory.get() / std::filesystem::path("polygons_"+std::to_string(count)+".shp")};
+        files.try_emplace(count,VectorIO::overwrite(layer,destination));
+    }
+    return files.at(count);
+}
+
+static void ShapefileRead(benchmark::State & state) {
+    const auto & shapefile = syntheticShapefile(size_t(state.range(0)));
+    for(auto _ : state) {
+        auto layer = VectorIO::read<Polygon<double>>(shapefile);
+        benchmark::DoNotOptimize(layer);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(ShapefileRead)->RangeMultiplier(8)->Range(512,32768)->Unit(benchmark::kMillisecond);
+
+static void GeometryCacheRead(benchmark::State & state) {
+    static util::AutomaticTemporaryDirectory directory;
+    auto layer = VectorIO::read<Polygon<double>>(syntheticShapefile(size_t(state.range(0))));
+    GeometryCache cache {directory.get() / std::filesystem::path("polygons_"+std::to_string(state.range(0))+".fgc")};
+    VectorIO::overwrite(layer,cache);
+    for(auto _ : state) {
+        auto cachedLayer = VectorIO::read<Polygon<double>>(cache);
+        benchmark::DoNotOptimize(cachedLayer);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(GeometryCacheRead)->RangeMultiplier(8)->Range(512,32768)->Unit(benchmark::kMillisecond);
+
+static void WGS84Distance(benchmark::State & state) {
+    auto points = randomLonLatPoints(2*size_t(state.range(0)));
+    bool exact = state.range(1) != 0;
+    for(auto _ : state) {
+        double sum = 0;
+        for(size_t i = 0; i + 1 < points.size(); i += 2) {
+            sum += WGS84Ellipsoid::distance(points[i],points[i+1],exact);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(WGS84Distance)->ArgsProduct({{1024,65536},{0,1}})->ArgNames({"pairs","exact"});
+
+static void WGS84BatchedDistances(benchmark::State & state) {
+    auto points = randomLonLatPoints(size_t(state.range(0)));
+    WGS84PointCache cache {points};
+    bool exact = state.range(1) != 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(WGS84Ellipsoid::distances(points.front(),cache,exact));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(WGS84BatchedDistances)->ArgsProduct({{1024,65536},{0,1}})->ArgNames({"pairs","exact"});
+
+static void WGS84LocalTangentPlaneDistance(benchmark::State & state) {
+    std::vector<Point> centers;
+    for(const auto & polygon: lonLatPolygons(size_t(state.range(0)))) {
+        centers.push_back(polygon.centroid());
+    }
+    for(auto _ : state) {
+        double sum = 0;
+        for(size_t i = 0; i + 1 < centers.size(); ++i) {
+            sum += WGS84Ellipsoid::localTangentPlaneDistance(centers[i],centers[i+1]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(WGS84LocalTangentPlaneDistance)->Arg(1024)->Arg(65536);
+
+static void WGS84Area(benchmark::State & state) {
+    auto polygons = lonLatPolygons(size_t(state.range(0)));
+    for(auto _ : state) {
+        double sum = 0;
+        for(const auto & polygon: polygons) {
+            sum += WGS84Ellipsoid::area(polygon);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(WGS84Area)->RangeMultiplier(8)->Range(64,4096);
+
+static void WGS84BatchedAreas(benchmark::State & state) {
+    auto polygons = lonLatPolygons(size_t(state.range(0)));
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(WGS84Ellipsoid::areas(polygons));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(WGS84BatchedAreas)->RangeMultiplier(8)->Range(64,4096);
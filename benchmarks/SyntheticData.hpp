@@ -0,0 +1,120 @@
+#pragma once
+#include <random>
+#include <numbers>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <fishnet/Vec2D.hpp>
+#include <fishnet/Polygon.hpp>
+#include <fishnet/Graph.hpp>
+
+/**
+ * @brief Deterministic generators for the synthetic inputs of the benchmarks.
+ * All generators are seeded, such that every run of the suite measures the same data.
+ */
+namespace fishnet::benchmarks {
+constexpr static unsigned SEED = 42;
+
+using Point = geometry::Vec2D<double>;
+
+/**
+ * @brief Points of a star-shaped (hence simple) ring around the center
+ *
+ * @param vertices number of vertices
+ * @param center center of the star
+ * @param radius maximum distance of a vertex to the center
+ * @param generator random generator for the distances
+ * @return std::vector<Point> vertices in counterclockwise order
+ */
+static std::vector<Point> starShapedPoints(size_t vertices, Point center, double radius, std::mt19937 & generator) {
+    std::uniform_real_distribution<double> distance {0.5*radius,radius};
+    std::vector<Point> points;
+    points.reserve(vertices);
+    for(size_t i = 0; i < vertices; ++i) {
+        double angle = 2 * std::numbers::pi * double(i) / double(vertices);
+        double r = distance(generator);
+        points.emplace_back(center.x + r*std::cos(angle),center.y + r*std::sin(angle));
+    }
+    return points;
+}
+
+static std::vector<Point> starShapedPoints(size_t vertices, unsigned seed = SEED) {
+    std::mt19937 generator {seed};
+    return starShapedPoints(vertices,Point(0,0),100,generator);
+}
+
+/**
+ * @brief Star-shaped polygons on a square grid, each reaching up to 60% of the spacing from its center.
+ * Hence the polygons of adjacent cells are close to each other or overlap with their bounding boxes, like settlement outlines.
+ *
+ * @param count number of polygons
+ * @param vertices number of vertices per polygon
+ * @param spacing distance between the centers of adjacent grid cells
+ * @param origin center of the first polygon
+ * @param seed
+ * @return std::vector<geometry::Polygon<double>>
+ */
+static std::vector<geometry::Polygon<double>> polygonGrid(size_t count, size_t vertices = 16, double spacing = 10, Point origin = Point(0,0), unsigned seed = SEED) {
+    std::mt19937 generator {seed};
+    std::uniform_real_distribution<double> radius {0.3*spacing,0.6*spacing};
+    size_t side = size_t(std::ceil(std::sqrt(double(count))));
+    std::vector<geometry::Polygon<double>> polygons;
+    polygons.reserve(count);
+    for(size_t i = 0; i < count; ++i) {
+        Point center {origin.x + double(i % side) * spacing, origin.y + double(i / side) * spacing};
+        polygons.emplace_back(geometry::Ring<double>(starShapedPoints(vertices,center,radius(generator),generator)));
+    }
+    return polygons;
+}
+
+/**
+ * @brief Random (longitude,latitude) points, excluding the poles
+ *
+ * @param count
+ * @param seed
+ * @return std::vector<Point>
+ */
+static std::vector<Point> randomLonLatPoints(size_t count, unsigned seed = SEED) {
+    std::mt19937 generator {seed};
+    std::uniform_real_distribution<double> longitude {-180,180};
+    std::uniform_real_distribution<double> latitude {-80,80};
+    std::vector<Point> points;
+    points.reserve(count);
+    for(size_t i = 0; i < count; ++i) {
+        double lon = longitude(generator);
+        points.emplace_back(lon,latitude(generator));
+    }
+    return points;
+}
+
+/**
+ * @brief Random geometric graph: uniformly distributed points in a square with an expected degree of roughly averageDegree,
+ * connected if their distance is at most 1.
+ *
+ * @param nodes number of nodes
+ * @param averageDegree expected number of neighbours of each node
+ * @param seed
+ * @return UndirectedGraph<Point>
+ */
+static graph::UndirectedGraph<Point> randomGeometricGraph(size_t nodes, double averageDegree = 4, unsigned seed = SEED) {
+    std::mt19937 generator {seed};
+    double side = std::sqrt(double(nodes) * std::numbers::pi / averageDegree);
+    std::uniform_real_distribution<double> coordinate {0,side};
+    std::vector<Point> points;
+    points.reserve(nodes);
+    for(size_t i = 0; i < nodes; ++i) {
+        double x = coordinate(generator);
+        points.emplace_back(x,coordinate(generator));
+    }
+    std::ranges::sort(points,[](const Point & lhs, const Point & rhs){return lhs.x < rhs.x;});
+    graph::UndirectedGraph<Point> graph;
+    graph.addNodes(points);
+    for(size_t i = 0; i < points.size(); ++i) {
+        for(size_t j = i+1; j < points.size() && points[j].x - points[i].x <= 1; ++j) {
+            if(points[i].distance(points[j]) <= 1)
+                graph.addEdge(points[i],points[j]);
+        }
+    }
+    return graph;
+}
+}
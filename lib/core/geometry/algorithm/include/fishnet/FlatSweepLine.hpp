@@ -0,0 +1,124 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include <fishnet/FunctionalConcepts.hpp>
+#include <fishnet/Constants.hpp>
+#include <fishnet/SweepLine.hpp>
+
+namespace fishnet::geometry {
+
+/**
+ * @brief Sweep line engine without virtual events: the events are plain tagged values (event point, EventType, payload) in a flat vector,
+ * which is sorted once before the sweep, instead of heap-allocated event objects in a priority queue.
+ * The processing of the events is a single handler for all event types, the sweep line status is an arbitrary type owned by the engine.
+ * Events are processed in the same order as by the SweepLine: by their event points as defined by EventQueueGreater (default: descending),
+ * approximately equal event points with insert events before remove events (or vice versa if RemoveEventsFirst).
+ * @tparam Payload value identifying the object of the event, e.g. an index or a pointer
+ * @tparam Status type of the sweep line status
+ * @tparam RemoveEventsFirst if true, remove events are processed before insert events at equal event points
+ * @tparam EventQueueGreater BiPredicate, returning true if the first event point is processed before the second
+ */
+template<typename Payload, typename Status, bool RemoveEventsFirst = false, util::BiPredicate<fishnet::math::DEFAULT_NUMERIC> EventQueueGreater = std::greater<fishnet::math::DEFAULT_NUMERIC>>
+class FlatSweepLine {
+public:
+    struct Event {
+        fishnet::math::DEFAULT_NUMERIC point;
+        EventType type;
+        Payload payload;
+    };
+private:
+    const static inline EventQueueGreater eventQueueGreater = EventQueueGreater {};
+    std::vector<Event> events;
+    Status status;
+
+    /**
+     * @brief Event comparator of the SweepLine, applied to the flat events
+     */
+    struct EventQueueGreaterFlat {
+        bool operator()(const Event & lhs, const Event & rhs) const noexcept {
+            if(fishnet::math::areEqual(lhs.point,rhs.point)){
+                if constexpr(RemoveEventsFirst)
+                    return lhs.type == EventType::INSERT; // insert events are processed after remove events
+                else
+                    return lhs.type != EventType::INSERT; // insert events are processed before remove events
+            }
+            return eventQueueGreater(rhs.point,lhs.point);
+        }
+    };
+
+    /**
+     * @brief Sorts the events into processing order with the same heap operations as the priority queue of the SweepLine,
+     * such that events with equal event points are processed in the same order as before
+     */
+    void order() {
+        constexpr static auto greater = EventQueueGreaterFlat {};
+        for(auto last = events.begin(); last != events.end();) {
+            std::push_heap(events.begin(),++last,greater);
+        }
+        for(auto last = events.end(); last != events.begin(); --last) {
+            std::pop_heap(events.begin(),last,greater);
+        }
+        std::ranges::reverse(events);
+    }
+
+public:
+    /**
+     * @brief Construct a new sweep line, the status is constructed from the arguments
+     */
+    template<typename... Args>
+    requires std::constructible_from<Status,Args...>
+    explicit FlatSweepLine(Args &&... args):status(std::forward<Args>(args)...){}
+
+    void reserve(size_t numberOfEvents) {
+        events.reserve(numberOfEvents);
+    }
+
+    void addEvent(fishnet::math::DEFAULT_NUMERIC eventPoint, EventType type, Payload payload) {
+        events.push_back(Event{eventPoint,type,std::move(payload)});
+    }
+
+    void addInsertEvent(fishnet::math::DEFAULT_NUMERIC eventPoint, Payload payload) {
+        addEvent(eventPoint,EventType::INSERT,std::move(payload));
+    }
+
+    void addRemoveEvent(fishnet::math::DEFAULT_NUMERIC eventPoint, Payload payload) {
+        addEvent(eventPoint,EventType::REMOVE,std::move(payload));
+    }
+
+    size_t size() const noexcept {
+        return events.size();
+    }
+
+    const Status & getStatus() const noexcept {
+        return status;
+    }
+
+    Status & getStatus() noexcept {
+        return status;
+    }
+
+    /**
+     * @brief Processes all events in order, the events are cleared afterwards.
+     *
+     * @param handler callable with (const Event &, Status &). If the handler returns a bool, the sweep stops as soon as it returns false
+     */
+    template<typename Handler>
+    requires std::invocable<Handler &, const Event &, Status &>
+    void sweep(Handler && handler) {
+        order();
+        for(const Event & event: events) {
+            if constexpr(std::same_as<std::invoke_result_t<Handler &,const Event &,Status &>,bool>) {
+                if(not handler(event,status))
+                    break;
+            }else {
+                handler(event,status);
+            }
+        }
+        events.clear();
+    }
+};
+}
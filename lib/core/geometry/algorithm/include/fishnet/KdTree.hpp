@@ -0,0 +1,223 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <ranges>
+#include <numeric>
+#include <optional>
+#include <limits>
+#include <fishnet/Vec2D.hpp>
+#include <fishnet/LinearGeometry.hpp>
+#include <fishnet/NumericConcepts.hpp>
+#include <fishnet/CollectionConcepts.hpp>
+#include <fishnet/FunctionalConcepts.hpp>
+
+namespace fishnet::geometry {
+
+/**
+ * @brief Static 2-d tree over points, bulk-loaded by recursive median splits:
+ * https://en.wikipedia.org/wiki/K-d_tree
+ * Each range of points is split at its median along the axis of the larger extent, the median is stored in the middle of the range,
+ * such that the tree is implicit in the order of the points and no nodes are allocated. Ranges of at most LEAF_SIZE points are scanned linearly.
+ * Points are identified by their index in the input range. The tree is immutable after construction and can be queried concurrently.
+ * Construction O(n log n), k-nearest-neighbour queries O(log n + k) on average.
+ * @tparam T numeric type of the points
+ */
+template<fishnet::math::Number T = fishnet::math::DEFAULT_NUMERIC>
+class KdTree {
+private:
+    using FLOAT_TYPE = fishnet::math::DEFAULT_FLOATING_POINT;
+    constexpr static size_t LEAF_SIZE = 8;
+    using Candidate = std::pair<FLOAT_TYPE,size_t>; // (squared distance, position)
+
+    std::vector<Vec2D<T>> points; // points in tree order
+    std::vector<size_t> ids; // index of the point in the input range, in tree order
+    std::vector<unsigned char> axes; // split axis of the range with its median at this position: 0 = x, 1 = y
+
+    static FLOAT_TYPE coordinate(const auto & point, unsigned char axis) noexcept {
+        return axis == 0 ? FLOAT_TYPE(point.x) : FLOAT_TYPE(point.y);
+    }
+
+    static FLOAT_TYPE squaredDistance(const Vec2D<T> & point, const auto & query) noexcept {
+        FLOAT_TYPE dx = FLOAT_TYPE(point.x) - FLOAT_TYPE(query.x);
+        FLOAT_TYPE dy = FLOAT_TYPE(point.y) - FLOAT_TYPE(query.y);
+        return dx * dx + dy * dy;
+    }
+
+    static size_t middle(size_t begin, size_t end) noexcept {
+        return begin + (end-begin)/2;
+    }
+
+    void build(std::vector<size_t> & order, const std::vector<Vec2D<T>> & input, size_t begin, size_t end) {
+        if(end - begin <= LEAF_SIZE)
+            return;
+        auto [minX,maxX] = std::ranges::minmax(std::ranges::subrange(order.begin()+begin,order.begin()+end) | std::views::transform([&input](size_t i){return input[i].x;}));
+        auto [minY,maxY] = std::ranges::minmax(std::ranges::subrange(order.begin()+begin,order.begin()+end) | std::views::transform([&input](size_t i){return input[i].y;}));
+        unsigned char axis = FLOAT_TYPE(maxX) - FLOAT_TYPE(minX) >= FLOAT_TYPE(maxY) - FLOAT_TYPE(minY) ? 0 : 1;
+        size_t mid = middle(begin,end);
+        std::nth_element(order.begin()+begin,order.begin()+mid,order.begin()+end,[&input,axis](size_t lhs, size_t rhs){
+            return coordinate(input[lhs],axis) < coordinate(input[rhs],axis);
+        });
+        axes[mid] = axis;
+        build(order,input,begin,mid);
+        build(order,input,mid+1,end);
+    }
+
+    template<typename P, typename F>
+    void searchNearest(size_t begin, size_t end, const P & query, size_t k, std::vector<Candidate> & heap, F & predicate) const {
+        auto consider = [&](size_t position) {
+            FLOAT_TYPE distance = squaredDistance(points[position],query);
+            if(heap.size() == k && distance >= heap.front().first)
+                return;
+            if(not predicate(points[position]))
+                return;
+            if(heap.size() == k) {
+                std::ranges::pop_heap(heap);
+                heap.pop_back();
+            }
+            heap.emplace_back(distance,position);
+            std::ranges::push_heap(heap);
+        };
+        if(end - begin <= LEAF_SIZE) {
+            for(size_t position = begin; position < end; ++position) {
+                consider(position);
+            }
+            return;
+        }
+        size_t mid = middle(begin,end);
+        FLOAT_TYPE difference = coordinate(query,axes[mid]) - coordinate(points[mid],axes[mid]);
+        if(difference < 0) {
+            searchNearest(begin,mid,query,k,heap,predicate);
+            consider(mid);
+            if(heap.size() < k || difference * difference < heap.front().first)
+                searchNearest(mid+1,end,query,k,heap,predicate);
+        }else {
+            searchNearest(mid+1,end,query,k,heap,predicate);
+            consider(mid);
+            if(heap.size() < k || difference * difference < heap.front().first)
+                searchNearest(begin,mid,query,k,heap,predicate);
+        }
+    }
+
+    template<typename P, typename F>
+    void searchRadius(size_t begin, size_t end, const P & query, FLOAT_TYPE squaredRadius, F & visitor) const {
+        if(end - begin <= LEAF_SIZE) {
+            for(size_t position = begin; position < end; ++position) {
+                if(squaredDistance(points[position],query) <= squaredRadius)
+                    visitor(ids[position]);
+            }
+            return;
+        }
+        size_t mid = middle(begin,end);
+        FLOAT_TYPE difference = coordinate(query,axes[mid]) - coordinate(points[mid],axes[mid]);
+        if(difference <= 0 || difference * difference <= squaredRadius)
+            searchRadius(begin,mid,query,squaredRadius,visitor);
+        if(squaredDistance(points[mid],query) <= squaredRadius)
+            visitor(ids[mid]);
+        if(difference >= 0 || difference * difference <= squaredRadius)
+            searchRadius(mid+1,end,query,squaredRadius,visitor);
+    }
+
+public:
+    KdTree() = default;
+
+    /**
+     * @brief Bulk-load the tree from a range of points. The id of each point is its index in the range.
+     *
+     * @param input range of points
+     */
+    explicit KdTree(util::forward_range_of<Vec2D<T>> auto const & input) {
+        std::vector<Vec2D<T>> copy;
+        for(const auto & point: input) {
+            copy.push_back(point);
+        }
+        std::vector<size_t> order(copy.size());
+        std::iota(order.begin(),order.end(),0);
+        axes.assign(copy.size(),0);
+        build(order,copy,0,order.size());
+        points.reserve(copy.size());
+        for(size_t id: order) {
+            points.push_back(copy[id]);
+        }
+        ids = std::move(order);
+    }
+
+    size_t size() const noexcept {
+        return points.size();
+    }
+
+    bool empty() const noexcept {
+        return points.empty();
+    }
+
+    /**
+     * @brief Computes the k nearest points to the query point, which satisfy the predicate, in a single traversal of the tree.
+     * Candidates are kept in a bounded max-heap, subtrees farther away than the current k-th candidate are pruned.
+     * @param query query point
+     * @param k maximum number of neighbours
+     * @param predicate filter on the points, e.g. to exclude the query point itself
+     * @return std::vector<size_t> ids of at most k points, ordered by increasing distance to the query point
+     */
+    std::vector<size_t> kNearest(IPoint auto const & query, size_t k, util::Predicate<Vec2D<T>> auto const & predicate) const {
+        std::vector<Candidate> heap;
+        if(k == 0 || points.empty())
+            return {};
+        heap.reserve(std::min(k,points.size()));
+        searchNearest(0,points.size(),query,k,heap,predicate);
+        std::ranges::sort_heap(heap);
+        std::vector<size_t> result;
+        result.reserve(heap.size());
+        for(const auto & [distance,position]: heap) {
+            result.push_back(ids[position]);
+        }
+        return result;
+    }
+
+    std::vector<size_t> kNearest(IPoint auto const & query, size_t k) const {
+        return kNearest(query,k,util::TruePredicate{});
+    }
+
+    /**
+     * @brief Computes the nearest point to the query point, which satisfies the predicate
+     *
+     * @param query query point
+     * @param predicate filter on the points
+     * @return std::optional<size_t> id of the nearest point, or std::nullopt if no point satisfies the predicate
+     */
+    std::optional<size_t> nearest(IPoint auto const & query, util::Predicate<Vec2D<T>> auto const & predicate) const {
+        auto result = kNearest(query,1,predicate);
+        if(result.empty())
+            return std::nullopt;
+        return result.front();
+    }
+
+    std::optional<size_t> nearest(IPoint auto const & query) const {
+        return nearest(query,util::TruePredicate{});
+    }
+
+    /**
+     * @brief Visit the ids of all points within the distance radius to the query point (inclusive)
+     * The order of the visited points is determined by the tree and not by the input order.
+     * @param query query point
+     * @param radius maximum distance
+     * @param visitor unary function called with the id of every point in the radius
+     */
+    void withinRadius(IPoint auto const & query, FLOAT_TYPE radius, util::Consumer<size_t> auto && visitor) const {
+        if(points.empty() || radius < 0)
+            return;
+        searchRadius(0,points.size(),query,radius*radius,visitor);
+    }
+
+    /**
+     * @brief Collect the ids of all points within the distance radius to the query point (inclusive)
+     *
+     * @param query query point
+     * @param radius maximum distance
+     * @return std::vector<size_t> ids of the points in the radius
+     */
+    std::vector<size_t> withinRadius(IPoint auto const & query, FLOAT_TYPE radius) const {
+        std::vector<size_t> result;
+        withinRadius(query,radius,[&result](size_t id){result.push_back(id);});
+        return result;
+    }
+};
+}
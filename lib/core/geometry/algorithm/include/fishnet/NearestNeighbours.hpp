@@ -1,8 +1,11 @@
 #pragma once
 #include <set>
 #include <ranges>
+#include <algorithm>
 #include <fishnet/Vec2D.hpp>
 #include <fishnet/UtilConcepts.hpp>
+#include <fishnet/KdTree.hpp>
+#include <fishnet/WorkStealingThreadPool.hpp>
 
 namespace fishnet::geometry {
 
@@ -51,43 +54,118 @@ constexpr Vec2D<T> nearestNeighbour(const Vec2D<T> & query, std::set<Vec2D<T>,Le
 
 /**
  * @brief Compute the k nearest neighours for a query point
- * 
+ * Sweeps once from the query point in both directions of the lexicographic order, keeping the k nearest candidates in a bounded max-heap.
+ * The sweep stops when the x-distance exceeds the distance of the k-th candidate.
  * @tparam T numeric type of the points
  * @param query query point
  * @param points lexicographically ordered set of points
  * @param k amount of nearest neighbours to compute
- * @return list of nearest neighbours to the query point
+ * @return list of nearest neighbours to the query point, ordered by increasing distance
  */
 template<math::Number T>
 constexpr std::vector<Vec2D<T>> kNearestNeighbours(const Vec2D<T> & query,  std::set<Vec2D<T>,LexicographicOrder>  const & points, const size_t k) noexcept {
+        if(points.empty())
+            return {};
         const size_t _k = std::min(k,util::size(points) - 1 ); // make sure k does not exceed the amount of points 
+        using Candidate = std::pair<fishnet::math::DEFAULT_FLOATING_POINT,Vec2D<T>>;
+        auto byDistance = [](const Candidate & lhs, const Candidate & rhs){return lhs.first < rhs.first;};
+        std::vector<Candidate> heap;
+        heap.reserve(_k);
+        auto worstDistance = [&heap,_k](){
+            return heap.size() < _k ? std::numeric_limits<fishnet::math::DEFAULT_FLOATING_POINT>::max() : heap.front().first;
+        };
+        auto consider = [&](const Vec2D<T> & neighbour){
+            if(neighbour == query)
+                return;
+            auto distance = query.distance(neighbour);
+            if(distance >= worstDistance())
+                return;
+            if(heap.size() == _k) {
+                std::ranges::pop_heap(heap,byDistance);
+                heap.pop_back();
+            }
+            heap.emplace_back(distance,neighbour);
+            std::ranges::push_heap(heap,byDistance);
+        };
+        if(_k == 0)
+            return {};
+        auto start = points.lower_bound(query);
+        for(auto it = start; it != points.end() && fabs(it->x - query.x) < worstDistance(); ++it){
+            consider(*it);
+        }
+        for(auto it = start; it != points.begin() && fabs(std::prev(it)->x - query.x) < worstDistance(); ){
+            --it;
+            consider(*it);
+        }
+        std::ranges::sort_heap(heap,byDistance);
         std::vector<Vec2D<T>> neighbours;
-        neighbours.resize(_k); // default construct k points in the vector
-        for(size_t i = 0; i < _k; i++){
-            auto notYetNeigbourPredicate = [neighbours](const Vec2D<T> & p){return std::ranges::find(neighbours,p) == neighbours.end();}; // predicate to avoid duplicate nearest neighbours in the output list
-            neighbours[i] = __impl::nearestNeighbourBinarySearch(query,points,notYetNeigbourPredicate);
+        neighbours.reserve(heap.size());
+        for(const auto & [distance,neighbour]: heap){
+            neighbours.push_back(neighbour);
         }
         return neighbours;
 }
 
+namespace __impl {
+template<typename T>
+std::vector<Vec2D<T>> uniquePoints(util::forward_range_of<Vec2D<T>> auto const & points) {
+    std::set<Vec2D<T>,LexicographicOrder> orderedSetOfPoints;
+    for(const auto & p: points){
+        orderedSetOfPoints.emplace(p);
+    }
+    return std::vector<Vec2D<T>>(orderedSetOfPoints.begin(),orderedSetOfPoints.end());
+}
+
+template<typename T>
+std::vector<Vec2D<T>> kNearestNeighbours(const KdTree<T> & tree, const std::vector<Vec2D<T>> & points, size_t index, size_t k) {
+    const Vec2D<T> & query = points[index];
+    auto ids = tree.kNearest(query,std::min(k,points.size()-1),[&query](const Vec2D<T> & p){return p != query;});
+    std::vector<Vec2D<T>> neighbours;
+    neighbours.reserve(ids.size());
+    for(size_t id: ids){
+        neighbours.push_back(points[id]);
+    }
+    return neighbours;
+}
+}
+
 /**
  * @brief Compute the k nearest neighbours for each point
- * 
+ * Each point is queried against a kd-tree over all points, which is built once
  * @tparam T numeric type of the points
  * @param points range of points
  * @param k amount of nearest neighbours to compute
- * @return std::vector<std::pair<Vec2D<T>,std::vector<Vec2D<T>>>>, a list of entries, with each entry storing a point and its k nearest neighbours
+ * @return std::vector<std::pair<Vec2D<T>,std::vector<Vec2D<T>>>>, a list of entries in lexicographic order of the points, with each entry storing a point and its k nearest neighbours
  */
 template<typename T>
 constexpr std::vector<std::pair<Vec2D<T>,std::vector<Vec2D<T>>>> AllKNearestNeighbours(util::forward_range_of<Vec2D<T>> auto const & points, const size_t k) noexcept {
-    std::set<Vec2D<T>,LexicographicOrder> orderedSetOfPoints;
+    auto uniquePoints = __impl::uniquePoints<T>(points);
+    KdTree<T> tree {uniquePoints};
     std::vector<std::pair<Vec2D<T>,std::vector<Vec2D<T>>>> result;
-    for(const auto & p: points){
-        orderedSetOfPoints.emplace(p);
-    }
-    for( auto & point : orderedSetOfPoints){
-        result.emplace_back(std::make_pair(point,kNearestNeighbours(point,orderedSetOfPoints,k)));
+    result.reserve(uniquePoints.size());
+    for(size_t i = 0; i < uniquePoints.size(); ++i){
+        result.emplace_back(uniquePoints[i],__impl::kNearestNeighbours(tree,uniquePoints,i,k));
     }
     return result;
 }
+
+/**
+ * @brief Compute the k nearest neighbours for each point in parallel on the thread pool
+ * 
+ * @tparam T numeric type of the points
+ * @param points range of points
+ * @param k amount of nearest neighbours to compute
+ * @param pool thread pool executing the queries
+ * @return std::vector<std::pair<Vec2D<T>,std::vector<Vec2D<T>>>>, same result as the sequential AllKNearestNeighbours
+ */
+template<typename T>
+std::vector<std::pair<Vec2D<T>,std::vector<Vec2D<T>>>> AllKNearestNeighbours(util::forward_range_of<Vec2D<T>> auto const & points, const size_t k, util::WorkStealingThreadPool & pool) {
+    auto uniquePoints = __impl::uniquePoints<T>(points);
+    KdTree<T> tree {uniquePoints};
+    std::vector<std::pair<Vec2D<T>,std::vector<Vec2D<T>>>> result(uniquePoints.size());
+    pool.parallelFor(0,uniquePoints.size(),[&](size_t i){
+        result[i] = std::make_pair(uniquePoints[i],__impl::kNearestNeighbours(tree,uniquePoints,i,k));
+    });
+    return result;
+}
 }
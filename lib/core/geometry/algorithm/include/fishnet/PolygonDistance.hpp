@@ -2,7 +2,8 @@
 #include <fishnet/Vec2D.hpp>
 #include <fishnet/ShapeGeometry.hpp>
 #include <fishnet/FunctionalConcepts.hpp>
-#include "SweepLine.hpp"
+#include <set>
+#include "FlatSweepLine.hpp"
 #include <fishnet/Segment.hpp>
 
 namespace fishnet::geometry {
@@ -191,81 +192,99 @@ public:
     }
 };
 
+/**
+ * @brief Dereferencing ordering of the polygon points in the sweep line status
+ */
 template<bool isXOrdered>
-using PolygonPointSweepLine = SweepLine<PolygonPoint<isXOrdered>,ClosestPointsResult,std::less<PolygonPoint<isXOrdered>>,false,std::less<fishnet::math::DEFAULT_NUMERIC>>;
+struct PolygonPointOrdering {
+    bool operator()(const PolygonPoint<isXOrdered> * lhs, const PolygonPoint<isXOrdered> * rhs) const noexcept {
+        return *lhs < *rhs;
+    }
+};
 
 template<bool isXOrdered>
-struct PolygonSegmentSweepEvent : public PolygonPointSweepLine<isXOrdered>::InsertEvent {
+using PolygonPointSweepLineStatus = std::set<const PolygonPoint<isXOrdered> *,PolygonPointOrdering<isXOrdered>>;
 
-    PolygonSegmentSweepEvent(const PolygonPoint<isXOrdered> & point):PolygonPointSweepLine<isXOrdered>::InsertEvent(point){}
+template<bool isXOrdered>
+using PolygonPointSweepLine = FlatSweepLine<const PolygonPoint<isXOrdered> *,PolygonPointSweepLineStatus<isXOrdered>,false,std::less<fishnet::math::DEFAULT_NUMERIC>>;
 
-    virtual fishnet::math::DEFAULT_NUMERIC eventPoint() const noexcept {
+/**
+ * @brief Processing of the insert events of the polygon point sweep line
+ * 
+ * @tparam isXOrdered 
+ */
+template<bool isXOrdered>
+struct PolygonSegmentSweepHandler {
+    ClosestPointsResult & status;
+
+    static fishnet::math::DEFAULT_NUMERIC eventPoint(const PolygonPoint<isXOrdered> & polygonPoint) noexcept {
         if constexpr(isXOrdered)
-            return this->obj->getPoint().x;
+            return polygonPoint.getPoint().x;
         else 
-            return this->obj->getPoint().y;
+            return polygonPoint.getPoint().y;
     }
 
     /**
      * @brief Indicates whether the sweep line can be stop.
      * This is the case when one polygon was fully processed and the current segment is out of range of the closest possible neighbour
-     * @param sweepLine 
-     * @param status 
+     * @param polygonPoint 
      * @return true 
      * @return false 
      */
-    bool inline stop(PolygonPointSweepLine<isXOrdered> & sweepLine, ClosestPointsResult & status) const {
+    bool inline stop(const PolygonPoint<isXOrdered> & polygonPoint) const {
         if constexpr(isXOrdered)
-            return (status.thisCounter==0 || status.otherCounter==0) && this->obj->segment.leftEndpoint().x - status.minDistance > status.getNeighbour(*this->obj).x;
+            return (status.thisCounter==0 || status.otherCounter==0) && polygonPoint.segment.leftEndpoint().x - status.minDistance > status.getNeighbour(polygonPoint).x;
         else 
-            return (status.thisCounter==0 || status.otherCounter==0) && this->obj->segment.lowerEndpoint().x - status.minDistance > status.getNeighbour(*this->obj).x;
+            return (status.thisCounter==0 || status.otherCounter==0) && polygonPoint.segment.lowerEndpoint().x - status.minDistance > status.getNeighbour(polygonPoint).x;
     }
 
     /**
      * @brief Query for finding segments in the buffer of the sweep line (currentSegment.left.x-distance,current.x]
      * x is swapped for y when sweep line is not ordered by x
-     * @param status 
+     * @param polygonPoint 
      * @return PolygonPoint<isXOrdered>
      */
-    PolygonPoint<isXOrdered> lowerBoundQuery(ClosestPointsResult & status) const noexcept {
+    PolygonPoint<isXOrdered> lowerBoundQuery(const PolygonPoint<isXOrdered> & polygonPoint) const noexcept {
         if constexpr(isXOrdered)
-            return PolygonPoint<isXOrdered>(Segment<fishnet::math::DEFAULT_FLOATING_POINT>(this->obj->segment.leftEndpoint() - Vec2DReal(status.minDistance,0),this->obj->getPoint()),this->obj->polygonRef.other());
+            return PolygonPoint<isXOrdered>(Segment<fishnet::math::DEFAULT_FLOATING_POINT>(polygonPoint.segment.leftEndpoint() - Vec2DReal(status.minDistance,0),polygonPoint.getPoint()),polygonPoint.polygonRef.other());
         else 
-            return PolygonPoint<isXOrdered>(Segment<fishnet::math::DEFAULT_FLOATING_POINT>(this->obj->segment.lowerEndpoint() - Vec2DReal(0,status.minDistance),this->obj->getPoint()),this->obj->polygonRef.other());
+            return PolygonPoint<isXOrdered>(Segment<fishnet::math::DEFAULT_FLOATING_POINT>(polygonPoint.segment.lowerEndpoint() - Vec2DReal(0,status.minDistance),polygonPoint.getPoint()),polygonPoint.polygonRef.other());
     }
 
     /**
      * @brief Query for finding segments in the buffer of the sweep line [current.x,currentSegment.right.x+distance)
      * x is swapped for y when sweep line is not ordered by x
-     * @param status 
+     * @param polygonPoint 
      * @return PolygonPoint<isXOrdered> 
      */
-    PolygonPoint<isXOrdered> upperBoundQuery(ClosestPointsResult & status) const noexcept {
+    PolygonPoint<isXOrdered> upperBoundQuery(const PolygonPoint<isXOrdered> & polygonPoint) const noexcept {
         if constexpr(isXOrdered)
-            return PolygonPoint<isXOrdered>({this->obj->segment.rightEndpoint() + Vec2DReal(status.minDistance,0),this->obj->getPoint()},this->obj->polygonRef.other());
+            return PolygonPoint<isXOrdered>({polygonPoint.segment.rightEndpoint() + Vec2DReal(status.minDistance,0),polygonPoint.getPoint()},polygonPoint.polygonRef.other());
         else 
-            return PolygonPoint<isXOrdered>({this->obj->segment.upperEndpoint() + Vec2DReal(0,status.minDistance),this->obj->getPoint()},this->obj->polygonRef.other());
+            return PolygonPoint<isXOrdered>({polygonPoint.segment.upperEndpoint() + Vec2DReal(0,status.minDistance),polygonPoint.getPoint()},polygonPoint.polygonRef.other());
     }
 
-    virtual void process(PolygonPointSweepLine<isXOrdered> & sweepLine, ClosestPointsResult & status) const {
-        const auto & polygonPoint = *this->obj;
+    /**
+     * @brief Processing of an insert event
+     * 
+     * @param event 
+     * @param sweepLineStatus 
+     * @return false if the sweep can be stopped, since no closer distances can be found
+     */
+    bool operator()(const typename PolygonPointSweepLine<isXOrdered>::Event & event, PolygonPointSweepLineStatus<isXOrdered> & sweepLineStatus) const {
+        const auto & polygonPoint = *event.payload;
         const auto & point = polygonPoint.getPoint();
         const auto & segment = polygonPoint.getSegment();
-        sweepLine.addSLS(this->obj);
+        sweepLineStatus.insert(event.payload);
         status.visit(polygonPoint);
-        if(stop(sweepLine,status)){
-            /*Clear Event Queue since no closer distances can be found*/
-            while(sweepLine.getEventQueue().size() > 1)
-                sweepLine.getEventQueue().pop();
-            return;
-        }
+        if(stop(polygonPoint))
+            return false;
         if(not status.startSearch(polygonPoint.polygonRef))
-            return;
-        auto leftQuery  = lowerBoundQuery(status);
-        auto rightQuery = upperBoundQuery(status);
-        auto lowerBound = sweepLine.lowerBound(leftQuery);
-        auto upperBound = sweepLine.upperBound(rightQuery);
-        auto & sweepLineStatus = sweepLine.getSLS();
+            return true;
+        auto leftQuery  = lowerBoundQuery(polygonPoint);
+        auto rightQuery = upperBoundQuery(polygonPoint);
+        auto lowerBound = sweepLineStatus.lower_bound(&leftQuery);
+        auto upperBound = sweepLineStatus.upper_bound(&rightQuery);
         for(auto it= lowerBound; it != upperBound;){
             const auto & currentSegment = (*it)->getSegment();
             /*Remove elements out of range from the sweep line*/
@@ -295,6 +314,7 @@ struct PolygonSegmentSweepEvent : public PolygonPointSweepLine<isXOrdered>::Inse
             }
             ++it;
         }
+        return true;
     }
 };
 
@@ -334,11 +354,12 @@ static std::pair<Vec2DReal,Vec2DReal> closestPointsSweep(SegmentRange auto && lh
         }
         status.otherCounter+=2;
     });
+    sweepLine.reserve(segments.size());
     std::ranges::for_each(segments,[&sweepLine](const auto & segment){
-        sweepLine.addEvent(std::make_unique<PolygonSegmentSweepEvent<xSweep>>(segment));
+        sweepLine.addInsertEvent(PolygonSegmentSweepHandler<xSweep>::eventPoint(segment),&segment);
     });
-    auto result = sweepLine.sweep(status);
-    return {result.thisPoint,result.otherPoint};
+    sweepLine.sweep(PolygonSegmentSweepHandler<xSweep>{status});
+    return {status.thisPoint,status.otherPoint};
 }
 
 
@@ -1,79 +1,59 @@
 #pragma once
-#include "SweepLine.hpp"
+#include "FlatSweepLine.hpp"
 #include "BoundingBoxPolygon.hpp"
+#include <fishnet/IntervalTree.hpp>
 namespace fishnet::geometry {
 
 namespace __impl{
 
+/**
+ * @brief Status of the Polygon Filter Sweepline: interval tree over the horizontal extents of the bounding boxes of all polygons.
+ * Since the sweep line goes from top to bottom, the active polygons overlap vertically with the polygon under test,
+ * querying the tree for the horizontal extent yields exactly the polygons with overlapping bounding boxes.
+ * Intervals are identified by the index of the polygon
+ */
+using PolygonFilterStatus = util::IntervalTree<fishnet::math::DEFAULT_NUMERIC>;
+
 /**
  * @brief Type for Polygon Filter Sweepline
- * It stores the polygons as BoundingBoxPolygons in the SLS and sorts them from left to right
- * The output is a vector of polygons of type P, which are passing the filter.
- * @tparam P polygon type
+ * Insert events at the top and remove events at the bottom of the bounding boxes (Sweepline goes from top to bottom), the payload is the index of the polygon.
  */
-template<IPolygon P>
-using PolygonFilter = SweepLine<BoundingBoxPolygon<P>,std::vector<P>,HorizontalAABBOrdering<P>>;
+using PolygonFilter = FlatSweepLine<size_t,PolygonFilterStatus>;
 
 /**
- * @brief Insert event for Polygon Filter Sweepline
+ * @brief Processing of the Polygon Filter events
  * 
  * @tparam P polygon type
  * @tparam BinaryFilter (P,P) -> bool
  * @tparam Filter: (P) -> bool
  */
 template<IPolygon P,util::BiPredicate<P> BinaryFilter, util::Predicate<P> Filter>
-class PolygonFilterInsertEvent:public PolygonFilter<P>::InsertEvent{
-private:
-    Filter & filter; 
+struct PolygonFilterHandler {
+    const std::vector<BoundingBoxPolygon<P>> & boxes;
     BinaryFilter & binaryFilter;
+    Filter & filter;
+    std::vector<P> & output;
 
-public:
-    PolygonFilterInsertEvent(const BoundingBoxPolygon<P> & box,BinaryFilter  & binaryCondition, Filter  & condition):PolygonFilter<P>::InsertEvent(box),filter(condition),binaryFilter(binaryCondition){}
-    
     /**
-     * @brief processing of this event
-     * 
-     * @param sweepLine 
-     * @param output 
+     * @brief Insert: the binary filter is only evaluated with the active polygons, whose bounding box overlaps the bounding box of the polygon under test.
+     * Remove: the polygon is deactivated
      */
-    virtual void process(PolygonFilter<P> & sweepLine, std::vector<P> & output)const{
-        const auto & polygonUnderTest = this->obj->getPolygon();
+    void operator()(const PolygonFilter::Event & event, PolygonFilterStatus & status) const {
+        const size_t index = event.payload;
+        if(event.type == EventType::REMOVE) {
+            status.deactivate(index);
+            return;
+        }
+        const auto & polygonUnderTest = boxes[index].getPolygon();
         if(not filter(polygonUnderTest))
             return; // directly return if polygon does not pass filter
-        sweepLine.addSLS(this->obj);
-        const auto & sls = sweepLine.getSLS();
-        for(auto it = sls.lower_bound(this->obj); it != sls.begin() && it != sls.end() /* && this->obj->getBoundingBox().left() <= (*it)->getBoundingBox().right() */; ){
-            --it; // skip same element, by first decrementing
-            if( not binaryFilter((*it)->getPolygon(),polygonUnderTest))
-                return;
-        }
-        for(auto it = sls.upper_bound(this->obj);it != sls.end() /* && this->obj->getBoundingBox().right() >= (*it)->getBoundingBox().left() */; ++it){
-            if(not binaryFilter((*it)->getPolygon(),polygonUnderTest))
-                return;
-        }
-        output.push_back(polygonUnderTest); // add to output if all filters were passed
-    }
-
-    /**
-     * @brief EventPoint of Insert is the top of the bounding box (Sweepline goes from top to bottom)
-     * 
-     * @return fishnet::math::DEFAULT_NUMERIC 
-     */
-    virtual fishnet::math::DEFAULT_NUMERIC eventPoint() const noexcept {
-        return this->obj->getBoundingBox().top();
-    }
-};
-
-template<IPolygon P>
-struct PolygonFilterRemoveEvent: public PolygonFilter<P>::DefaultRemoveEvent {
-    PolygonFilterRemoveEvent(const BoundingBoxPolygon<P> & box):PolygonFilter<P>::DefaultRemoveEvent(box){}
-    /**
-     * @brief EventPoint of Removal is the bottom of the bounding box (Sweepline goes from top to bottom)
-     * 
-     * @return fishnet::math::DEFAULT_NUMERIC 
-     */
-    virtual fishnet::math::DEFAULT_NUMERIC eventPoint() const noexcept {
-        return this->obj->getBoundingBox().bottom();
+        status.activate(index);
+        const auto & box = boxes[index].getBoundingBox();
+        bool passed = status.forEachActiveOverlapping(box.left(),box.right(),[this,index,&polygonUnderTest](size_t other){
+            return other == index || binaryFilter(boxes[other].getPolygon(),polygonUnderTest);
+        });
+        if(passed)
+            output.push_back(polygonUnderTest); // add to output if all filters were passed
     }
 };
 }
@@ -92,18 +72,21 @@ struct PolygonFilterRemoveEvent: public PolygonFilter<P>::DefaultRemoveEvent {
 template<PolygonRange R,util::BiPredicate<std::ranges::range_value_t<R>> BinaryFilter, util::Predicate<std::ranges::range_value_t<R>> Filter = util::TruePredicate>
 static std::vector<std::ranges::range_value_t<R>> filter( const R & polygons, BinaryFilter binaryCondition, Filter condition = Filter()) noexcept {
     using P = std::ranges::range_value_t<R>;
-    using SweepLine_t = typename __impl::PolygonFilter<P>;
-    SweepLine_t sweepLine;
     std::vector<P> out;
     std::vector<BoundingBoxPolygon<P>> boundingBoxPolygons;
     boundingBoxPolygons.reserve(util::size(polygons));
 
     std::ranges::for_each(polygons,[&boundingBoxPolygons](const auto & p){boundingBoxPolygons.emplace_back(p);});
-    std::ranges::for_each(boundingBoxPolygons,[&sweepLine,&binaryCondition,&condition](const auto & bbPptr){
-        sweepLine.addEvent(std::make_unique<__impl::PolygonFilterInsertEvent<P,BinaryFilter,Filter>>(bbPptr,binaryCondition,condition));
-        sweepLine.addEvent(std::make_unique<__impl::PolygonFilterRemoveEvent<P>>(bbPptr));
-    });
-    return sweepLine.sweep(out);
+    __impl::PolygonFilter sweepLine {boundingBoxPolygons | std::views::transform([](const auto & bbP){
+        return std::make_pair(bbP.getBoundingBox().left(),bbP.getBoundingBox().right());
+    })};
+    sweepLine.reserve(2*boundingBoxPolygons.size());
+    for(size_t i = 0; i < boundingBoxPolygons.size(); ++i) {
+        sweepLine.addInsertEvent(boundingBoxPolygons[i].getBoundingBox().top(),i);
+        sweepLine.addRemoveEvent(boundingBoxPolygons[i].getBoundingBox().bottom(),i);
+    }
+    sweepLine.sweep(__impl::PolygonFilterHandler<P,BinaryFilter,Filter>{boundingBoxPolygons,binaryCondition,condition,out});
+    return out;
 }
 
 /**
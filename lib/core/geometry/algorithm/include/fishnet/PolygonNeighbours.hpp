@@ -1,5 +1,8 @@
 #pragma once
-#include "SweepLine.hpp"
+#include <numeric>
+#include <future>
+#include <span>
+#include "RTree.hpp"
 #include "BoundingBoxPolygon.hpp"
 #include <fishnet/FunctionalConcepts.hpp>
 #include <fishnet/FixedSizeBuffer.hpp>
@@ -7,120 +10,225 @@
 
 namespace fishnet::geometry {
 
+/**
+ * @brief BiPredicate, which additionally decides all candidates of a polygon at once with batch(current,candidates),
+ * such that expensive computations can be grouped per polygon. batch() has to agree with the pairwise predicate.
+ */
+template<typename F, typename T>
+concept BatchedBiPredicate = util::BiPredicate<F,T> && requires(const F & predicate, const T & current, std::span<const T * const> candidates){
+    {predicate.batch(current,candidates)} -> std::same_as<std::vector<bool>>;
+};
+
 namespace __impl {
 
 /**
- * @brief Type for Polygon Neighbours Sweepline
- * It stores the polygons as BoundingBoxPolygons in the SLS and sorts them from left to right
- * The output is a vector of pairs of polygons of type P, with each pair indicating the adjacency of two polygons
- * Insert events are processed before remove events
- * @tparam P 
+ * @brief Computes the processing order of the polygons for the neighbour search:
+ * Polygons are ordered from top to bottom according to the bottom of their bounding boxes (ties are broken by input order).
+ * A polygon only considers neighbours processed after itself, such that every adjacency is reported at most once.
+ * @tparam P polygon type
+ * @param boundingBoxPolygons wrapped polygons
+ * @return std::vector<size_t> processing order, as indices into boundingBoxPolygons
  */
 template<IPolygon P>
-using PolygonNeighbours = SweepLine<BoundingBoxPolygon<P>,std::vector<std::pair<P,P>>,HorizontalAABBOrdering<P>,true>;
+static std::vector<size_t> neighbourSearchOrder(const std::vector<BoundingBoxPolygon<P>> & boundingBoxPolygons) {
+    std::vector<size_t> order(boundingBoxPolygons.size());
+    std::iota(order.begin(),order.end(),0);
+    std::ranges::stable_sort(order,[&boundingBoxPolygons](size_t lhs, size_t rhs){
+        return boundingBoxPolygons[lhs].getBoundingBox().bottom() > boundingBoxPolygons[rhs].getBoundingBox().bottom();
+    });
+    return order;
+}
 
+/**
+ * @brief Finds the k closest neighbours of a single polygon, using the R-tree over the bounding boxes
+ * 
+ * @tparam P polygon type
+ * @param current index of the polygon in boundingBoxPolygons
+ * @param boundingBoxPolygons wrapped polygons
+ * @param rank position of each polygon in the processing order
+ * @param index R-tree over the bounding boxes of boundingBoxPolygons
+ * @param neighbouringPredicate BiPredicate deciding if two polygons are adjacent, a BatchedBiPredicate decides all candidates at once
+ * @param k maximum number of neighbours
+ * @param output pairs of (current, neighbour) are appended
+ */
 template<IPolygon P>
-struct PolygonNeighboursInsertEvent : public PolygonNeighbours<P>::DefaultInsertEvent {
-    PolygonNeighboursInsertEvent(const BoundingBoxPolygon<P> & box):PolygonNeighbours<P>::DefaultInsertEvent(box){}
-    virtual fishnet::math::DEFAULT_NUMERIC eventPoint() const noexcept {
-        return this->obj->getBoundingBox().top();
+static void findNeighboursOf(size_t current, const std::vector<BoundingBoxPolygon<P>> & boundingBoxPolygons, const std::vector<size_t> & rank, const PackedRTree<> & index,
+    util::BiPredicate<BoundingBoxPolygon<P>> auto const & neighbouringPredicate, size_t k, std::vector<std::pair<P,P>> & output) {
+    const auto & currentPolygon = boundingBoxPolygons[current];
+    auto distanceMapper = [&currentPolygon](const auto & p){
+        return shapeDistance(currentPolygon.getPolygon(),p);
+    };
+    auto closestNeighbours = util::FixedSizeBuffer<P,std::invoke_result_t<decltype(distanceMapper),P>>(k,distanceMapper);
+    if constexpr(BatchedBiPredicate<std::remove_cvref_t<decltype(neighbouringPredicate)>,BoundingBoxPolygon<P>>) {
+        std::vector<const BoundingBoxPolygon<P> *> candidates;
+        index.query(AABB(currentPolygon.getBoundingBox()),[&](size_t candidate){
+            if(rank[candidate] > rank[current])
+                candidates.push_back(&boundingBoxPolygons[candidate]);
+        });
+        auto neighbouring = neighbouringPredicate.batch(currentPolygon,std::span<const BoundingBoxPolygon<P> * const>(candidates));
+        for(size_t i = 0; i < candidates.size(); ++i) {
+            if(neighbouring[i])
+                closestNeighbours.push(candidates[i]->getPolygon());
+        }
     }
-};
+    else {
+        index.query(AABB(currentPolygon.getBoundingBox()),[&](size_t candidate){
+            if(rank[candidate] <= rank[current])
+                return; // skip the polygon itself and polygons which already searched for their neighbours
+            const auto & neighbour = boundingBoxPolygons[candidate];
+            if(neighbouringPredicate(currentPolygon,neighbour))
+                closestNeighbours.push(neighbour.getPolygon());
+        });
+    }
+    for(auto && neighbour: closestNeighbours) {
+        output.emplace_back(currentPolygon.getPolygon(),std::move(neighbour));
+    }
+}
 
 /**
- * @brief Remove Event for Polygon Neighbours Sweepline
- * 
+ * @brief Partitions the polygons into vertical slabs of (almost) equal size, according to the x-center of their bounding boxes.
+ * The polygons of each slab are kept in processing order.
  * @tparam P polygon type
+ * @param boundingBoxPolygons wrapped polygons
+ * @param slabCount number of slabs
+ * @return std::vector<size_t> slab of each polygon
  */
 template<IPolygon P>
-struct PolygonNeighboursRemoveEvent: public PolygonNeighbours<P>::RemoveEvent {
-    util::BiPredicate_t<BoundingBoxPolygon<P>>  neighbouringPredicate; // BiPredicate deciding if two polygons are adjacent
-    size_t k;
-    PolygonNeighboursRemoveEvent(const BoundingBoxPolygon<P> & bbPptr, util::BiPredicate<BoundingBoxPolygon<P>> auto const & neighbouringBiPredicate,size_t k):PolygonNeighbours<P>::RemoveEvent(bbPptr),neighbouringPredicate(neighbouringBiPredicate),k(k){}
-
-    virtual fishnet::math::DEFAULT_NUMERIC eventPoint() const noexcept {
-        return this->obj->getBoundingBox().bottom();
+static std::vector<size_t> xSlabs(const std::vector<BoundingBoxPolygon<P>> & boundingBoxPolygons, size_t slabCount) {
+    std::vector<size_t> byX(boundingBoxPolygons.size());
+    std::iota(byX.begin(),byX.end(),0);
+    std::vector<double> centerX;
+    centerX.reserve(boundingBoxPolygons.size());
+    for(const auto & bbp: boundingBoxPolygons) {
+        centerX.push_back(AABB(bbp.getBoundingBox()).centerX());
+    }
+    std::ranges::stable_sort(byX,[&centerX](size_t lhs, size_t rhs){
+        return centerX[lhs] < centerX[rhs];
+    });
+    std::vector<size_t> slab(boundingBoxPolygons.size());
+    for(size_t i = 0; i < byX.size(); ++i) {
+        slab[byX[i]] = i * slabCount / byX.size();
     }
+    return slab;
+}
 
-    virtual void process(PolygonNeighbours<P> & sweepLine, std::vector<std::pair<P,P>> & output) const {
-        const auto & sls = sweepLine.getSLS();
-        const auto & current = *this->obj;
-        auto distanceMapper = [&current](const auto & p){
-            return shapeDistance(current.getPolygon(),p);
-        };
-        // auto itInRange = [&current](auto it){
-        //     return current.getBoundingBox().left() <= (*it)->getBoundingBox().right() ||
-        //         current.getBoundingBox().right() >= (*it)->getBoundingBox().left();
-        // };
-        auto closestNeighbours = util::FixedSizeBuffer<P,std::invoke_result_t<decltype(distanceMapper),P>>(k,distanceMapper);
-        bool skippedSameObject = false; // skip same Polygon object, since it is returned as the lower_bound in the first iteration
-        for(auto it = sls.lower_bound(this->obj); it != sls.end(); --it){
-            const auto & neighbour = *(*it);
-            if(skippedSameObject && neighbouringPredicate(current,neighbour)){
-                closestNeighbours.push(neighbour.getPolygon());
-                // output.push_back(std::make_pair(current.getPolygon(),neighbour.getPolygon()));   
+/**
+ * @brief Concurrent neighbour search: The polygons are partitioned into vertical slabs, each slab is processed by its own worker.
+ * All workers query the shared R-tree, hence each polygon is owned by exactly one slab and no pair has to be deduplicated at the slab borders.
+ * The results of the slabs are interleaved in processing order, such that the output is identical to the sequential search.
+ * @tparam P polygon type
+ * @param boundingBoxPolygons wrapped polygons
+ * @param order processing order, as indices into boundingBoxPolygons
+ * @param rank position of each polygon in the processing order
+ * @param index R-tree over the bounding boxes of boundingBoxPolygons
+ * @param neighbouringPredicate BiPredicate deciding if two polygons are adjacent, has to be safe to be called concurrently
+ * @param k maximum number of neighbours
+ * @param workers number of concurrent workers
+ * @return std::vector<std::pair<P,P>> list of pairs, indicating the neighbouring relationship of two polygons
+ */
+template<IPolygon P>
+static std::vector<std::pair<P,P>> findNeighboursConcurrently(const std::vector<BoundingBoxPolygon<P>> & boundingBoxPolygons, const std::vector<size_t> & order, const std::vector<size_t> & rank, const PackedRTree<> & index,
+    util::BiPredicate<BoundingBoxPolygon<P>> auto const & neighbouringPredicate, size_t k, size_t workers) {
+    struct SlabResult {
+        std::vector<std::pair<P,P>> pairs;
+        std::vector<size_t> ends; // end of the pairs of each processed polygon
+    };
+    auto slab = xSlabs(boundingBoxPolygons,workers);
+    std::vector<std::vector<size_t>> slabs(workers);
+    for(size_t current: order) {
+        slabs[slab[current]].push_back(current);
+    }
+    std::vector<std::future<SlabResult>> futures;
+    futures.reserve(workers);
+    for(const auto & polygonsOfSlab: slabs) {
+        futures.push_back(std::async(std::launch::async,[&](){
+            SlabResult result;
+            result.ends.reserve(polygonsOfSlab.size());
+            for(size_t current : polygonsOfSlab) {
+                findNeighboursOf(current,boundingBoxPolygons,rank,index,neighbouringPredicate,k,result.pairs);
+                result.ends.push_back(result.pairs.size());
             }
-            skippedSameObject = true;
-            if(it == sls.begin())
-                break;
-        }
-        for(auto it = sls.upper_bound(this->obj); it != sls.end();++it){
-            const auto & neighbour = *(*it);
-            if(neighbouringPredicate(current,neighbour))
-                closestNeighbours.push(neighbour.getPolygon());
-                // output.push_back(std::make_pair(current.getPolygon(),neighbour.getPolygon()));
-        }
-        for(auto && neighbour: closestNeighbours) {
-            output.emplace_back(current.getPolygon(),std::move(neighbour));
-        }
-        sweepLine.removeSLS(this->obj);
+            return result;
+        }));
     }
-};
+    std::vector<SlabResult> results;
+    results.reserve(workers);
+    size_t totalSize = 0;
+    for(auto & future: futures) {
+        results.push_back(future.get());
+        totalSize += results.back().pairs.size();
+    }
+    std::vector<std::pair<P,P>> output;
+    output.reserve(totalSize);
+    std::vector<size_t> processed(workers,0); // number of polygons of each slab already merged
+    for(size_t current: order) {
+        auto & result = results[slab[current]];
+        auto & i = processed[slab[current]];
+        auto begin = i == 0 ? 0 : result.ends[i-1];
+        std::move(result.pairs.begin()+begin,result.pairs.begin()+result.ends[i],std::back_inserter(output));
+        ++i;
+    }
+    return output;
+}
 }
 /**
  * @brief Generic findNeighbouringPolygons function, which returns a list of pairs indicating the adjacencies of two polygons
+ * The bounding boxes produced by the wrapper are bulk-loaded into a packed R-tree. Only polygons with overlapping bounding boxes are tested with the predicate,
+ * hence the bounding box has to contain the whole neighbourhood of a polygon.
+ * Each polygon keeps at most k neighbours (closest first) among the polygons processed after itself (from top to bottom).
+ * With more than one worker, the polygons are split into vertical slabs searched concurrently; the output is identical to the sequential search.
  * 
  * @tparam R range type
  * @tparam P polygon type == value type of range
  * @param polygons range of polygons
- * @param neighbouringPredicate BiPredicate deciding whether two BoundingBoxPolygons are neighbours
- * @param wrapper unary function which wraps polygons of type P into BoundingBoxPolygons required for the sweepline
+ * @param neighbouringPredicate BiPredicate deciding whether two BoundingBoxPolygons are neighbours, has to be thread-safe when using multiple workers
+ * @param wrapper unary function which wraps polygons of type P into BoundingBoxPolygons used as keys of the R-tree
+ * @param k maximum number of neighbours per polygon
+ * @param workers number of concurrent workers (0 is treated as 1)
  * @return std::vector<std::pair<P,P>> list of pairs, indicating the neighbouring relationship of two polygons
  */
 template<PolygonRange R, IPolygon P = std::ranges::range_value_t<R>>
-static std::vector<std::pair<P,P>> findNeighbouringPolygonsTemplate(const R & polygons, util::BiPredicate<BoundingBoxPolygon<P>> auto const & neighbouringPredicate,util::UnaryFunction<P,BoundingBoxPolygon<P>> auto const & wrapper, size_t k) {
-    using SweepLine_t = typename __impl::PolygonNeighbours<P>;
-    SweepLine_t sweepLine;
+static std::vector<std::pair<P,P>> findNeighbouringPolygonsTemplate(const R & polygons, util::BiPredicate<BoundingBoxPolygon<P>> auto const & neighbouringPredicate,util::UnaryFunction<P,BoundingBoxPolygon<P>> auto const & wrapper, size_t k, size_t workers = 1) {
     std::vector<std::pair<P,P>> output;
     std::vector<BoundingBoxPolygon<P>> boundingBoxPolygons;
     boundingBoxPolygons.reserve(util::size(polygons));
     std::ranges::for_each(polygons,[&boundingBoxPolygons,&wrapper](const auto & p){
         boundingBoxPolygons.push_back(wrapper(p)); // wrap each polygon in a BoundingBoxPolygon
     });
-    std::ranges::for_each(boundingBoxPolygons,[&sweepLine,&neighbouringPredicate,k](const auto & bbPptr){
-        sweepLine.addEvent(std::make_unique<__impl::PolygonNeighboursInsertEvent<P>>(bbPptr)); // add insert events to sweepline
-        sweepLine.addEvent(std::make_unique<__impl::PolygonNeighboursRemoveEvent<P>>(bbPptr,neighbouringPredicate,k)); // add remove events to sweepline
-    });
-    return sweepLine.sweep(output);
+    const PackedRTree<> index {boundingBoxPolygons,[](const BoundingBoxPolygon<P> & bbp){return AABB(bbp.getBoundingBox());}};
+    auto order = __impl::neighbourSearchOrder(boundingBoxPolygons);
+    std::vector<size_t> rank(order.size());
+    for(size_t i = 0; i < order.size(); ++i) {
+        rank[order[i]] = i;
+    }
+    workers = std::clamp<size_t>(workers,1,std::max<size_t>(order.size(),1));
+    if(workers > 1)
+        return __impl::findNeighboursConcurrently(boundingBoxPolygons,order,rank,index,neighbouringPredicate,k,workers);
+    for(size_t current : order) {
+        __impl::findNeighboursOf(current,boundingBoxPolygons,rank,index,neighbouringPredicate,k,output);
+    }
+    return output;
 }
 
 
 
 /**
- * @brief Finding neighbours of polygons using a sweepline, returns a list of pairs indicating the adjacencies of two polygons
+ * @brief Finding neighbours of polygons using a packed R-tree, returns a list of pairs indicating the adjacencies of two polygons
  * 
  * @tparam R range type
  * @tparam P polygon type == value type of range
  * @param polygons range of polygons
  * @param neighbouringPredicate BiPredicate deciding whether two Polygons of type P are neighbours
- * @param wrapper unary function which wraps polygons of type P into BoundingBoxPolygons required for the sweepline
+ * @param wrapper unary function which wraps polygons of type P into BoundingBoxPolygons required for the R-tree
+ * @param k maximum number of neighbours per polygon
+ * @param workers number of concurrent workers
  * @return std::vector<std::pair<P,P>> list of pairs, indicating the neighbouring relationship of two polygons
  */
 template<PolygonRange R, IPolygon P = std::ranges::range_value_t<R>>
-static std::vector<std::pair<P,P>> findNeighbouringPolygons(const R & polygons, util::BiPredicate<P> auto  && neighbouringPredicate,util::UnaryFunction<P,BoundingBoxPolygon<P>> auto const & wrapper,size_t k) {
+static std::vector<std::pair<P,P>> findNeighbouringPolygons(const R & polygons, util::BiPredicate<P> auto  && neighbouringPredicate,util::UnaryFunction<P,BoundingBoxPolygon<P>> auto const & wrapper,size_t k, size_t workers = 1) {
     return findNeighbouringPolygonsTemplate(polygons, [&neighbouringPredicate](const BoundingBoxPolygon<P> & current, const BoundingBoxPolygon<P> & neighbour){
         return neighbouringPredicate(current.getPolygon(),neighbour.getPolygon());
-    },wrapper,k);
+    },wrapper,k,workers);
 }
 
 /**
@@ -130,11 +238,13 @@ static std::vector<std::pair<P,P>> findNeighbouringPolygons(const R & polygons,
  * @tparam P 
  * @param polygons 
  * @param neighbouringPredicate BiPredicate deciding whether two Polygons of type P are neighbours
+ * @param k maximum number of neighbours per polygon
+ * @param workers number of concurrent workers
  * @return std::vector<std::pair<P,P>> list of pairs, indicating the neighbouring relationship of two polygons
  */
 template<PolygonRange R, IPolygon P = std::ranges::range_value_t<R>>
-static std::vector<std::pair<P,P>> findNeighbouringPolygons(const R & polygons, util::BiPredicate<P> auto const & neighbouringPredicate,size_t k) {
-    return findNeighbouringPolygons(polygons,neighbouringPredicate,[](const P & p){return BoundingBoxPolygon(p);},k);
+static std::vector<std::pair<P,P>> findNeighbouringPolygons(const R & polygons, util::BiPredicate<P> auto const & neighbouringPredicate,size_t k, size_t workers = 1) {
+    return findNeighbouringPolygons(polygons,neighbouringPredicate,[](const P & p){return BoundingBoxPolygon(p);},k,workers);
 }
 
 /**
@@ -143,10 +253,12 @@ static std::vector<std::pair<P,P>> findNeighbouringPolygons(const R & polygons,
  * @tparam R 
  * @param polygons 
  * @param bufferMultiplier 
+ * @param k maximum number of neighbours per polygon
+ * @param workers number of concurrent workers
  * @return std::vector<std::pair<P,P>> list of pairs, indicating the neighbouring relationship of two polygons  
  */
 template<PolygonRange R>
-static std::vector<std::pair<std::ranges::range_value_t<R>,std::ranges::range_value_t<R>>> findNeighbouringPolygons(const R & polygons, fishnet::math::DEFAULT_NUMERIC bufferMultiplier, size_t k) {
+static std::vector<std::pair<std::ranges::range_value_t<R>,std::ranges::range_value_t<R>>> findNeighbouringPolygons(const R & polygons, fishnet::math::DEFAULT_NUMERIC bufferMultiplier, size_t k, size_t workers = 1) {
     if (bufferMultiplier <= 1)
         throw std::invalid_argument("Buffer range multiplier has to be greater than 1");
     using P = std::ranges::range_value_t<R>;
@@ -159,6 +271,6 @@ static std::vector<std::pair<std::ranges::range_value_t<R>,std::ranges::range_va
         auto aaBBRectangle = Rectangle<fishnet::math::DEFAULT_NUMERIC>(polygon);
         return BoundingBoxPolygon(polygon,aaBBRectangle.scale(bufferMultiplier));
     };
-    return findNeighbouringPolygonsTemplate(polygons, crossesOrContainedInBoundingBox,scaledWrapper,k);
+    return findNeighbouringPolygonsTemplate(polygons, crossesOrContainedInBoundingBox,scaledWrapper,k,workers);
 }
 }
@@ -1,4 +1,9 @@
 #pragma once
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <optional>
 
 #include <fishnet/Segment.hpp>
 #include <fishnet/InvalidGeometryException.hpp>
@@ -7,58 +12,243 @@
 
 namespace fishnet::geometry {
 
+namespace __impl {
+
 /**
- * @brief Decides whether a range of segments is a valid, closed polygonal ring
- * 
- * @tparam T numeric type of the segments
+ * @brief Decides whether two segments of a ring are in a forbidden relation:
+ * Segments must not intersect, unless the intersection is an endpoint of both segments.
+ * Consecutive segments of the ring and 0-length segments are not tested.
  * @param segments range of segments
- * @return true, segments form a valid polygonal ring
- * @return false, not a polygonal ring
+ * @param i index of the first segment
+ * @param j index of the second segment
+ * @return true, if the segments i and j intersect each other
  */
-template<fishnet::math::Number T>
-constexpr static bool isValidPolygonalRing(util::random_access_range_of<Segment<T>> auto const & segments) noexcept{
-    if (segments.size() < 3) 
-        return false; // a ring has to have at least three segments
+constexpr static bool segmentsIntersect(auto const & segments, size_t i, size_t j) noexcept {
+    if(i+1 == j || j+1 == i)
+        return false; // consecutive segments of the ring have to touch each other, which is tested separately
+    const auto & l = segments[i];
+    const auto & r = segments[j];
+    return l.intersects(r) and not l.touches(r);
+}
+
+/**
+ * @brief Brute-force test of all pairs of segments for self-intersections, O(n²)
+ *
+ * @param segments range of segments
+ * @return std::optional<std::pair<size_t,size_t>> indices of the first intersecting pair found, otherwise std::nullopt
+ */
+constexpr static std::optional<std::pair<size_t,size_t>> findIntersectingSegmentsBruteForce(auto const & segments) noexcept {
     for(size_t i = 0 ; i < segments.size();++i) {
-        auto l = segments[i];
-        if(not l.isValid()) 
+        if(not segments[i].isValid())
             continue; // 0-length segments get skipped
         for (size_t j = i+2; j< segments.size(); ++j){
-            auto r = segments[j];
-            if(not r.isValid()) 
+            if(not segments[j].isValid())
                 continue; // 0-length segments get skipped
-            if (l.intersects(r) and not l.touches(r)){
-                return false; // if segments intersect, and the intersection is not an endpoint of both segments, the ring is not valid (->Self-Intersection)
+            if (segmentsIntersect(segments,i,j))
+                return std::make_pair(i,j); // if segments intersect, and the intersection is not an endpoint of both segments, the ring is not valid (->Self-Intersection)
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Sweep line test for self-intersections of the segments (Shamos-Hoey), O(n log n):
+ * https://en.wikipedia.org/wiki/Sweep_line_algorithm
+ * The sweep moves from left to right (ties are broken bottom-up) and stores the active segments ordered by their y-coordinate at the position of the sweep line.
+ * Whenever two segments become neighbours in the sweep line status, they are tested for an intersection.
+ * Segments touching at their endpoints keep their relative order and are therefore allowed.
+ * At the same event point, segments are removed before new segments are inserted, so that segments ending and starting in the same point are never compared.
+ * @tparam T numeric type of the segments
+ * @param segments range of segments
+ * @return std::optional<std::pair<size_t,size_t>> indices of an intersecting pair, otherwise std::nullopt
+ */
+template<fishnet::math::Number T>
+static std::optional<std::pair<size_t,size_t>> findIntersectingSegmentsSweep(auto const & segments) {
+    using FLOAT_TYPE = fishnet::math::DEFAULT_FLOATING_POINT;
+    struct Event {
+        Vec2D<T> point;
+        bool insert;
+        size_t index;
+    };
+    const size_t n = segments.size();
+    auto lexicographicLess = [](const Vec2D<T> & lhs, const Vec2D<T> & rhs){
+        return lhs.x < rhs.x || (lhs.x == rhs.x && lhs.y < rhs.y);
+    };
+    std::vector<Vec2D<T>> left;
+    std::vector<Vec2D<T>> right;
+    left.reserve(n);
+    right.reserve(n);
+    std::vector<Event> events;
+    events.reserve(2*n);
+    for(size_t i = 0; i < n; ++i){
+        const auto & s = segments[i];
+        bool pIsLeft = lexicographicLess(s.p(),s.q());
+        left.push_back(pIsLeft ? s.p() : s.q());
+        right.push_back(pIsLeft ? s.q() : s.p());
+        if(not s.isValid())
+            continue; // 0-length segments get skipped
+        events.push_back(Event{left[i],true,i});
+        events.push_back(Event{right[i],false,i});
+    }
+    std::ranges::sort(events,[&lexicographicLess](const Event & lhs, const Event & rhs){
+        if(lexicographicLess(lhs.point,rhs.point))
+            return true;
+        if(lexicographicLess(rhs.point,lhs.point))
+            return false;
+        return not lhs.insert && rhs.insert; // remove events first
+    });
+
+    Vec2D<T> sweepPoint;
+    auto yAtSweepLine = [&](size_t i) -> FLOAT_TYPE {
+        const auto & l = left[i];
+        const auto & r = right[i];
+        if(l.x == r.x) // vertical segment: clamp to the current event point
+            return std::clamp<FLOAT_TYPE>(sweepPoint.y,l.y,r.y);
+        if(sweepPoint.x <= l.x)
+            return l.y;
+        if(sweepPoint.x >= r.x)
+            return r.y;
+        return l.y + FLOAT_TYPE(sweepPoint.x - l.x) * FLOAT_TYPE(r.y - l.y) / FLOAT_TYPE(r.x - l.x);
+    };
+    auto slope = [&](size_t i) -> FLOAT_TYPE {
+        const auto & l = left[i];
+        const auto & r = right[i];
+        if(l.x == r.x)
+            return std::numeric_limits<FLOAT_TYPE>::infinity();
+        return FLOAT_TYPE(r.y - l.y) / FLOAT_TYPE(r.x - l.x);
+    };
+    auto below = [&](size_t lhs, size_t rhs){
+        if(lhs == rhs)
+            return false;
+        auto yLhs = yAtSweepLine(lhs);
+        auto yRhs = yAtSweepLine(rhs);
+        if(not fishnet::math::areEqual(yLhs,yRhs))
+            return yLhs < yRhs;
+        auto slopeLhs = slope(lhs);
+        auto slopeRhs = slope(rhs);
+        if(slopeLhs != slopeRhs)
+            return slopeLhs < slopeRhs; // segments meeting at the sweep line are ordered by their direction to the right
+        return lhs < rhs;
+    };
+    using SLS = std::set<size_t,decltype(below)>;
+    SLS sls {below};
+    std::vector<typename SLS::iterator> handles(n,sls.end());
+    auto intersect = [&segments](size_t i, size_t j) -> std::optional<std::pair<size_t,size_t>> {
+        if(segmentsIntersect(segments,i,j))
+            return std::make_pair(std::min(i,j),std::max(i,j));
+        return std::nullopt;
+    };
+    auto passesEventPoint = [&](size_t i){
+        return fishnet::math::areEqual(yAtSweepLine(i),FLOAT_TYPE(sweepPoint.y));
+    };
+    /* 
+     * Test the segment against its neighbours below and above, including all segments passing through the event point:
+     * Collinear overlapping segments are not considered intersecting, but might hide an intersection in the event point from the sweep line otherwise
+     */
+    auto intersectNeighbours = [&](typename SLS::iterator it) -> std::optional<std::pair<size_t,size_t>> {
+        for(auto below = it; below != sls.begin();){
+            --below;
+            if(auto pair = intersect(*below,*it))
+                return pair;
+            if(not passesEventPoint(*below))
+                break;
+        }
+        for(auto above = std::next(it); above != sls.end(); ++above){
+            if(auto pair = intersect(*it,*above))
+                return pair;
+            if(not passesEventPoint(*above))
+                break;
+        }
+        return std::nullopt;
+    };
+    for(const auto & event : events){
+        if(event.insert){
+            sweepPoint = event.point;
+            auto it = sls.insert(event.index).first;
+            handles[event.index] = it;
+            if(auto pair = intersectNeighbours(it))
+                return pair;
+        }else {
+            sweepPoint = event.point;
+            auto it = handles[event.index];
+            if(auto pair = intersectNeighbours(it))
+                return pair;
+            auto next = std::next(it);
+            bool hasPrevious = it != sls.begin();
+            auto previous = hasPrevious ? std::prev(it) : sls.end();
+            sls.erase(it); // erase by iterator, no comparisons required
+            if(hasPrevious && next != sls.end()){
+                if(auto pair = intersect(*previous,*next))
+                    return pair;
             }
         }
-        if(not segments[i].touches(segments[(i+1)%segments.size()])) 
-            return false; // adjacent segments have to touch each other (-> Closed Ring)
     }
-    return true;
+    return std::nullopt;
+}
+
+/**
+ * @brief Finds any pair of segments intersecting each other, using brute-force for small rings and the sweep line otherwise
+ *
+ * @tparam T numeric type of the segments
+ * @param segments range of segments
+ * @return std::optional<std::pair<size_t,size_t>> indices of an intersecting pair, otherwise std::nullopt
+ */
+template<fishnet::math::Number T>
+static std::optional<std::pair<size_t,size_t>> findIntersectingSegments(auto const & segments) {
+    constexpr static size_t SWEEP_LINE_THRESHOLD = 64;
+    if(segments.size() < SWEEP_LINE_THRESHOLD)
+        return findIntersectingSegmentsBruteForce(segments);
+    return findIntersectingSegmentsSweep<T>(segments);
+}
+
+/**
+ * @brief Finds the first segment which does not touch its successor in the ring
+ *
+ * @param segments range of segments
+ * @return std::optional<size_t> index of the segment, otherwise std::nullopt
+ */
+constexpr static std::optional<size_t> findOpenSegment(auto const & segments) noexcept {
+    for(size_t i = 0 ; i < segments.size();++i) {
+        if(not segments[i].touches(segments[(i+1)%segments.size()]))
+            return i; // adjacent segments have to touch each other (-> Closed Ring)
+    }
+    return std::nullopt;
+}
+}
+
+/**
+ * @brief Decides whether a range of segments is a valid, closed polygonal ring
+ *
+ * @tparam T numeric type of the segments
+ * @param segments range of segments
+ * @return true, segments form a valid polygonal ring
+ * @return false, not a polygonal ring
+ */
+template<fishnet::math::Number T>
+constexpr static bool isValidPolygonalRing(util::random_access_range_of<Segment<T>> auto const & segments) noexcept{
+    if (segments.size() < 3)
+        return false; // a ring has to have at least three segments
+    return not __impl::findOpenSegment(segments) && not __impl::findIntersectingSegments<T>(segments);
 }
 
 /**
  * @brief Verify a range segments is a valid, closed polygonal ring
- * 
+ *
  * @tparam T numeric type of the segments
  * @param segments range of segments
  * @throws InvalidGeometryException when the segments do not form a valid polygonal ring
  */
 template<fishnet::math::Number T>
 constexpr static void verifyPolygonalRing(util::random_access_range_of<Segment<T>> auto const & segments) {
-    if (segments.size() < 3) 
+    if (segments.size() < 3)
         throw InvalidGeometryException("Ring has to contain at least three Segments");
-    for(size_t i = 0 ; i < segments.size();++i) {
-        auto l = segments[i];
-        if(not l.isValid()) continue;
-        for (size_t j = i+2; j< segments.size(); ++j){
-            auto r = segments[j];
-            if(not r.isValid()) continue;
-            if (l.intersects(r) and not l.touches(r))
-                throw InvalidGeometryException("Ring Segments intersect each other: \n"+l.toString()+" intersects "+r.toString());
-        }
-        if(not segments[i].touches(segments[(i+1)%segments.size()])) 
-            throw InvalidGeometryException("Adjacent Segments of Ring do not touch at endpoints: \n"+segments[i].toString()+" does not touch "+segments[(i+1)%segments.size()].toString());
+    if(auto open = __impl::findOpenSegment(segments)){
+        auto i = open.value();
+        throw InvalidGeometryException("Adjacent Segments of Ring do not touch at endpoints: \n"+segments[i].toString()+" does not touch "+segments[(i+1)%segments.size()].toString());
+    }
+    if(auto intersecting = __impl::findIntersectingSegments<T>(segments)){
+        const auto & [i,j] = intersecting.value();
+        throw InvalidGeometryException("Ring Segments intersect each other: \n"+segments[i].toString()+" intersects "+segments[j].toString());
     }
 }
 
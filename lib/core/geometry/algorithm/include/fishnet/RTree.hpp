@@ -0,0 +1,212 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <stdexcept>
+#include <fishnet/NumericConcepts.hpp>
+#include <fishnet/CollectionConcepts.hpp>
+#include <fishnet/FunctionalConcepts.hpp>
+#include <fishnet/AABB.hpp>
+
+namespace fishnet::geometry {
+
+/**
+ * @brief Static R-tree over axis-aligned boxes, bulk-loaded with the Sort-Tile-Recursive (STR) packing algorithm:
+ * https://en.wikipedia.org/wiki/R-tree#Packing/bulk-loading
+ * Entries are identified by their index in the input range. The tree is immutable after construction and
+ * all nodes are stored level-wise in contiguous vectors, such that a query does not allocate per node.
+ * Query complexity is O(log_M(n) + number of results), construction O(n log n).
+ * @tparam T numeric type of the boxes
+ * @tparam M maximum number of children per node
+ */
+template<fishnet::math::Number T = fishnet::math::DEFAULT_NUMERIC, size_t M = 16>
+class PackedRTree {
+    static_assert(M >= 2, "R-tree nodes require at least two children");
+public:
+    using Box = AABB<T>;
+private:
+    /**
+     * @brief Node of the tree, storing the range [begin,end) of its children on the level below
+     * On the leaf level the children are entries.
+     */
+    struct Node {
+        Box box;
+        size_t begin;
+        size_t end;
+    };
+
+    std::vector<Box> entries; // entry boxes in packed order
+    std::vector<size_t> ids; // index of the entry in the input range, in packed order
+    std::vector<std::vector<Node>> levels; // levels[0] are the leaves, levels.back() the root level
+
+    /**
+     * @brief Sorts the items in-place into STR order:
+     * Vertical slices by x-center of the boxes, each slice sorted by the y-center
+     * @param items range of items to be sorted
+     * @param boxOf unary function mapping an item to its box
+     */
+    template<typename I>
+    static void strSort(std::vector<I> & items, auto const & boxOf) {
+        if(items.size() <= M)
+            return;
+        const size_t nodeCount = (items.size() + M - 1) / M;
+        const size_t sliceCount = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(nodeCount))));
+        const size_t sliceSize = sliceCount * M;
+        std::ranges::sort(items,[&boxOf](const I & lhs, const I & rhs){
+            return boxOf(lhs).centerX() < boxOf(rhs).centerX();
+        });
+        for(size_t begin = 0; begin < items.size(); begin += sliceSize) {
+            auto end = std::min(begin+sliceSize,items.size());
+            std::sort(items.begin()+begin, items.begin()+end,[&boxOf](const I & lhs, const I & rhs){
+                return boxOf(lhs).centerY() < boxOf(rhs).centerY();
+            });
+        }
+    }
+
+    /**
+     * @brief Groups consecutive runs of M boxes into parent nodes
+     *
+     * @param count number of children
+     * @param boxOf function mapping a child index to its box
+     * @return std::vector<Node> parent nodes
+     */
+    static std::vector<Node> pack(size_t count, auto const & boxOf) {
+        std::vector<Node> parents;
+        parents.reserve((count + M - 1) / M);
+        for(size_t begin = 0; begin < count; begin += M) {
+            Node node {boxOf(begin),begin,std::min(begin+M,count)};
+            for(size_t i = begin+1; i < node.end; ++i) {
+                node.box.merge(boxOf(i));
+            }
+            parents.push_back(node);
+        }
+        return parents;
+    }
+
+    void build(std::vector<Box> && boxes) {
+        std::vector<size_t> order(boxes.size());
+        std::iota(order.begin(),order.end(),0);
+        strSort(order,[&boxes](size_t i) -> const Box & {return boxes[i];});
+        entries.reserve(boxes.size());
+        ids = std::move(order);
+        for(auto id: ids) {
+            entries.push_back(boxes[id]);
+        }
+        if(entries.empty())
+            return;
+        levels.push_back(pack(entries.size(),[this](size_t i) -> const Box &{return entries[i];}));
+        while(levels.back().size() > 1) {
+            auto & current = levels.back();
+            strSort(current,[](const Node & node) -> const Box & {return node.box;});
+            auto parents = pack(current.size(),[&current](size_t i) -> const Box &{return current[i].box;});
+            levels.push_back(std::move(parents));
+        }
+    }
+
+public:
+    PackedRTree() = default;
+
+    /**
+     * @brief Bulk-load the tree from a vector of boxes. The id of each entry is its index in the vector.
+     *
+     * @param boxes
+     */
+    explicit PackedRTree(std::vector<Box> boxes) {
+        build(std::move(boxes));
+    }
+
+    /**
+     * @brief Bulk-load the tree from a range of elements, which are mapped to their boxes
+     *
+     * @param elements range of elements
+     * @param boxMapper unary function from an element to its box
+     */
+    PackedRTree(std::ranges::forward_range auto const & elements, auto const & boxMapper) {
+        std::vector<Box> boxes;
+        boxes.reserve(util::size(elements));
+        for(const auto & element: elements) {
+            boxes.push_back(static_cast<Box>(boxMapper(element)));
+        }
+        build(std::move(boxes));
+    }
+
+    size_t size() const noexcept {
+        return entries.size();
+    }
+
+    bool empty() const noexcept {
+        return entries.empty();
+    }
+
+    /**
+     * @brief Height of the tree (number of node levels), 0 for an empty tree
+     *
+     * @return size_t
+     */
+    size_t height() const noexcept {
+        return levels.size();
+    }
+
+    /**
+     * @brief Get the bounding box of all entries
+     *
+     * @return const Box&
+     * @throws std::out_of_range when the tree is empty
+     */
+    const Box & bounds() const {
+        if(levels.empty())
+            throw std::out_of_range("Empty R-tree has no bounds");
+        return levels.back().front().box;
+    }
+
+    /**
+     * @brief Visit the ids of all entries, whose box overlaps the query box
+     * The order of the visited entries is determined by the packing and not by the input order.
+     * @param query box
+     * @param visitor unary function called with the id of every overlapping entry
+     */
+    void query(const Box & query, util::Consumer<size_t> auto && visitor) const {
+        if(levels.empty())
+            return;
+        struct StackEntry {
+            size_t level;
+            size_t begin;
+            size_t end;
+        };
+        std::vector<StackEntry> stack;
+        stack.reserve(levels.size() * M);
+        stack.push_back({levels.size()-1,0,levels.back().size()});
+        while(not stack.empty()) {
+            auto [level,begin,end] = stack.back();
+            stack.pop_back();
+            const auto & nodes = levels[level];
+            for(size_t i = begin; i < end; ++i) {
+                const Node & node = nodes[i];
+                if(not node.box.overlap(query))
+                    continue;
+                if(level > 0) {
+                    stack.push_back({level-1,node.begin,node.end});
+                    continue;
+                }
+                for(size_t e = node.begin; e < node.end; ++e) {
+                    if(entries[e].overlap(query))
+                        visitor(ids[e]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Collect the ids of all entries, whose box overlaps the query box
+     *
+     * @param query box
+     * @return std::vector<size_t> ids of the overlapping entries
+     */
+    std::vector<size_t> query(const Box & query) const {
+        std::vector<size_t> result;
+        this->query(query,[&result](size_t id){result.push_back(id);});
+        return result;
+    }
+};
+}
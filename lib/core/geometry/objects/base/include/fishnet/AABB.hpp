@@ -0,0 +1,61 @@
+#pragma once
+#include <algorithm>
+#include <fishnet/NumericConcepts.hpp>
+
+namespace fishnet::geometry {
+
+template<fishnet::math::Number T>
+class Rectangle;
+
+/**
+ * @brief Lightweight axis-aligned bounding box
+ * In contrast to the Rectangle, no segments are stored, only the extreme coordinates.
+ * Used as cached extent of shapes and as key for the spatial index structures.
+ * @tparam T numeric type of the coordinates
+ */
+template<fishnet::math::Number T = fishnet::math::DEFAULT_NUMERIC>
+struct AABB {
+    T left;
+    T top;
+    T right;
+    T bottom;
+
+    constexpr AABB() noexcept:left(0),top(0),right(0),bottom(0){}
+
+    constexpr AABB(T left, T top, T right, T bottom) noexcept:left(left),top(top),right(right),bottom(bottom){}
+
+    template<fishnet::math::Number U>
+    constexpr AABB(const Rectangle<U> & rectangle) noexcept:left(rectangle.left()),top(rectangle.top()),right(rectangle.right()),bottom(rectangle.bottom()){}
+
+    /**
+     * @brief Closed intersection test (touching boxes overlap)
+     *
+     * @param other box
+     * @return true, if the boxes share at least one point
+     */
+    constexpr bool overlap(const AABB<T> & other) const noexcept {
+        return not (right < other.left || left > other.right || top < other.bottom || bottom > other.top);
+    }
+
+    constexpr bool contains(const AABB<T> & other) const noexcept {
+        return left <= other.left && right >= other.right && top >= other.top && bottom <= other.bottom;
+    }
+
+    constexpr void merge(const AABB<T> & other) noexcept {
+        left = std::min(left,other.left);
+        top = std::max(top,other.top);
+        right = std::max(right,other.right);
+        bottom = std::min(bottom,other.bottom);
+    }
+
+    constexpr fishnet::math::DEFAULT_FLOATING_POINT centerX() const noexcept {
+        return (static_cast<fishnet::math::DEFAULT_FLOATING_POINT>(left) + right) / 2.0;
+    }
+
+    constexpr fishnet::math::DEFAULT_FLOATING_POINT centerY() const noexcept {
+        return (static_cast<fishnet::math::DEFAULT_FLOATING_POINT>(top) + bottom) / 2.0;
+    }
+
+    constexpr bool operator==(const AABB<T> & other) const noexcept = default;
+};
+}
@@ -15,6 +15,9 @@ template<fishnet::math::Number T>
 class Polygon : public SimplePolygon<T>{
 private:
     std::vector<Ring<T>> holes;
+    /* Geometric invariants, computed once on construction */
+    fishnet::math::DEFAULT_FLOATING_POINT cachedArea = 0;
+    Vec2DReal cachedCentroid;
 
     /**
      * @brief Helper method to adapt point location queries to holes
@@ -40,6 +43,33 @@ private:
         return rings;
     }
 
+    void verifyHoles() const {
+        const auto & boundary = this->getBoundary();
+        if (std::ranges::any_of(holes, [&boundary](const auto & hole){return not boundary.contains(hole);}))
+            throw InvalidGeometryException("Hole not contained within Boundary of Polygon");
+        if (std::ranges::any_of(holes, [this](const auto & h1){
+            return std::ranges::any_of(holes, [&h1](const auto & h2){
+                return h1.crosses(h2);
+            });
+        })) throw InvalidGeometryException("Holes of Polygon are intersecting each other");
+    }
+
+    /**
+     * @brief Computes the area and the weighted centroid of the polygon from the precomputed values of its rings
+     * https://en.wikipedia.org/wiki/Centroid
+     */
+    constexpr void initInvariants() noexcept {
+        auto totalAreaIncludingHoles = this->getBoundary().area();
+        auto accCentroid = this->getBoundary().centroid() * totalAreaIncludingHoles;
+        auto accArea = totalAreaIncludingHoles;
+        for(const auto & hole: this->holes){
+            accCentroid = accCentroid + hole.centroid() * -hole.area();
+            accArea -= hole.area();
+        }
+        cachedArea = accArea; // subtract accumulated area of holes from the area contained within the boundary
+        cachedCentroid = accCentroid / accArea; // -> weighted centroid by decomposition
+    }
+
 public:
     using numeric_type = T;
     constexpr static GeometryType type = GeometryType::POLYGON;
@@ -51,15 +81,25 @@ public:
      * @param holes 
      */
     Polygon(const Ring<T> & boundary, const std::vector<Ring<T>> & holes = {}):SimplePolygon<T>(boundary),holes(holes){
-        if (std::ranges::any_of(holes, [&boundary](const auto & hole){return not boundary.contains(hole);}))
-            throw InvalidGeometryException("Hole not contained within Boundary of Polygon");
-        if (std::ranges::any_of(holes, [&boundary,&holes](const auto & h1){
-            return std::ranges::any_of(holes, [&boundary,&h1](const auto & h2){
-                return h1.crosses(h2);
-            });
-        })) throw InvalidGeometryException("Holes of Polygon are intersecting each other");
+        verifyHoles();
+        initInvariants();
     };
 
+    /**
+     * @brief Construct a new Polygon object using boundary and holes
+     * 
+     * @param boundary 
+     * @param holes 
+     * @param checked if true, no checks are applied, potentially speeding up the construction.
+     * Only use for rings known to form a valid polygon, e.g. read from a GeometryCache
+     * @throws InvalidGeometryException if the holes are not contained in the boundary or intersect each other
+     */
+    Polygon(const Ring<T> & boundary, std::vector<Ring<T>> && holes, bool checked):SimplePolygon<T>(boundary),holes(std::move(holes)){
+        if(not checked)
+            verifyHoles();
+        initInvariants();
+    }
+
     Polygon(const Ring<T> & boundary, const util::forward_range_of<Ring<T>> auto & holes):Polygon(boundary,std::move(copyRings(holes))) {}
 
     Polygon(const SimplePolygon<T> & boundary, const std::vector<Ring<T>> & holes = {}):Polygon(boundary.getBoundary(),holes){}
@@ -88,32 +128,21 @@ public:
     }
 
     /**
-     * @brief Calculate the area of the polygon
-     * Subtract accumulated area of holes from the area contained within the boundary
+     * @brief Get the area of the polygon, precomputed on construction
+     * Accumulated area of holes is subtracted from the area contained within the boundary
      * @return constexpr fishnet::math::DEFAULT_FLOATING_POINT 
      */
     constexpr fishnet::math::DEFAULT_FLOATING_POINT area() const noexcept {
-        fishnet::math::DEFAULT_FLOATING_POINT area = this->getBoundary().area();
-        for(const auto & hole : holes) {
-            area -= hole.area();
-        }
-        return area;
+        return cachedArea;
     }
 
     /**
-     * @brief Calculate weighted centroid of the polygon
+     * @brief Get the weighted centroid of the polygon, precomputed on construction
      * https://en.wikipedia.org/wiki/Centroid
      * @return constexpr Vec2DReal 
      */
     constexpr Vec2DReal centroid() const noexcept {
-        auto totalAreaIncludingHoles = this->getBoundary().area();
-        auto accCentroid = this->getBoundary().centroid() * totalAreaIncludingHoles;
-        auto accArea = totalAreaIncludingHoles;
-        for(const auto & hole: this->getHoles()){
-            accCentroid = accCentroid + hole.centroid() * -hole.area();
-            accArea -= hole.area();
-        }
-        return accCentroid / accArea; // -> weighted centroid by decomposition
+        return cachedCentroid;
     }
 
     constexpr bool inline contains(IPoint auto const & point) const noexcept {
@@ -0,0 +1,394 @@
+#pragma once
+#include <vector>
+#include <ranges>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <numeric>
+
+#include <fishnet/Segment.hpp>
+#include <fishnet/Ray.hpp>
+#include <fishnet/AABB.hpp>
+#include <fishnet/ShapeGeometry.hpp>
+#include <fishnet/RingPrimitives.hpp>
+#include <fishnet/Constants.hpp>
+
+namespace fishnet::geometry{
+
+/**
+ * @brief Point location index over a ring, for many queries against the same (large) ring, e.g. the boundary of an enclosing polygon.
+ * The segments are distributed into horizontal slabs of equal height (y-bucketed edge table), a query only tests the segments of the slab containing the point.
+ * Inside a slab the segments are sorted by their right-most x-coordinate, so that segments to the left of the point, which can neither contain the point nor cross the ray to the right, are skipped.
+ * The remaining candidates are tested with the same ray casting step as Ring::getPointLocation(), hence the results (including points on the boundary and the tolerance of the fuzzy comparisons) are identical to the ring.
+ * Intersection and containment tests of segments only test the segments of the slabs overlapping the y-range of the segment.
+ * The bounds of each segment are widened by a tolerance, which covers the epsilon of the fuzzy comparisons.
+ * The index stores copies of the segments and is independent of the lifetime of the ring.
+ * @tparam T numeric type used for computations
+ */
+template<fishnet::math::Number T>
+class PreparedRing{
+private:
+    using FLOAT_TYPE = fishnet::math::DEFAULT_FLOATING_POINT;
+    constexpr static size_t MAX_ENTRIES_PER_SEGMENT = 4;
+
+    /* entries, grouped by slab and sorted in descending order of highX in each slab */
+    std::vector<Segment<T>> segments;
+    std::vector<size_t> ids; // index of the segment in the ring
+    std::vector<FLOAT_TYPE> lowY;
+    std::vector<FLOAT_TYPE> highY;
+    std::vector<FLOAT_TYPE> highX;
+    std::vector<size_t> offsets; // slab -> first entry, size = #slabs + 1
+    std::vector<size_t> firstSlabs; // segment in the ring -> first slab of the segment
+    std::vector<Segment<T>> ringSegments; // segments in the order of the ring
+    AABB<T> boundingBox;
+    FLOAT_TYPE tolerance = 0;
+    FLOAT_TYPE minY = 0;
+    FLOAT_TYPE maxY = 0;
+    FLOAT_TYPE slabHeight = 1;
+
+    size_t slabCount() const noexcept {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    size_t slabOf(FLOAT_TYPE y) const noexcept {
+        FLOAT_TYPE slab = std::floor((y - minY) / slabHeight);
+        if(not (slab > 0)) // also catches NaN
+            return 0;
+        return std::min(static_cast<size_t>(slab),slabCount()-1);
+    }
+
+    static FLOAT_TYPE toleranceOf(FLOAT_TYPE extent, FLOAT_TYPE magnitude) noexcept {
+        return 4 * fishnet::math::EPSILON * (1 + extent) + 16 * std::numeric_limits<FLOAT_TYPE>::epsilon() * magnitude;
+    }
+
+    bool rejects(IPoint auto const & point) const noexcept {
+        return segments.empty() || point.y < minY || point.y > maxY || point.x > boundingBox.right + tolerance;
+    }
+
+    /**
+     * @brief Calls f(entry) once for each entry, whose widened y-range overlaps [low,high] and which reaches the x-coordinate left
+     */
+    template<typename F>
+    void forEachEntry(FLOAT_TYPE low, FLOAT_TYPE high, FLOAT_TYPE left, F && f) const {
+        if(segments.empty() || high < minY || low > maxY)
+            return;
+        size_t firstSlab = slabOf(low);
+        size_t lastSlab = slabOf(high);
+        for(size_t slab = firstSlab; slab <= lastSlab; ++slab) {
+            for(size_t i = offsets[slab]; i < offsets[slab+1] && highX[i] >= left; ++i) {
+                if(std::max(firstSlabs[ids[i]],firstSlab) != slab)
+                    continue; // segment spans multiple slabs and was already visited in a previous slab
+                if(lowY[i] <= high && highY[i] >= low)
+                    f(i);
+            }
+        }
+    }
+
+    /**
+     * @brief Calls f(entry) once for each entry, whose widened bounds overlap the bounds of the segment, widened by the tolerance of the segment
+     */
+    template<typename F>
+    void forEachCandidate(ISegment auto const & segment, F && f) const {
+        const auto & p = segment.p();
+        const auto & q = segment.q();
+        FLOAT_TYPE magnitude = std::max({std::fabs(FLOAT_TYPE(p.x)),std::fabs(FLOAT_TYPE(p.y)),std::fabs(FLOAT_TYPE(q.x)),std::fabs(FLOAT_TYPE(q.y))});
+        FLOAT_TYPE segmentTolerance = toleranceOf(std::fabs(FLOAT_TYPE(q.x - p.x)) + std::fabs(FLOAT_TYPE(q.y - p.y)),magnitude);
+        FLOAT_TYPE low = std::min(FLOAT_TYPE(p.y),FLOAT_TYPE(q.y));
+        FLOAT_TYPE high = std::max(FLOAT_TYPE(p.y),FLOAT_TYPE(q.y));
+        FLOAT_TYPE left = std::min(FLOAT_TYPE(p.x),FLOAT_TYPE(q.x)) - segmentTolerance;
+        forEachEntry(low - segmentTolerance,high + segmentTolerance,left,std::forward<F>(f));
+    }
+
+public:
+    using numeric_type = T;
+
+    /**
+     * @brief Build the index over the segments of a ring
+     *
+     * @param ring ring
+     */
+    PreparedRing(const IRing<T> auto & ring){
+        for(const auto & s: ring.getSegments()) {
+            ringSegments.push_back(s);
+        }
+        const size_t n = ringSegments.size();
+        if(n == 0)
+            return;
+        const auto & first = ringSegments.front().p();
+        boundingBox = AABB<T>(first.x,first.y,first.x,first.y);
+        for(const auto & s: ringSegments) {
+            boundingBox.merge(AABB<T>(s.p().x,s.p().y,s.p().x,s.p().y));
+        }
+        const auto & box = boundingBox;
+        FLOAT_TYPE magnitude = std::max({std::fabs(FLOAT_TYPE(box.left)),std::fabs(FLOAT_TYPE(box.right)),std::fabs(FLOAT_TYPE(box.top)),std::fabs(FLOAT_TYPE(box.bottom))});
+        tolerance = toleranceOf(FLOAT_TYPE(box.right - box.left) + FLOAT_TYPE(box.top - box.bottom),magnitude);
+        if constexpr(std::integral<T>)
+            tolerance += 1; // the origin of the ray is truncated to integer coordinates
+        minY = box.bottom - tolerance;
+        maxY = box.top + tolerance;
+        std::vector<std::pair<FLOAT_TYPE,FLOAT_TYPE>> yRanges;
+        yRanges.reserve(n);
+        for(const auto & s: ringSegments) {
+            FLOAT_TYPE py = s.p().y, qy = s.q().y;
+            yRanges.emplace_back(std::min(py,qy) - tolerance, std::max(py,qy) + tolerance);
+        }
+        // start with one slab per segment, halve the number of slabs while long segments are copied into too many slabs
+        size_t count = n;
+        while(true) {
+            offsets.assign(count+1,0);
+            slabHeight = (maxY - minY) / FLOAT_TYPE(count);
+            if(not (slabHeight > 0))
+                slabHeight = 1;
+            size_t entries = 0;
+            for(const auto & [low,high]: yRanges) {
+                entries += slabOf(high) - slabOf(low) + 1;
+            }
+            if(count == 1 || entries <= MAX_ENTRIES_PER_SEGMENT * n)
+                break;
+            count /= 2;
+        }
+        firstSlabs.resize(n);
+        for(size_t id = 0; id < n; ++id) {
+            firstSlabs[id] = slabOf(yRanges[id].first);
+            for(size_t slab = firstSlabs[id]; slab <= slabOf(yRanges[id].second); ++slab) {
+                offsets[slab+1]++;
+            }
+        }
+        std::partial_sum(offsets.begin(),offsets.end(),offsets.begin());
+        std::vector<size_t> order(offsets.back());
+        std::vector<size_t> fill(offsets.begin(),offsets.end()-1);
+        for(size_t id = 0; id < n; ++id) {
+            for(size_t slab = firstSlabs[id]; slab <= slabOf(yRanges[id].second); ++slab) {
+                order[fill[slab]++] = id;
+            }
+        }
+        std::vector<FLOAT_TYPE> rightX(n);
+        for(size_t id = 0; id < n; ++id) {
+            const auto & s = ringSegments[id];
+            rightX[id] = std::max(FLOAT_TYPE(s.p().x),FLOAT_TYPE(s.q().x)) + tolerance;
+        }
+        for(size_t slab = 0; slab < slabCount(); ++slab) {
+            std::sort(order.begin()+offsets[slab],order.begin()+offsets[slab+1],[&rightX](size_t lhs, size_t rhs){
+                return rightX[lhs] > rightX[rhs];
+            });
+        }
+        segments.reserve(order.size());
+        ids = std::move(order);
+        for(size_t id: ids) {
+            segments.push_back(ringSegments[id]);
+            lowY.push_back(yRanges[id].first);
+            highY.push_back(yRanges[id].second);
+            highX.push_back(rightX[id]);
+        }
+    }
+
+    constexpr const AABB<T> & getBoundingBox() const noexcept {
+        return boundingBox;
+    }
+
+    /**
+     * @brief Get the location of a point with regard to the ring (INSIDE | OUTSIDE | BOUNDARY), equal to the location computed by the ring
+     *
+     * @param point
+     * @return PointLocation
+     */
+    PointLocation getPointLocation(IPoint auto const & point) const noexcept {
+        if(rejects(point))
+            return PointLocation::OUTSIDE;
+        size_t intersectionCounter = 0;
+        Ray<T> horizontalRay = Ray<T>::right(point);
+        size_t slab = slabOf(point.y);
+        for(size_t i = offsets[slab]; i < offsets[slab+1] && highX[i] >= point.x; ++i) {
+            if(point.y < lowY[i] || point.y > highY[i])
+                continue;
+            switch(__impl::rayCrossing(segments[i],point,horizontalRay)){
+                case __impl::RayCrossing::BOUNDARY:
+                    return PointLocation::BOUNDARY;
+                case __impl::RayCrossing::CROSSING:
+                    ++intersectionCounter;
+                    break;
+                case __impl::RayCrossing::NONE:
+                    break;
+            }
+        }
+        return intersectionCounter%2 == 1 ? PointLocation::INSIDE : PointLocation::OUTSIDE;
+    }
+
+    /**
+     * @brief Locates many points at once.
+     * The points are grouped by slab, then each segment of a slab is compared against the coordinates of all points of the slab in a branch-free loop over contiguous arrays, which the compiler vectorizes.
+     * Only the points passing this bounds test are passed to the exact ray casting step.
+     *
+     * @param points range of points
+     * @return std::vector<PointLocation> location of each point, in the order of the range
+     */
+    template<std::ranges::forward_range R>
+    requires IPoint<std::ranges::range_value_t<R>>
+    std::vector<PointLocation> locate(const R & points) const {
+        using P = std::ranges::range_value_t<R>;
+        std::vector<P> queries(std::ranges::begin(points),std::ranges::end(points));
+        std::vector<PointLocation> result(queries.size(),PointLocation::OUTSIDE);
+        const size_t slabs = slabCount();
+        if(slabs == 0)
+            return result;
+        // counting sort of the point indices by slab, rejected points are skipped
+        std::vector<size_t> slabOffsets(slabs+1,0);
+        std::vector<size_t> slabOfQuery(queries.size(),slabs);
+        for(size_t j = 0; j < queries.size(); ++j) {
+            if(rejects(queries[j]))
+                continue;
+            slabOfQuery[j] = slabOf(queries[j].y);
+            slabOffsets[slabOfQuery[j]+1]++;
+        }
+        std::partial_sum(slabOffsets.begin(),slabOffsets.end(),slabOffsets.begin());
+        std::vector<size_t> order(slabOffsets.back());
+        std::vector<size_t> fill(slabOffsets.begin(),slabOffsets.end()-1);
+        for(size_t j = 0; j < queries.size(); ++j) {
+            if(slabOfQuery[j] != slabs)
+                order[fill[slabOfQuery[j]]++] = j;
+        }
+        std::vector<FLOAT_TYPE> xs, ys;
+        std::vector<unsigned char> candidates, boundary;
+        std::vector<size_t> crossings;
+        for(size_t slab = 0; slab < slabs; ++slab) {
+            const size_t first = slabOffsets[slab];
+            const size_t m = slabOffsets[slab+1] - first;
+            if(m == 0)
+                continue;
+            xs.resize(m);
+            ys.resize(m);
+            for(size_t j = 0; j < m; ++j) {
+                xs[j] = queries[order[first+j]].x;
+                ys[j] = queries[order[first+j]].y;
+            }
+            candidates.assign(m,0);
+            boundary.assign(m,0);
+            crossings.assign(m,0);
+            for(size_t i = offsets[slab]; i < offsets[slab+1]; ++i) {
+                const FLOAT_TYPE low = lowY[i], high = highY[i], right = highX[i];
+                size_t hits = 0;
+                for(size_t j = 0; j < m; ++j) {
+                    unsigned char hit = (ys[j] >= low) & (ys[j] <= high) & (xs[j] <= right) & (boundary[j] == 0);
+                    candidates[j] = hit;
+                    hits += hit;
+                }
+                if(hits == 0)
+                    continue;
+                for(size_t j = 0; j < m; ++j) {
+                    if(not candidates[j])
+                        continue;
+                    const P & point = queries[order[first+j]];
+                    switch(__impl::rayCrossing(segments[i],point,Ray<T>::right(point))){
+                        case __impl::RayCrossing::BOUNDARY:
+                            boundary[j] = 1;
+                            break;
+                        case __impl::RayCrossing::CROSSING:
+                            ++crossings[j];
+                            break;
+                        case __impl::RayCrossing::NONE:
+                            break;
+                    }
+                }
+            }
+            for(size_t j = 0; j < m; ++j) {
+                if(boundary[j])
+                    result[order[first+j]] = PointLocation::BOUNDARY;
+                else if(crossings[j]%2 == 1)
+                    result[order[first+j]] = PointLocation::INSIDE;
+            }
+        }
+        return result;
+    }
+
+    bool contains(IPoint auto const & point) const noexcept {
+        return getPointLocation(point) != PointLocation::OUTSIDE;
+    }
+
+    bool isInside(IPoint auto const & point) const noexcept {
+        return getPointLocation(point) == PointLocation::INSIDE;
+    }
+
+    bool isOnBoundary(IPoint auto const & point) const noexcept {
+        return getPointLocation(point) == PointLocation::BOUNDARY;
+    }
+
+    bool isOutside(IPoint auto const & point) const noexcept {
+        return getPointLocation(point) == PointLocation::OUTSIDE;
+    }
+
+    /**
+     * @brief Test whether a segment is fully contained inside the boundary of the ring, equal to Ring::contains(segment).
+     * Only the segments of the ring overlapping the y-range of the segment are intersected with the segment.
+     *
+     * @param segment
+     * @return true
+     * @return false
+     */
+    bool contains(ISegment auto const & segment) const noexcept {
+        [[unlikely]] if(not segment.isValid())
+             return contains(segment.p());
+        const auto & p = segment.p();
+        const auto & q = segment.q();
+        std::vector<Vec2DReal> splittingPoints;
+        splittingPoints.push_back(p);
+        bool containedInRingSegment = false;
+        forEachCandidate(segment,[&](size_t i){
+            const auto & s = segments[i];
+            if(containedInRingSegment)
+                return;
+            [[unlikely]] if(s.containsSegment(segment)){
+                containedInRingSegment = true;
+                return;
+            }
+            auto inter = s.intersection(segment);
+            if(inter and not s.isEndpoint(inter.value()) and not segment.isEndpoint(inter.value())) // splitting points must not be vertices of the ring or endpoint of the segment
+                splittingPoints.push_back(inter.value());
+        });
+        if(containedInRingSegment)
+            return true;
+        splittingPoints.push_back(q);
+        std::ranges::sort(splittingPoints,[&p](const Vec2DReal & a, const Vec2DReal & b ){
+            return p.distance(a) < p.distance(b);
+        });
+        for(size_t i = 0; i < splittingPoints.size()-1; i++){
+            auto middlePointOfPartialSegment = splittingPoints[i] + (splittingPoints[i+1]-splittingPoints[i]) * 0.5;
+            if(not contains(middlePointOfPartialSegment))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Test whether another ring is fully contained inside the boundary of the ring, equal to Ring::contains(other)
+     */
+    bool contains(const IRing auto & other) const noexcept {
+        return std::ranges::all_of(other.getSegments(),[this](const auto & s){
+            return this->contains(s);
+        });
+    }
+
+    /**
+     * @brief Test whether a segment intersects the ring, equal to Ring::intersects(segment).
+     * Only the segments of the ring overlapping the y-range of the segment are tested, endpoints of the segment are located with the index.
+     *
+     * @param segment
+     * @return true
+     * @return false
+     */
+    bool intersects(ISegment auto const & segment) const noexcept {
+        const size_t n = ringSegments.size();
+        bool intersection = false;
+        forEachCandidate(segment,[&](size_t i){
+            if(intersection)
+                return;
+            const size_t id = ids[i];
+            intersection = __impl::intersectsRingSegment(segments[i],ringSegments[(id+n-1)%n],ringSegments[(id+1)%n],segment,[this](const auto & p){return isOutside(p);});
+        });
+        return intersection;
+    }
+};
+
+//Deduction guide
+template<IRing R>
+PreparedRing(const R &) -> PreparedRing<typename R::numeric_type>;
+}
@@ -17,22 +17,11 @@ private:
     T _bottom;
 
     void init() noexcept {
-        for(const auto p : this->getPoints() | std::views::take(1)){ 
-            _left = p.x;
-            _right = _left;
-            _top =  p.y;
-            _bottom = _top;
-        }
-        for(const auto p : this->getPoints()){
-            if(p.y > _top)
-                _top = p.y;
-            if(p.y < _bottom)
-                _bottom = p.y;
-            if(p.x > _right)
-                _right = p.x;
-            if(p.x < _left)
-                _left = p.x;
-        }
+        const auto & box = this->getBoundingBox(); // extreme points are precomputed by the ring
+        _left = box.left;
+        _top = box.top;
+        _right = box.right;
+        _bottom = box.bottom;
     }
 
 public:
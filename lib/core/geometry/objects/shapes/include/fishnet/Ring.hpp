@@ -5,21 +5,24 @@
 #include <algorithm>
 #include <unordered_set>
 #include <sstream>
+#include <numeric>
+#include <optional>
+#include <limits>
+#include <type_traits>
 
 #include <fishnet/Segment.hpp>
 #include <fishnet/CollectionConcepts.hpp>
 #include <fishnet/FunctionalConcepts.hpp>
 #include <fishnet/Ray.hpp>
 #include <fishnet/ShapeGeometry.hpp>
+#include <fishnet/AABB.hpp>
 #include <fishnet/PolygonalRingVerification.hpp>
 #include <fishnet/PolygonDistance.hpp>
+#include <fishnet/RingPrimitives.hpp>
+#include <fishnet/PreparedRing.hpp>
 
 namespace fishnet::geometry{
 
-enum class PointLocation{
-    INSIDE,OUTSIDE,BOUNDARY
-};
-
 /**
  * @brief Implementation of a ring
  * 
@@ -29,6 +32,11 @@ template<fishnet::math::Number T>
 class Ring{
 private:
     std::vector<Segment<T>> segments;
+    /* Geometric invariants, computed once on construction (the segments are immutable) */
+    fishnet::math::DEFAULT_FLOATING_POINT cachedArea = 0;
+    Vec2DReal cachedCentroid;
+    AABB<T> cachedBoundingBox;
+    size_t cachedHash = 0;
 
     /**
      * @brief Helper function to create a list of segment from a list of points
@@ -66,6 +74,33 @@ private:
             }
         }
     }
+
+    /**
+     * @brief Computes area, centroid, axis-aligned bounding box and hash of the ring in a single pass over the segments.
+     * Has to be called after the segments are verified.
+     * Area uses the Shoelace formula: https://en.wikipedia.org/wiki/Shoelace_formula
+     */
+    constexpr void initInvariants() noexcept {
+        if(segments.empty())
+            return;
+        constexpr static auto segmentHasher = std::hash<Segment<T>>{};
+        constexpr static auto pointHasher = std::hash<Vec2DReal>{};
+        fishnet::math::DEFAULT_FLOATING_POINT shoelaceSum = 0;
+        Vec2DReal sum {0,0};
+        const auto & first = segments.front().p();
+        cachedBoundingBox = AABB<T>(first.x,first.y,first.x,first.y);
+        size_t segmentsHash = 0;
+        for(const auto & s : segments){
+            const auto & p = s.p();
+            shoelaceSum += p.cross(s.q()); // q() of the current segment is p() of the next segment
+            sum = sum + p;
+            cachedBoundingBox.merge(AABB<T>(p.x,p.y,p.x,p.y));
+            segmentsHash += segmentHasher(s);
+        }
+        cachedArea = 0.5 * fabs(shoelaceSum);
+        cachedCentroid = sum / (fishnet::math::DEFAULT_FLOATING_POINT)segments.size();
+        cachedHash = pointHasher(cachedCentroid) + segmentsHash;
+    }
 protected:
 
     /**
@@ -79,46 +114,111 @@ protected:
         u_int16_t intersectionCounter = 0;
         Ray<T> horizontalRay = Ray<T>::right(point);
         for(const auto & segment: segments){
-            if(point==segment.p() or point==segment.q() or segment.contains(point)) //point is part of any segment on the boundary
-                 return PointLocation::BOUNDARY;
-            std::optional<Vec2DReal> interOpt = segment.intersection(horizontalRay);
-            if (not interOpt) 
-                continue; // no intersection, go to next segment
-            const Vec2DReal & inter = interOpt.value();
-            if (inter == segment.lowerEndpoint()) 
-                continue; //prevent counting a vertex twice -> count only upperEndpoints
-            ++intersectionCounter; 
+            switch(__impl::rayCrossing(segment,point,horizontalRay)){
+                case __impl::RayCrossing::BOUNDARY:
+                    return PointLocation::BOUNDARY;
+                case __impl::RayCrossing::CROSSING:
+                    ++intersectionCounter;
+                    break;
+                case __impl::RayCrossing::NONE:
+                    break;
+            }
         }
         return intersectionCounter%2 == 1 ? PointLocation::INSIDE : PointLocation::OUTSIDE;
     }
 
+    /**
+     * @brief Indicates whether the queries between this ring and the other ring are answered by a PreparedRing,
+     * which pays off when testing all pairs of segments becomes too expensive
+     * @param other ring
+     * @return true if the product of the numbers of segments exceeds PREPARED_RING_THRESHOLD
+     */
+    template<fishnet::math::Number U>
+    constexpr bool usePreparedRing(const Ring<U> & other) const noexcept {
+        constexpr static size_t PREPARED_RING_THRESHOLD = 10000;
+        return segments.size() * other.getSegments().size() > PREPARED_RING_THRESHOLD;
+    }
+
+    /**
+     * @brief Test whether the boundaries of the rings cross each other, using the PreparedRings of both rings
+     * @param other ring
+     * @param preparedThis PreparedRing of this ring
+     * @param preparedOther PreparedRing of the other ring
+     * @return true if any segment of one ring intersects the other ring
+     */
+    template<fishnet::math::Number U>
+    constexpr bool crosses(const Ring<U> & other, const PreparedRing<T> & preparedThis, const PreparedRing<U> & preparedOther) const noexcept {
+        return std::ranges::any_of(segments,[&preparedOther](const auto & s){return preparedOther.intersects(s);})
+            || std::ranges::any_of(other.getSegments(),[&preparedThis](const auto & s){return preparedThis.intersects(s);});
+    }
+
+    /**
+     * @brief Test whether one ring contains the other or the boundaries of the rings cross each other, using the PreparedRings of both rings
+     * @param other ring
+     * @param preparedThis PreparedRing of this ring
+     * @param preparedOther PreparedRing of the other ring
+     * @return true if the rings overlap
+     */
+    template<fishnet::math::Number U>
+    constexpr bool overlaps(const Ring<U> & other, const PreparedRing<T> & preparedThis, const PreparedRing<U> & preparedOther) const noexcept {
+        return crosses(other,preparedThis,preparedOther) || preparedThis.contains(other) || preparedOther.contains(*this);
+    }
+
 public:
     using numeric_type = T;
     constexpr static GeometryType type = GeometryType::RING;
 
-    Ring(util::random_access_range_of<Vec2D<T>> auto const& points){
+    /**
+     * @brief Construct a new Ring from its points
+     * 
+     * @param points points of the ring, the ring is closed implicitly
+     * @param checked if true, no checks are applied, potentially speeding up the construction.
+     * Only use for points known to form a valid polygonal ring, e.g. derived from another ring
+     * @throws InvalidGeometryException if the points do not form a valid polygonal ring
+     */
+    Ring(util::random_access_range_of<Vec2D<T>> auto const& points, bool checked = false){
         this->segments = std::move(toSegments(points));
-        verifyPolygonalRing<T>(this->segments);
+        if(not checked)
+            verifyPolygonalRing<T>(this->segments);
+        initInvariants();
     }
 
-    Ring(util::random_access_range_of<Segment<T>> auto const& segments):segments(segments){
+    /**
+     * @brief Construct a new Ring from its segments
+     * 
+     * @param segments segments of the ring
+     * @param checked if true, no checks are applied, potentially speeding up the construction
+     * @throws InvalidGeometryException if the segments do not form a valid polygonal ring
+     */
+    Ring(util::random_access_range_of<Segment<T>> auto const& segments, bool checked = false):segments(segments){
         makeValid();
-        verifyPolygonalRing<T>(this->segments);
+        if(not checked)
+            verifyPolygonalRing<T>(this->segments);
+        initInvariants();
     }
 
     Ring(std::initializer_list<Vec2D<T>> && points){
         std::vector<Vec2D<T>> pointsInVector {points};
         this->segments = std::move(toSegments(pointsInVector));
         verifyPolygonalRing<T>(this->segments);
+        initInvariants();
     }
 
+    /**
+     * @brief Convert the ring to another numeric type
+     * The verification is only skipped if every coordinate is representable in U, 
+     * narrowing conversions (e.g. double -> int) may collapse or cross segments and are verified.
+     * @tparam U target numeric type
+     * @throws InvalidGeometryException if a narrowing conversion does not yield a valid polygonal ring
+     */
     template<fishnet::math::Number U>
-    constexpr operator Ring<U> () const noexcept {
+    constexpr operator Ring<U> () const {
+        constexpr static bool lossless = std::same_as<std::common_type_t<T,U>,U> && std::numeric_limits<T>::digits <= std::numeric_limits<U>::digits;
         std::vector<Vec2D<U>> points {};
         std::ranges::transform(getPoints(),std::back_inserter(points),[](const auto & p){
             return static_cast<Vec2D<U>>(p);
         });
-        return Ring<U>(points);
+        return Ring<U>(points,lossless);
     }
 
     constexpr const Ring<T> & getBoundary() const noexcept {
@@ -139,54 +239,50 @@ public:
     }
 
     /**
-     * @brief Calculate the area of the ring
+     * @brief Get the area of the ring, precomputed on construction
      * Uses Shoelace formula: https://en.wikipedia.org/wiki/Shoelace_formula
      * @return area of the ring in the same units as the segments/points
      */
     constexpr fishnet::math::DEFAULT_FLOATING_POINT area() const noexcept {
-        fishnet::math::DEFAULT_FLOATING_POINT area = 0;
-        auto const& points = this->getPoints();
-        for(size_t i = 0; i < points.size(); i++){
-            area += points[i].cross(points[(i+1)%points.size()]);
-        }
-        return 0.5 * fabs(area);
+        return cachedArea;
     }
 
     /**
-     * @brief Calculate centroid point of the ring
+     * @brief Get the centroid point of the ring, precomputed on construction
      * https://en.wikipedia.org/wiki/Centroid 
      * @return constexpr Vec2DReal 
      */
     constexpr Vec2DReal centroid() const noexcept {
-        Vec2DReal sum {0,0};
-        for(const auto & s : segments){
-            sum = sum + s.p();
-        }
-        return sum / (fishnet::math::DEFAULT_FLOATING_POINT)segments.size();
+        return cachedCentroid;
+    }
+
+    /**
+     * @brief Get the extreme coordinates of the ring in every direction, precomputed on construction
+     * 
+     * @return const AABB<T>& 
+     */
+    constexpr const AABB<T> & getBoundingBox() const noexcept {
+        return cachedBoundingBox;
+    }
+
+    /**
+     * @brief Get the precomputed hash value of the ring, used by std::hash<Ring<T>>
+     * 
+     * @return size_t 
+     */
+    constexpr size_t hashValue() const noexcept {
+        return cachedHash;
     }
 
     /**
      * @brief Computes the axis-aligned bounding box of the ring
-     * Calculated be computing the extreme points in every direction and forming a rectangle
+     * Formed by the precomputed extreme points in every direction
      * @return Ring representing the aaBB
      */
     constexpr Ring<T> aaBB() const noexcept {
-        T high = this->segments.at(0).p().y;
-        T low = high;
-        T right = this->segments.at(0).p().x;
-        T left = right;
-        for(const auto s : this->getSegments()){
-            auto p = s.p();
-            if(p.y > high)
-                high = p.y;
-            if(p.y < low)
-                low = p.y;
-            if(p.x > right)
-                right = p.x;
-            if(p.x < left)
-                left = p.x;
-        }
-        return Ring<T>({{left,high},{right,high},{right,low},{left,low}});
+        const auto & box = this->cachedBoundingBox;
+        std::vector<Vec2D<T>> corners {{box.left,box.top},{box.right,box.top},{box.right,box.bottom},{box.left,box.bottom}};
+        return Ring<T>(corners,true);
     }
 
     constexpr bool contains(IPoint auto const & point) const noexcept {
@@ -226,41 +322,12 @@ public:
      */
     template<LinearGeometry L>
     constexpr bool intersects( const L & linearFeature) const noexcept {
-        // Helper lambda to check whether two points are on the same side of the linearFeature (or on the line)
-        auto onSameSide = [linearFeature](const Vec2D<T> & lhs, const Vec2D<T> & rhs) {
-            auto line = linearFeature.toLine();
-            if(line.contains(rhs) || line.contains(lhs)){
+        const size_t n = segments.size();
+        for(size_t i = 0; i < n; ++i){
+            if(__impl::intersectsRingSegment(segments[i],segments[(i+n-1)%n],segments[(i+1)%n],linearFeature,[this](const auto & p){return isOutside(p);}))
                 return true;
-            }
-            return line.isLeft(lhs) == line.isLeft(rhs);
-        }; 
-        for(size_t i = 0; i < segments.size(); ++i){
-            auto current = segments[i];
-            auto inter = current.intersection(linearFeature);
-            if constexpr(ISegment<L>){
-                if(inter && (linearFeature.isEndpoint(inter.value()) && current.isEndpoint(inter.value())))
-                     continue;
-                if(inter && (linearFeature.isEndpoint(inter.value())) && (isOutside(linearFeature.p()) || isOutside(linearFeature.q())))
-                    return true;
-            }
-            if constexpr(IRay<L>){
-                if(inter && inter.value() == linearFeature.origin())
-                     continue;
-            }
-            if(inter && current.isEndpoint(inter.value())) { // intersection is vertex of ring
-                if(current.p() == inter.value()){
-                    if(not onSameSide(current.q(),segments[(i-1)%segments.size()].p()))
-                        return true;
-                }else{ // inter.value() == current.q()
-                    if(not onSameSide(current.p(),segments[(i+1)%segments.size()].q())) 
-                        return true;
-                }
-            }else if(inter){
-                if(not onSameSide(current.p(),current.q())) return true;
-            }
         }
         return false;
-
     }
 
     constexpr util::forward_range_of<Vec2D<double>> auto intersections(LinearGeometry auto const& linearFeature) const noexcept{
@@ -342,24 +409,52 @@ public:
         return true;
     }
 
+    /**
+     * @brief Test whether the boundaries of the rings cross each other, i.e. any segment of one ring intersects the other ring
+     * For large rings the segments are tested against a PreparedRing of the other ring, which only intersects segments overlapping in y-direction,
+     * instead of testing every pair of segments.
+     * @param other ring
+     * @return true 
+     * @return false 
+     */
     template<fishnet::math::Number U>
     constexpr bool crosses(const Ring<U> & other) const noexcept {
+        if(usePreparedRing(other))
+            return crosses(other,PreparedRing<T>(*this),PreparedRing<U>(other));
         return std::ranges::any_of(segments,[&other](const auto & s){return other.intersects(s);}) 
             || std::ranges::any_of(other.getSegments(),[this](const auto & s){return this->intersects(s);});
     }
 
+    /**
+     * @brief Test whether the other ring is fully contained inside the boundary of the ring
+     * For large rings the segments of the other ring are tested against a PreparedRing of this ring.
+     * @param other ring
+     * @return true 
+     * @return false 
+     */
     template<fishnet::math::Number U>
     constexpr bool contains(const Ring<U> & other) const noexcept {
+        if(usePreparedRing(other))
+            return PreparedRing<T>(*this).contains(other);
         return std::ranges::all_of(other.getSegments(), [this](const Segment<U> & s){
-            if(not this->contains(s)){
-                this->contains(s);
-            }
             return this->contains(s);
         });
     }
 
+    /**
+     * @brief Test whether the rings share boundary points without overlapping
+     * For large rings the PreparedRings of both rings are built once and shared by all tests.
+     * @param other ring
+     * @return true 
+     * @return false 
+     */
     template<fishnet::math::Number U>
     constexpr bool touches(const Ring<U> & other) const noexcept {
+        if(usePreparedRing(other)){
+            PreparedRing<T> preparedThis {*this};
+            if(overlaps(other,preparedThis,PreparedRing<U>(other))) return false;
+            return std::ranges::any_of(other.getPoints(),[&preparedThis](const auto & p){return preparedThis.isOnBoundary(p);});
+        }
         if(this->crosses(other)) return false;
         if(this->contains(other) || other.contains(*this)) return false;
         for(const auto & p : other.getPoints()){
@@ -370,7 +465,7 @@ public:
 
     template<fishnet::math::Number U>
     constexpr fishnet::math::DEFAULT_FLOATING_POINT distance(const Ring<U> & other) const noexcept {
-        if(this->contains(other) or other.contains(*this) or this->crosses(other))
+        if(usePreparedRing(other) ? overlaps(other,PreparedRing<T>(*this),PreparedRing<U>(other)) : (this->contains(other) or other.contains(*this) or this->crosses(other)))
              return -1;
         return shapeDistance(*this,other);
 
@@ -402,12 +497,8 @@ template class Ring<fishnet::math::DEFAULT_NUMERIC>;
 namespace std{
     template<typename T>
     struct hash<fishnet::geometry::Ring<T>>{
-        constexpr static auto segmentHasher = hash<fishnet::geometry::Segment<T>>{};
-        constexpr static auto pointHasher = hash<fishnet::geometry::Vec2DReal>{};
         size_t operator()(const fishnet::geometry::Ring<T> & ring) const noexcept{
-            auto segmentsHashView = ring.getSegments() | std::views::transform([](const auto & segment){return segmentHasher(segment);});
-            auto centroidHash = pointHasher(ring.centroid());
-            return std::accumulate(std::ranges::begin(segmentsHashView),std::ranges::end(segmentsHashView),centroidHash);
+            return ring.hashValue();
         }
     };
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+#include <optional>
+
+#include <fishnet/Segment.hpp>
+#include <fishnet/Ray.hpp>
+#include <fishnet/LinearGeometry.hpp>
+
+namespace fishnet::geometry{
+
+enum class PointLocation{
+    INSIDE,OUTSIDE,BOUNDARY
+};
+
+namespace __impl {
+enum class RayCrossing{
+    NONE,CROSSING,BOUNDARY
+};
+
+/**
+ * @brief Single step of the ray casting algorithm: tests a segment of the ring against a point and the horizontal ray to the right of the point
+ *
+ * @param segment segment of the ring
+ * @param point point under test
+ * @param horizontalRay Ray<T>::right(point)
+ * @return RayCrossing BOUNDARY if the point is part of the segment, CROSSING if the ray crosses the segment (vertices count for the segment above only)
+ */
+template<fishnet::math::Number T>
+constexpr RayCrossing rayCrossing(const Segment<T> & segment, IPoint auto const & point, const Ray<T> & horizontalRay) noexcept {
+    if(point==segment.p() or point==segment.q() or segment.contains(point)) //point is part of any segment on the boundary
+        return RayCrossing::BOUNDARY;
+    std::optional<Vec2DReal> interOpt = segment.intersection(horizontalRay);
+    if (not interOpt)
+        return RayCrossing::NONE; // no intersection
+    if (interOpt.value() == segment.lowerEndpoint())
+        return RayCrossing::NONE; //prevent counting a vertex twice -> count only upperEndpoints
+    return RayCrossing::CROSSING;
+}
+
+/**
+ * @brief Single step of the intersection test of a ring with a linear feature: tests a segment of the ring against the linear feature
+ *
+ * @param current segment of the ring
+ * @param previous segment preceding current in the ring
+ * @param next segment following current in the ring
+ * @param linearFeature linear feature under test
+ * @param isOutside unary predicate, testing whether a point is outside of the ring
+ * @return true if the linear feature intersects the ring at the current segment
+ */
+template<fishnet::math::Number T, LinearGeometry L>
+constexpr bool intersectsRingSegment(const Segment<T> & current, const Segment<T> & previous, const Segment<T> & next, const L & linearFeature, auto && isOutside) noexcept {
+    // Helper lambda to check whether two points are on the same side of the linearFeature (or on the line)
+    auto onSameSide = [&linearFeature](const Vec2D<T> & lhs, const Vec2D<T> & rhs) {
+        auto line = linearFeature.toLine();
+        if(line.contains(rhs) || line.contains(lhs)){
+            return true;
+        }
+        return line.isLeft(lhs) == line.isLeft(rhs);
+    };
+    auto inter = current.intersection(linearFeature);
+    if(not inter)
+        return false;
+    if constexpr(ISegment<L>){
+        if(linearFeature.isEndpoint(inter.value()) && current.isEndpoint(inter.value()))
+            return false;
+        if(linearFeature.isEndpoint(inter.value()) && (isOutside(linearFeature.p()) || isOutside(linearFeature.q())))
+            return true;
+    }
+    if constexpr(IRay<L>){
+        if(inter.value() == linearFeature.origin())
+            return false;
+    }
+    if(current.isEndpoint(inter.value())) { // intersection is vertex of ring
+        if(current.p() == inter.value())
+            return not onSameSide(current.q(),previous.p());
+        return not onSameSide(current.p(),next.q()); // inter.value() == current.q()
+    }
+    return not onSameSide(current.p(),current.q());
+}
+}
+}
@@ -0,0 +1,256 @@
+#pragma once
+#include <ranges>
+#include <vector>
+#include <span>
+#include <bit>
+#include <optional>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+#include <fishnet/UtilConcepts.hpp>
+#include <fishnet/CollectionConcepts.hpp>
+#include "AdjacencyContainer.hpp"
+
+namespace fishnet::graph{
+/**
+ * @brief Immutable adjacency container in compressed sparse row (CSR) format:
+ * https://en.wikipedia.org/wiki/Sparse_matrix#Compressed_sparse_row_(CSR,_CRS_or_Yale_format)
+ * Each node is stored once and identified by its id (index in insertion order).
+ * The adjacencies of all nodes are stored as sorted, deduplicated node ids in a single contiguous vector,
+ * such that the adjacency of an id is an O(1) range and testing an adjacency is logarithmic in the degree.
+ * Nodes are looked up by an open-addressing table of ids, hashing every node exactly once on construction.
+ * Implements AdjacencyContainer, all modifying operations except clear() throw std::logic_error.
+ * @tparam N node type
+ * @tparam Hash hasher type on N
+ * @tparam Equal comparator type on N
+ */
+template<typename N, util::HashFunction<N> Hash=std::hash<N>, util::BiPredicate<N> Equal=std::equal_to<N>>
+class CSRAdjacency{
+private:
+    constexpr static size_t EMPTY_SLOT = std::numeric_limits<size_t>::max();
+    const static inline Equal eq=Equal();
+    const static inline Hash hash = Hash();
+
+    std::vector<N> nodeList; // id -> node
+    std::vector<size_t> hashes; // id -> hash of the node
+    std::vector<size_t> slots; // open-addressing table of ids, size is a power of two
+    std::vector<size_t> offsets {0}; // adjacency of id is targets[offsets[id],offsets[id+1])
+    std::vector<size_t> targets;
+
+    [[noreturn]] static void immutable() {
+        throw std::logic_error("CSRAdjacency is immutable, copy the adjacencies into a mutable container to modify them");
+    }
+
+    /**
+     * @brief Get the slot of the node in the id table, either storing its id or EMPTY_SLOT if not contained
+     *
+     * @param node
+     * @param nodeHash hash of the node
+     * @return size_t index into slots
+     */
+    size_t slotOf(const N & node, size_t nodeHash) const noexcept {
+        const size_t mask = slots.size() - 1;
+        size_t slot = nodeHash & mask;
+        while(slots[slot] != EMPTY_SLOT && not (hashes[slots[slot]] == nodeHash && eq(nodeList[slots[slot]],node))) {
+            slot = (slot + 1) & mask; // linear probing
+        }
+        return slot;
+    }
+
+    /**
+     * @brief Get the id of the node, inserting the node if not already contained
+     * Requires slots to provide capacity for the node
+     * @param node
+     * @return size_t id
+     */
+    size_t insertNode(const N & node) {
+        size_t nodeHash = hash(node);
+        size_t slot = slotOf(node,nodeHash);
+        if(slots[slot] == EMPTY_SLOT) {
+            slots[slot] = nodeList.size();
+            nodeList.push_back(node);
+            hashes.push_back(nodeHash);
+        }
+        return slots[slot];
+    }
+
+    void build(util::forward_range_of<N> auto const & nodes, util::forward_range_of<std::pair<N,N>> auto const & adjacencies) {
+        size_t capacity = util::size(nodes) + 2 * util::size(adjacencies);
+        slots.assign(std::bit_ceil(std::max<size_t>(2 * capacity,2)),EMPTY_SLOT); // load factor at most 0.5
+        for(const auto & node: nodes) {
+            insertNode(node);
+        }
+        std::vector<std::pair<size_t,size_t>> idPairs;
+        idPairs.reserve(util::size(adjacencies));
+        for(const auto & [from,to]: adjacencies) {
+            size_t fromId = insertNode(from);
+            idPairs.emplace_back(fromId,insertNode(to));
+        }
+        std::ranges::sort(idPairs);
+        auto [last,end] = std::ranges::unique(idPairs);
+        idPairs.erase(last,end);
+        offsets.assign(nodeList.size()+1,0);
+        for(const auto & [from,to]: idPairs) {
+            ++offsets[from+1];
+        }
+        for(size_t id = 0; id < nodeList.size(); ++id) {
+            offsets[id+1] += offsets[id];
+        }
+        targets.reserve(idPairs.size());
+        std::ranges::transform(idPairs,std::back_inserter(targets),[](const auto & pair){return pair.second;});
+        nodeList.shrink_to_fit();
+        hashes.shrink_to_fit();
+    }
+
+public:
+    using node_type = N;
+    using equality_predicate = Equal;
+    using hash_function = Hash;
+
+    CSRAdjacency() = default;
+
+    /**
+     * @brief Build the container from a range of nodes and a range of adjacencies.
+     * Nodes only occurring in the adjacencies are added as well, duplicate adjacencies are stored once.
+     * @param nodes range of nodes
+     * @param adjacencies range of pairs (from,to)
+     */
+    CSRAdjacency(util::forward_range_of<N> auto const & nodes, util::forward_range_of<std::pair<N,N>> auto const & adjacencies) {
+        build(nodes,adjacencies);
+    }
+
+    /**
+     * @brief Build the container from the nodes and adjacencies of another adjacency container
+     *
+     * @param source adjacency container
+     */
+    explicit CSRAdjacency(AdjacencyContainer<N> auto const & source) {
+        std::vector<std::pair<N,N>> adjacencies;
+        for(const auto & [from,to]: source.getAdjacencyPairs()) {
+            adjacencies.emplace_back(from,to);
+        }
+        build(source.nodes(),adjacencies);
+    }
+
+    /**
+     * @brief Get the number of nodes
+     *
+     * @return size_t
+     */
+    size_t size() const noexcept {
+        return nodeList.size();
+    }
+
+    /**
+     * @brief Get the number of stored adjacencies (from,to)
+     *
+     * @return size_t
+     */
+    size_t adjacencyCount() const noexcept {
+        return targets.size();
+    }
+
+    /**
+     * @brief Get the id of a node
+     *
+     * @param node
+     * @return std::optional<size_t> id of the node, or std::nullopt if the node is not contained
+     */
+    std::optional<size_t> id(const N & node) const noexcept {
+        if(nodeList.empty())
+            return std::nullopt;
+        size_t slot = slotOf(node,hash(node));
+        if(slots[slot] == EMPTY_SLOT)
+            return std::nullopt;
+        return slots[slot];
+    }
+
+    /**
+     * @brief Get the node of an id
+     *
+     * @param id in the range [0,size())
+     * @return const N&
+     */
+    const N & node(size_t id) const noexcept {
+        return nodeList[id];
+    }
+
+    /**
+     * @brief Get the sorted ids of the nodes adjacent to the id
+     *
+     * @param id in the range [0,size())
+     * @return std::span<const size_t>
+     */
+    std::span<const size_t> adjacentIds(size_t id) const noexcept {
+        return std::span<const size_t>(targets.data()+offsets[id],targets.data()+offsets[id+1]);
+    }
+
+    bool hasAdjacentId(size_t from, size_t to) const noexcept {
+        return std::ranges::binary_search(adjacentIds(from),to);
+    }
+
+    void addAdjacency(const N &, const N &) {
+        immutable();
+    }
+
+    void addAdjacencies(util::forward_range_of<std::pair<N,N>> auto &&){
+        immutable();
+    }
+
+    bool addNode(const N &){
+        immutable();
+    }
+
+    bool addNodes(util::forward_range_of<N> auto &&) {
+        immutable();
+    }
+
+    void removeNode(const N &){
+        immutable();
+    }
+
+    void removeNodes(util::forward_range_of<N> auto &&){
+        immutable();
+    }
+
+    void removeAdjacency(const N &, const N &){
+        immutable();
+    }
+
+    void removeAdjacencies(util::forward_range_of<std::pair<N,N>> auto &&) {
+        immutable();
+    }
+
+    bool contains(const N & node) const noexcept{
+        return id(node).has_value();
+    }
+
+    bool hasAdjacency(const N & from, const N & to) const noexcept{
+        auto fromId = id(from);
+        auto toId = id(to);
+        return fromId && toId && hasAdjacentId(fromId.value(),toId.value());
+    }
+
+    auto adjacency(const N & node) const noexcept{
+        auto nodeId = id(node);
+        auto ids = nodeId ? adjacentIds(nodeId.value()) : std::span<const size_t>();
+        return ids | std::views::transform([this](size_t adjacentId) -> const N & {return nodeList[adjacentId];});
+    }
+
+    auto nodes() const noexcept {
+        return std::views::all(nodeList);
+    }
+
+    auto getAdjacencyPairs() const noexcept {
+        return std::views::iota(size_t(0),nodeList.size())
+            | std::views::transform([this](size_t from){
+                return adjacentIds(from) | std::views::transform([this,from](size_t to){return std::make_pair(nodeList[from],nodeList[to]);});})
+            | std::views::join;
+    }
+
+    void clear() noexcept {
+        *this = CSRAdjacency();
+    }
+};
+
+}
@@ -105,15 +105,15 @@ auto connectedComponents(const G  & graph) {
  * 
  * @tparam G graph type
  * @param graph graph
- * @param queue shared pointer to blocking queue, storing pairs of component-ids and vectors of nodes
+ * @param queue shared pointer to a queue (e.g. BlockingQueue or MPMCQueue), storing pairs of component-ids and vectors of nodes
  * @param inRelation BiPredicate indicating whether two nodes are in relation
  * @return ConcurrentConnectedComponents search result 
  */
-template<Graph G>
-auto connectedComponents(const G & graph,std::shared_ptr<fishnet::util::BlockingQueue<std::pair<int,std::vector<typename G::node_type>>>>  queue, NodeBiPredicate<typename G::node_type> auto const& inRelation)  {
+template<Graph G, ComponentQueue<typename G::node_type> Q>
+auto connectedComponents(const G & graph,std::shared_ptr<Q>  queue, NodeBiPredicate<typename G::node_type> auto const& inRelation)  {
     using H = G::adj_container_type::hash_function;
     using E = G::adj_container_type::equality_predicate;
-    auto concurrentConnectedComponents = ConcurrentConnectedComponents<typename G::node_type,H,E>(queue);
+    auto concurrentConnectedComponents = ConcurrentConnectedComponents<typename G::node_type,H,E,Q>(queue);
     __impl::bfs_all<G>(graph,concurrentConnectedComponents,inRelation);
     return concurrentConnectedComponents;
 }
@@ -123,11 +123,11 @@ auto connectedComponents(const G & graph,std::shared_ptr<fishnet::util::Blocking
  * 
  * @tparam G graph type
  * @param graph graph
- * @param queue shared pointer to blocking queue, storing pairs of component-ids and vectors of nodes
+ * @param queue shared pointer to a queue (e.g. BlockingQueue or MPMCQueue), storing pairs of component-ids and vectors of nodes
  * @return ConcurrentConnectedComponents search result  
  */
-template<Graph G>
-auto connectedComponents(const G & graph, std::shared_ptr<fishnet::util::BlockingQueue<std::pair<int,std::vector<typename G::node_type>>>>  queue)  {
+template<Graph G, ComponentQueue<typename G::node_type> Q>
+auto connectedComponents(const G & graph, std::shared_ptr<Q>  queue)  {
     return connectedComponents(graph,queue,__impl::DefaultBiPredicate<typename G::node_type>());
 }
 
@@ -0,0 +1,225 @@
+#pragma once
+#include <vector>
+#include <queue>
+#include <optional>
+#include <iterator>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include <fishnet/GraphModel.hpp>
+#include <fishnet/NetworkConcepts.hpp>
+
+namespace fishnet::graph{
+
+/**
+ * @brief Connected component emitted by the ComponentStream
+ *
+ * @tparam N node type
+ */
+template<typename N>
+struct Component {
+    int id;
+    std::vector<N> nodes;
+    /**
+     * @brief edges between this component and components emitted before, as pairs of component-ids (from,to).
+     * Each edge is reported once, by the later of both components
+     */
+    std::vector<std::pair<int,int>> edges;
+};
+
+namespace __impl {
+template<typename N>
+concept KeyedNode = requires(const N & node){
+    {node.key()} -> std::copy_constructible;
+};
+
+template<typename N, typename Hash, typename Equal>
+struct ComponentIndexMap {
+    using type = std::unordered_map<N,int,Hash,Equal>;
+};
+
+template<KeyedNode N, typename Hash, typename Equal>
+struct ComponentIndexMap<N,Hash,Equal> {
+    using type = std::unordered_map<std::remove_cvref_t<decltype(std::declval<const N &>().key())>,int>;
+};
+
+/**
+ * @brief Maps the visited nodes to their component-id.
+ * Nodes providing a key() are indexed by their key, to avoid storing copies of nodes with large payloads (e.g. geometries)
+ */
+template<typename N, typename Hash, typename Equal>
+class ComponentIndex {
+private:
+    typename ComponentIndexMap<N,Hash,Equal>::type map;
+
+    static decltype(auto) index(const N & node) noexcept {
+        if constexpr(KeyedNode<N>)
+            return node.key();
+        else
+            return node;
+    }
+public:
+    std::optional<int> get(const N & node) const noexcept {
+        if(auto it = map.find(index(node)); it != map.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    bool insert(const N & node, int componentId) {
+        return map.try_emplace(index(node),componentId).second;
+    }
+};
+}
+
+/**
+ * @brief Lazy, single-pass stream over the connected components of a graph.
+ * Components are computed by a breadth-first search, visiting the nodes in the same order as BFS::connectedComponents(), but only the current component is held in memory.
+ * Besides the nodes, each component carries the edges leading to the components emitted before,
+ * which allows consumers to build the contracted graph incrementally. Isolated nodes are emitted as components of size one.
+ * Only a mapping from visited nodes to component-ids is kept for the whole graph.
+ * @tparam G graph type
+ * @tparam P predicate type, deciding whether two adjacent nodes belong to the same component
+ */
+template<Graph G, NodeBiPredicate<typename G::node_type> P>
+class ComponentStream {
+public:
+    using node_type = G::node_type;
+private:
+    using N = node_type;
+    using H = G::adj_container_type::hash_function;
+    using E = G::adj_container_type::equality_predicate;
+    using NodeRange = decltype(std::declval<const G &>().getNodes());
+
+    const G & graph;
+    P inRelation;
+    NodeRange nodes;
+    std::ranges::iterator_t<NodeRange> position;
+    __impl::ComponentIndex<N,H,E> index;
+    int nextId = 0;
+    std::optional<Component<N>> current;
+
+    void addEdge(Component<N> & component, int from, int to) {
+        if(from != to)
+            component.edges.emplace_back(from,to);
+    }
+
+    Component<N> bfs(const N & start) {
+        Component<N> component {nextId++,{},{}};
+        std::queue<N> q;
+        index.insert(start,component.id);
+        q.push(start);
+        while(not q.empty()) {
+            N node = std::move(q.front());
+            q.pop();
+            for(const auto & neighbour: graph.getNeighbours(node)) {
+                if(auto other = index.get(neighbour)) {
+                    addEdge(component,component.id,other.value());
+                }else if(inRelation(node,neighbour)) {
+                    index.insert(neighbour,component.id);
+                    q.push(neighbour);
+                }
+            }
+            component.nodes.push_back(std::move(node));
+        }
+        if constexpr(G::edge_type::isDirected()) {
+            // inbound edges from earlier components are not visible through getNeighbours()
+            for(const auto & node: component.nodes) {
+                for(const auto & predecessor: graph.getReachableFrom(node)) {
+                    if(auto other = index.get(predecessor); other && other.value() != component.id)
+                        addEdge(component,other.value(),component.id);
+                }
+            }
+        }
+        std::ranges::sort(component.edges);
+        auto duplicates = std::ranges::unique(component.edges);
+        component.edges.erase(duplicates.begin(),duplicates.end());
+        return component;
+    }
+
+    void readNext() {
+        current.reset();
+        while(position != std::ranges::end(nodes)) {
+            const auto & node = *position;
+            ++position;
+            if(not index.get(node)) {
+                current = bfs(node);
+                return;
+            }
+        }
+    }
+
+public:
+    class iterator {
+    private:
+        ComponentStream * stream = nullptr;
+    public:
+        using value_type = Component<N>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::input_iterator_tag;
+
+        iterator() = default;
+        explicit iterator(ComponentStream * stream):stream(stream){}
+
+        /**
+         * @brief Access the current component, which may be moved from
+         */
+        Component<N> & operator*() const noexcept {
+            return stream->current.value();
+        }
+
+        Component<N> * operator->() const noexcept {
+            return &stream->current.value();
+        }
+
+        iterator & operator++() {
+            stream->readNext();
+            return *this;
+        }
+
+        void operator++(int) {
+            ++*this;
+        }
+
+        bool operator==(std::default_sentinel_t) const noexcept {
+            return stream == nullptr || not stream->current.has_value();
+        }
+    };
+
+    /**
+     * @brief Construct a new Component Stream. The graph must not be modified while streaming
+     *
+     * @param graph graph
+     * @param inRelation BiPredicate indicating whether two adjacent nodes are in the same component
+     */
+    ComponentStream(const G & graph, P inRelation):graph(graph),inRelation(std::move(inRelation)),nodes(graph.getNodes()),position(std::ranges::begin(nodes)){}
+
+    ComponentStream(const ComponentStream &) = delete;
+    ComponentStream & operator=(const ComponentStream &) = delete;
+
+    /**
+     * @brief Computes the next connected component
+     *
+     * @return std::optional<Component<N>> component, or std::nullopt if all nodes were visited
+     */
+    std::optional<Component<N>> next() {
+        readNext();
+        return std::exchange(current,std::nullopt);
+    }
+
+    /**
+     * @brief Get the number of components emitted so far
+     */
+    int emitted() const noexcept {
+        return nextId;
+    }
+
+    iterator begin() {
+        readNext();
+        return iterator(this);
+    }
+
+    std::default_sentinel_t end() const noexcept {
+        return std::default_sentinel;
+    }
+};
+}
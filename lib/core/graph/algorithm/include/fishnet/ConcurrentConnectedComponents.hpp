@@ -2,18 +2,27 @@
 #include "ConnectedComponents.hpp"
 #include <fishnet/BlockingQueue.hpp>
 namespace fishnet::graph{
+/**
+ * @brief Queue receiving the closed components as pairs of component-id and nodes, e.g. BlockingQueue or MPMCQueue
+ */
+template<typename Q, typename N>
+concept ComponentQueue = requires(Q & queue, std::pair<int,std::vector<N>> && component){
+    queue.put(std::move(component));
+};
+
 /**
  * @brief Concurrent specialization for computing connected components
  * 
  * @tparam N node type
  * @tparam Hash hasher type on nodes
  * @tparam Equal comparator type on nodes
+ * @tparam Q queue type, receiving the components
  */
-template<typename N, util::HashFunction<N> Hash= std::hash<N>,NodeBiPredicate<N> Equal = std::equal_to<N>>
+template<typename N, util::HashFunction<N> Hash= std::hash<N>,NodeBiPredicate<N> Equal = std::equal_to<N>, ComponentQueue<N> Q = fishnet::util::BlockingQueue<std::pair<int,std::vector<N>>>>
 class ConcurrentConnectedComponents: public ConnectedComponents<N,Hash,Equal>
 {
 private:
-    using QueuePtr = std::shared_ptr<fishnet::util::BlockingQueue<std::pair<int,std::vector<N>>>>;
+    using QueuePtr = std::shared_ptr<Q>;
     QueuePtr queue;
 protected:
     void handleClose() override {
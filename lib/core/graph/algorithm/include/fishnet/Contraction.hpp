@@ -1,45 +1,60 @@
 #pragma once
 #include "BFSAlgorithm.hpp"
+#include "ComponentStream.hpp"
 #include <future>
 #include <mutex>
 #include <numeric>
 #include <type_traits>
 #include <chrono>
 #include <unordered_set>
+#include <exception>
+#include <atomic>
 #include <fishnet/GraphModel.hpp>
 #include <fishnet/NetworkConcepts.hpp>
 #include <fishnet/CollectionConcepts.hpp>
+#include <fishnet/MPMCQueue.hpp>
 
 namespace fishnet::graph::__impl {
 
+constexpr static size_t QUEUE_CAPACITY = 1024;
+constexpr static size_t MERGE_BATCH_SIZE = 16;
+
 template<typename N>
-using QueueType = fishnet::util::BlockingQueue<std::pair<int,std::vector<N>>>;
+using QueueType = fishnet::util::MPMCQueue<std::pair<int,std::vector<N>>>;
 
 template<typename N>
 using QueuePtr = std::shared_ptr<QueueType<N>>;
 
 /**
- * @brief Helper runnable, taking connected components and merging the vertices to a single vertex using the contract function
+ * @brief Helper runnable, taking connected components and merging the vertices to a single vertex using the contract function.
+ * After the first exception thrown by the reduce function remaining components are discarded, such that the producer never blocks on a full queue
  * 
  * @tparam N source node type
  * @tparam R result node type
- * @param queue shared pointer to blocking queue, storing pairs of component-ids and vectors of nodes 
+ * @param queue shared pointer to the queue, storing pairs of component-ids and vectors of nodes. Returns once the queue is closed and empty
  * @param reduceFunction function that reduces a range of nodes to a single node
  * @return std::vector<std::pair<int,R>> storing the pairs of component-id and the merged nodes (of type R)
  */
 template<typename N,typename R>
 static std::vector<std::pair<int,R>> mergeWorker(QueuePtr<N>  queue, util::ReduceFunction<std::vector<N>,R> auto const& reduceFunction){
     std::vector<std::pair<int,R>> mergeResult;
-    auto current = fishnet::util::Element<std::pair<int,std::vector<N>>>::POISON_PILL;
-    do{
-        current = queue->take();
-        if(not current) {
-            queue->putPoisonPill();
-            break;
+    std::vector<std::pair<int,std::vector<N>>> batch;
+    batch.reserve(MERGE_BATCH_SIZE);
+    std::exception_ptr exception;
+    while(queue->takeBatch(std::back_inserter(batch),MERGE_BATCH_SIZE) > 0){
+        if(not exception) {
+            try{
+                for(auto & [componentId, nodes]: batch) {
+                    mergeResult.emplace_back(componentId, reduceFunction(std::move(nodes)));
+                }
+            }catch(...){
+                exception = std::current_exception();
+            }
         }
-        const auto & [componentId, nodes] = current.get();
-        mergeResult.emplace_back(componentId, reduceFunction(std::move(nodes)));
-    }while(current != queue->getPoisonPill());
+        batch.clear();
+    }
+    if(exception)
+        std::rethrow_exception(exception);
     return mergeResult;
 }
 
@@ -47,7 +62,7 @@ static std::vector<std::pair<int,R>> mergeWorker(QueuePtr<N>  queue, util::Reduc
  * @brief Helper runnable, taking connected components and merging the vertices to a single vertex using the contract function
  * 
  * @tparam N node type
- * @param queue shared pointer to blocking queue, storing pairs of component-ids and vectors of nodes 
+ * @param queue shared pointer to the queue, storing pairs of component-ids and vectors of nodes. Returns once the queue is closed and empty
  * @param reduceFunction function that reduces a range of nodes to a single node
  * @return std::vector<std::pair<int,N>> storing the pairs of component-id and the merged nodes
  */
@@ -56,6 +71,41 @@ static std::vector<std::pair<int,N>> mergeWorker(QueuePtr<N> queue, util::Reduce
     return mergeWorker(queue, reduceFunction,util::Identity());
 }
 
+/**
+ * @brief Helper runnable for the streaming contraction, reducing the queued components and passing the merged nodes to the node sink.
+ * After the first exception (thrown by the reduce function or the sink) remaining components are discarded, such that producers never block on a full queue
+ * 
+ * @tparam N source node type
+ * @param queue shared pointer to the queue, storing pairs of component-ids and vectors of nodes. Returns once the queue is closed and empty
+ * @param reduceFunction function that reduces a range of nodes to a single node
+ * @param nodeSink called with the component-id and the merged node, serialized by the sinkMutex
+ * @param sinkMutex mutex shared by all workers
+ * @param failed set on the first exception, to stop the producer early
+ */
+template<typename N>
+static void streamingMergeWorker(QueuePtr<N> queue, auto const & reduceFunction, auto & nodeSink, std::mutex & sinkMutex, std::atomic_bool & failed){
+    std::vector<std::pair<int,std::vector<N>>> batch;
+    batch.reserve(MERGE_BATCH_SIZE);
+    std::exception_ptr exception;
+    while(queue->takeBatch(std::back_inserter(batch),MERGE_BATCH_SIZE) > 0){
+        if(not exception) {
+            try{
+                for(auto & [componentId, nodes]: batch) {
+                    auto merged = reduceFunction(std::move(nodes));
+                    std::lock_guard lock {sinkMutex};
+                    nodeSink(componentId,std::move(merged));
+                }
+            }catch(...){
+                exception = std::current_exception();
+                failed = true;
+            }
+        }
+        batch.clear();
+    }
+    if(exception)
+        std::rethrow_exception(exception);
+}
+
 template<typename N,typename E>
 struct ContractionResult {
     std::vector<N> nodes;
@@ -89,15 +139,22 @@ auto contractImpl(const SourceGraphType & source,
     using R = TargetGraphType::node_type;
     if(workers == 0) 
         workers = 1;
-    auto queue = std::make_shared<__impl::QueueType<N>>();
+    auto queue = std::make_shared<__impl::QueueType<N>>(__impl::QUEUE_CAPACITY);
     std::vector<std::future<std::vector<std::pair<int,R>>>> futures;
     futures.reserve(workers);
     for(int i = 0; i < workers; i++){
         futures.emplace_back(std::async(std::launch::async,[queue,&reduceFunction](){return __impl::mergeWorker<N,R>(queue,reduceFunction);}));
     }
-    auto componentsMap = BFS::connectedComponents(source,queue,contractBiPredicate).asMap();
+    auto componentsMap = [&](){
+        try{
+            return BFS::connectedComponents(source,queue,contractBiPredicate).asMap();
+        }catch(...){
+            queue->close(); // release the workers
+            throw;
+        }
+    }();
     std::unordered_map<int,R> result;
-    queue->putPoisonPill();
+    queue->close();
     result.reserve(componentsMap.size());
     for(auto & f: futures){
         for(auto & merged: f.get() ){
@@ -257,6 +314,61 @@ void contractInPlace( SourceGraphType & graph, util::BiPredicate<typename Source
     __impl::contractInPlace(graph,contractBiPredicate,reduceFunction,mapper,graph,workers);
 }
 
+/**
+ * @brief Streaming edge contraction. Edges between nodes fulfilling the contractBiPredicate get contracted.
+ * Instead of materializing the contracted graph, the connected components are streamed from a ComponentStream and merged independently by the workers.
+ * Each merged node is passed to the nodeSink as soon as its component is reduced, each contracted edge is passed to the edgeSink once both of its components are known.
+ * Nodes and edges are identified by component-ids. The bounded queue between the component stream and the workers limits the amount of components held in memory.
+ * Isolated nodes are reduced as components of size one.
+ * 
+ * @tparam G source graph type
+ * @param source source graph (not changed)
+ * @param contractBiPredicate specifies when an edge between two nodes from source graph shall be contracted
+ * @param reduceFunction specifies how a vector of nodes from the source graph get combined to a single node
+ * @param nodeSink callable receiving the component-id and the merged node. Calls are serialized, but happen on the worker threads in arbitrary order of the components
+ * @param edgeSink callable receiving the component-ids of the contracted edges (from,to). Called on the calling thread, possibly before the incident nodes are passed to the nodeSink
+ * @param workers amount of concurrent works
+ * @param queueCapacity maximum number of components waiting to be merged
+ * @return int number of components (i.e. nodes of the contracted graph)
+ */
+template<Graph G, typename ReduceFunction>
+requires std::invocable<ReduceFunction const &,std::vector<typename G::node_type>>
+int contractStreaming(const G & source, NodeBiPredicate<typename G::node_type> auto const & contractBiPredicate, ReduceFunction const & reduceFunction,
+    std::invocable<int,std::invoke_result_t<ReduceFunction const &,std::vector<typename G::node_type>>> auto && nodeSink,
+    std::invocable<int,int> auto && edgeSink, u_int8_t workers = 1, size_t queueCapacity = __impl::QUEUE_CAPACITY)
+{
+    using N = G::node_type;
+    if(workers == 0) 
+        workers = 1;
+    auto queue = std::make_shared<__impl::QueueType<N>>(queueCapacity);
+    std::mutex sinkMutex;
+    std::atomic_bool failed = false;
+    std::vector<std::future<void>> futures;
+    futures.reserve(workers);
+    for(int i = 0; i < workers; i++){
+        futures.emplace_back(std::async(std::launch::async,[&](){__impl::streamingMergeWorker<N>(queue,reduceFunction,nodeSink,sinkMutex,failed);}));
+    }
+    ComponentStream components {source,std::cref(contractBiPredicate)};
+    try{
+        for(auto & component: components){
+            for(const auto & [from,to]: component.edges) {
+                edgeSink(from,to);
+            }
+            queue->put(std::make_pair(component.id,std::move(component.nodes)));
+            if(failed)
+                break;
+        }
+    }catch(...){
+        queue->close(); // release the workers, the futures wait for them on destruction
+        throw;
+    }
+    queue->close();
+    for(auto & f: futures){
+        f.get();
+    }
+    return components.emitted();
+}
+
 /**
  * @brief Contract the graph depending on the contraction predicate, applying the merge function on the nodes of contracted edges
  * 
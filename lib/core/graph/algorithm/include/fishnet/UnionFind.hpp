@@ -0,0 +1,216 @@
+#pragma once
+#include <atomic>
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+#include <fishnet/GraphModel.hpp>
+#include <fishnet/NetworkConcepts.hpp>
+#include <fishnet/CollectionConcepts.hpp>
+
+namespace fishnet::graph {
+/**
+ * @brief Lock-free concurrent disjoint-set (union-find) over the ids [0,size):
+ * https://en.wikipedia.org/wiki/Disjoint-set_data_structure
+ * Sets are linked by index (the root with the larger id is attached to the smaller one) using compare-and-swap,
+ * as in the Shiloach-Vishkin and Afforest connected components algorithms. Parents therefore only decrease,
+ * find() compresses paths by halving and the root of each set is its smallest id.
+ * All operations may be called concurrently.
+ */
+class ConcurrentDisjointSet {
+private:
+    std::vector<std::atomic<size_t>> parent;
+public:
+    explicit ConcurrentDisjointSet(size_t size):parent(size){
+        for(size_t i = 0; i < size; ++i) {
+            parent[i].store(i,std::memory_order_relaxed);
+        }
+    }
+
+    size_t size() const noexcept {
+        return parent.size();
+    }
+
+    /**
+     * @brief Find the root of the set containing the id
+     *
+     * @param id
+     * @return size_t smallest id of the set (when no concurrent unite() is in progress)
+     */
+    size_t find(size_t id) noexcept {
+        while(true) {
+            size_t p = parent[id].load(std::memory_order_acquire);
+            if(p == id)
+                return id;
+            size_t grandParent = parent[p].load(std::memory_order_acquire);
+            if(p != grandParent)
+                parent[id].compare_exchange_weak(p,grandParent,std::memory_order_release,std::memory_order_relaxed); // path halving, failing is harmless
+            id = grandParent;
+        }
+    }
+
+    /**
+     * @brief Merge the sets containing the ids
+     *
+     * @param lhs
+     * @param rhs
+     * @return true if the ids were in different sets
+     */
+    bool unite(size_t lhs, size_t rhs) noexcept {
+        while(true) {
+            lhs = find(lhs);
+            rhs = find(rhs);
+            if(lhs == rhs)
+                return false;
+            if(lhs < rhs)
+                std::swap(lhs,rhs);
+            size_t expected = lhs;
+            if(parent[lhs].compare_exchange_strong(expected,rhs,std::memory_order_acq_rel))
+                return true; // otherwise lhs has been linked concurrently, retry with the new roots
+        }
+    }
+
+    bool sameSet(size_t lhs, size_t rhs) noexcept {
+        while(true) {
+            lhs = find(lhs);
+            rhs = find(rhs);
+            if(lhs == rhs)
+                return true;
+            if(parent[lhs].load(std::memory_order_acquire) == lhs)
+                return false; // lhs is still a root, hence the sets were disjoint at this point in time
+        }
+    }
+};
+}
+
+namespace fishnet::graph::__impl {
+/**
+ * @brief Applies the action to the index ranges [begin,end) of equally sized chunks of [0,count) concurrently
+ *
+ * @param count number of indices
+ * @param workers number of concurrent workers
+ * @param action called with (begin,end) of each chunk
+ */
+static void forEachChunkConcurrently(size_t count, size_t workers, auto const & action) {
+    workers = std::clamp<size_t>(workers,1,std::max<size_t>(count,1));
+    if(workers == 1){
+        action(size_t(0),count);
+        return;
+    }
+    std::vector<std::future<void>> futures;
+    futures.reserve(workers);
+    for(size_t worker = 0; worker < workers; ++worker) {
+        size_t begin = count * worker / workers;
+        size_t end = count * (worker+1) / workers;
+        futures.push_back(std::async(std::launch::async,[&action,begin,end](){action(begin,end);}));
+    }
+    for(auto & future: futures) {
+        future.get();
+    }
+}
+
+/**
+ * @brief Groups the ids by the root of their set. Components are ordered by their smallest id, ids within a component ascending.
+ *
+ * @param sets disjoint sets after all unions
+ * @param mapper maps an id to the output type
+ * @return std::vector<std::vector<T>> components
+ */
+template<typename T>
+static std::vector<std::vector<T>> toComponents(ConcurrentDisjointSet & sets, auto const & mapper) {
+    std::vector<std::vector<T>> components;
+    std::vector<size_t> componentOfRoot(sets.size());
+    for(size_t id = 0; id < sets.size(); ++id) {
+        size_t root = sets.find(id);
+        if(root == id){ // the root is the smallest id of the set, hence it is visited first
+            componentOfRoot[id] = components.size();
+            components.emplace_back();
+        }
+        components[componentOfRoot[root]].push_back(mapper(id));
+    }
+    return components;
+}
+
+static size_t defaultWorkers() noexcept {
+    return std::max<size_t>(std::thread::hardware_concurrency(),1);
+}
+}
+
+namespace fishnet::graph::UnionFind {
+
+/**
+ * @brief Compute the connected components of the graph given by the nodes and the edges, using a concurrent disjoint set.
+ * The edges are split into chunks processed by concurrent workers. The components contain the same nodes as BFS::connectedComponents(),
+ * ordered by the position of their first node in the range of nodes.
+ *
+ * @tparam N node type
+ * @tparam Hash hasher type on nodes
+ * @tparam Equal comparator type on nodes
+ * @param nodes range of nodes
+ * @param edges range of pairs of nodes, nodes not contained in the range of nodes are added
+ * @param workers number of concurrent workers
+ * @return std::vector<std::vector<N>> nodes of each connected component
+ */
+template<Node N, util::HashFunction<N> Hash = std::hash<N>, NodeBiPredicate<N> Equal = std::equal_to<N>>
+std::vector<std::vector<N>> connectedComponents(util::forward_range_of<N> auto const & nodes, util::forward_range_of<std::pair<N,N>> auto const & edges, size_t workers = __impl::defaultWorkers()) {
+    std::unordered_map<N,size_t,Hash,Equal> ids;
+    std::vector<N> nodeList;
+    auto idOf = [&ids,&nodeList](const N & node){
+        auto [it,inserted] = ids.try_emplace(node,nodeList.size());
+        if(inserted)
+            nodeList.push_back(node);
+        return it->second;
+    };
+    for(const auto & node: nodes) {
+        idOf(node);
+    }
+    std::vector<std::pair<size_t,size_t>> idEdges;
+    idEdges.reserve(util::size(edges));
+    for(const auto & [from,to]: edges) {
+        size_t fromId = idOf(from);
+        idEdges.emplace_back(fromId,idOf(to));
+    }
+    ConcurrentDisjointSet sets {nodeList.size()};
+    __impl::forEachChunkConcurrently(idEdges.size(),workers,[&sets,&idEdges](size_t begin, size_t end){
+        for(size_t i = begin; i < end; ++i) {
+            sets.unite(idEdges[i].first,idEdges[i].second);
+        }
+    });
+    return __impl::toComponents<N>(sets,[&nodeList](size_t id) -> const N & {return nodeList[id];});
+}
+
+/**
+ * @brief Compute the connected components of an undirected graph, using a concurrent disjoint set.
+ * Graphs providing id-based adjacencies (e.g. CSRGraph) are processed without hashing any node.
+ *
+ * @tparam G graph type
+ * @param graph undirected graph
+ * @param workers number of concurrent workers
+ * @return std::vector<std::vector<N>> nodes of each connected component
+ */
+template<Graph G> requires (not G::edge_type::isDirected())
+std::vector<std::vector<typename G::node_type>> connectedComponents(const G & graph, size_t workers = __impl::defaultWorkers()) {
+    using N = typename G::node_type;
+    if constexpr(requires (size_t id){graph.neighbourIds(id); graph.node(id); graph.size();}){
+        ConcurrentDisjointSet sets {graph.size()};
+        __impl::forEachChunkConcurrently(graph.size(),workers,[&sets,&graph](size_t begin, size_t end){
+            for(size_t from = begin; from < end; ++from) {
+                for(size_t to: graph.neighbourIds(from)) {
+                    if(from < to) // every undirected edge is stored in both directions
+                        sets.unite(from,to);
+                }
+            }
+        });
+        return __impl::toComponents<N>(sets,[&graph](size_t id) -> const N & {return graph.node(id);});
+    }else {
+        using H = G::adj_container_type::hash_function;
+        using E = G::adj_container_type::equality_predicate;
+        std::vector<std::pair<N,N>> edges;
+        for(const auto & [from,to]: graph.getAdjacencyContainer().getAdjacencyPairs()) {
+            edges.emplace_back(from,to);
+        }
+        return connectedComponents<N,H,E>(graph.getNodes(),edges,workers);
+    }
+}
+}
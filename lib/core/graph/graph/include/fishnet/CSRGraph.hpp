@@ -0,0 +1,237 @@
+#pragma once
+#include <stdexcept>
+#include <fishnet/NetworkConcepts.hpp>
+#include <fishnet/AbstractGraph.hpp>
+#include <fishnet/CSRAdjacency.hpp>
+#include <fishnet/Edge.hpp>
+
+namespace fishnet::graph::__impl {
+/**
+ * @brief Immutable graph implementation for read-mostly workloads, backed by a CSRAdjacency.
+ * The graph is built once from another graph (see GraphFactory::CSRGraph) and all modifying operations except clear() throw std::logic_error,
+ * clear() releases the whole graph (e.g. the source graph of a contraction).
+ * Besides the node-based interface of the Graph concept, nodes can be addressed by their ids, yielding O(1) neighbour ranges.
+ * Directed graphs additionally store the reversed adjacencies, such that getReachableFrom() does not scan all nodes.
+ * @tparam E edge type
+ */
+template<Edge E>
+class CSRGraph: public AbstractGraph<CSRGraph<E>,E,CSRAdjacency<typename E::node_type,typename E::hash_function,typename E::equality_predicate>> {
+public:
+    using AdjContainer = CSRAdjacency<typename E::node_type,typename E::hash_function,typename E::equality_predicate>;
+private:
+    using Base = AbstractGraph<CSRGraph<E>,E,AdjContainer>;
+    using N = Base::node_type;
+
+    AdjContainer adj;
+    std::vector<size_t> reverseOffsets; // only used for directed graphs
+    std::vector<size_t> reverseTargets;
+
+    [[noreturn]] static void immutable() {
+        throw std::logic_error("CSRGraph is immutable");
+    }
+
+    void buildReverse() {
+        if constexpr(E::isDirected()){
+            reverseOffsets.assign(adj.size()+1,0);
+            for(size_t from = 0; from < adj.size(); ++from) {
+                for(size_t to: adj.adjacentIds(from)) {
+                    ++reverseOffsets[to+1];
+                }
+            }
+            for(size_t id = 0; id < adj.size(); ++id) {
+                reverseOffsets[id+1] += reverseOffsets[id];
+            }
+            reverseTargets.resize(adj.adjacencyCount());
+            std::vector<size_t> position(reverseOffsets.begin(),reverseOffsets.end()-1);
+            for(size_t from = 0; from < adj.size(); ++from) { // ascending from ids, hence every reversed adjacency is sorted
+                for(size_t to: adj.adjacentIds(from)) {
+                    reverseTargets[position[to]++] = from;
+                }
+            }
+        }
+    }
+
+    auto toNodes(std::span<const size_t> ids) const noexcept {
+        return ids | std::views::transform([this](size_t id) -> const N & {return adj.node(id);});
+    }
+
+public:
+    CSRGraph():Base(),adj(){}
+
+    explicit CSRGraph(AdjContainer && adjContainer):Base(),adj(std::move(adjContainer)){
+        buildReverse();
+    }
+
+    CSRGraph(CSRGraph && other)noexcept:adj(std::move(other.adj)),reverseOffsets(std::move(other.reverseOffsets)),reverseTargets(std::move(other.reverseTargets)){}
+
+    CSRGraph(const CSRGraph & other):adj(other.adj),reverseOffsets(other.reverseOffsets),reverseTargets(other.reverseTargets){}
+
+    CSRGraph & operator=(CSRGraph && other)noexcept{
+        this->adj = std::move(other.adj);
+        this->reverseOffsets = std::move(other.reverseOffsets);
+        this->reverseTargets = std::move(other.reverseTargets);
+        return *this;
+    }
+
+    CSRGraph & operator=(const CSRGraph & other){
+        this->adj = other.adj;
+        this->reverseOffsets = other.reverseOffsets;
+        this->reverseTargets = other.reverseTargets;
+        return *this;
+    }
+
+    /**
+     * @brief Get the number of nodes, ids are in the range [0,size())
+     *
+     * @return size_t
+     */
+    size_t size() const noexcept {
+        return adj.size();
+    }
+
+    std::optional<size_t> id(const N & node) const noexcept {
+        return adj.id(node);
+    }
+
+    const N & node(size_t id) const noexcept {
+        return adj.node(id);
+    }
+
+    /**
+     * @brief Get the ids of the neighbours of the id in O(1)
+     *
+     * @param id
+     * @return std::span<const size_t> sorted ids
+     */
+    std::span<const size_t> neighbourIds(size_t id) const noexcept {
+        return adj.adjacentIds(id);
+    }
+
+    /**
+     * @brief Get the ids of the nodes with an edge towards the id in O(1)
+     *
+     * @param id
+     * @return std::span<const size_t> sorted ids
+     */
+    std::span<const size_t> reachableFromIds(size_t id) const noexcept {
+        if constexpr(E::isDirected()){
+            return std::span<const size_t>(reverseTargets.data()+reverseOffsets[id],reverseTargets.data()+reverseOffsets[id+1]);
+        }else {
+            return neighbourIds(id);
+        }
+    }
+
+    bool addNode(const N &){
+        immutable();
+    }
+
+    bool addNode(N &&){
+        immutable();
+    }
+
+    template<typename... Args>
+    bool addNode(const N &, Args...){
+        immutable();
+    }
+
+    bool addNodes(util::forward_range_of<N> auto &&){
+        immutable();
+    }
+
+    bool containsNode(const N & node) const noexcept {
+        return adj.contains(node);
+    }
+
+    void removeNode(const N &) {
+        immutable();
+    }
+
+    bool addEdge(const N &, const N &){
+        immutable();
+    }
+
+    bool addEdge(N &&, N &&){
+        immutable();
+    }
+
+    bool addEdge(const E &) {
+        immutable();
+    }
+
+    void addEdges(util::forward_range_of<std::pair<N,N>> auto &&){
+        immutable();
+    }
+
+    void addEdges(util::forward_range_of<E> auto &&) {
+        immutable();
+    }
+
+    bool containsEdge(const N & from, const N & to) const noexcept {
+        return adj.hasAdjacency(from,to);
+    }
+
+    bool containsEdge(const E & edge) const noexcept {
+        return containsEdge(edge.getFrom(),edge.getTo());
+    }
+
+    void removeEdge(const N &, const N &){
+        immutable();
+    }
+
+    void removeEdge(const E &){
+        immutable();
+    }
+
+    auto getNodes() const noexcept {
+        return adj.nodes();
+    }
+
+    auto getEdges() const {
+        std::vector<E> edges;
+        for(size_t from = 0; from < size(); ++from) {
+            for(size_t to : neighbourIds(from)) {
+                if(E::isDirected() || from <= to) // report undirected edges once
+                    edges.emplace_back(this->makeEdge(node(from),node(to)));
+            }
+        }
+        return edges;
+    }
+
+    auto getNeighbours(const N & node) const noexcept {
+        return adj.adjacency(node);
+    }
+
+    auto getReachableFrom(const N & node) const noexcept {
+        auto nodeId = id(node);
+        return toNodes(nodeId ? reachableFromIds(nodeId.value()) : std::span<const size_t>());
+    }
+
+    auto getOutboundEdges(const N & node) const {
+        std::vector<E> edges;
+        for(const auto & neighbour : getNeighbours(node)) {
+            edges.emplace_back(this->makeEdge(node,neighbour));
+        }
+        return edges;
+    }
+
+    auto getInboundEdges(const N & node) const {
+        std::vector<E> edges;
+        for(const auto & neighbour : getReachableFrom(node)) {
+            edges.emplace_back(this->makeEdge(neighbour,node));
+        }
+        return edges;
+    }
+
+    void clear() noexcept {
+        adj.clear();
+        reverseOffsets.clear();
+        reverseTargets.clear();
+    }
+
+    const AdjContainer & getAdjacencyContainer() const {
+        return adj;
+    }
+
+    virtual ~CSRGraph()=default;
+};
+}
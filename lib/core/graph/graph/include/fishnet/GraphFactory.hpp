@@ -1,5 +1,6 @@
 #pragma once
 #include "SimpleGraph.hpp"
+#include "CSRGraph.hpp"
 #include <fishnet/GraphModel.hpp>
 #include <fishnet/DirectedAcyclicGraph.hpp>
 
@@ -43,5 +44,18 @@ public:
     static auto DAG(){
         return DirectedAcyclicGraph(DirectedGraph<N,Hash,Equal>());
     }
+
+    /**
+     * @brief Creates an immutable copy of the graph in compressed sparse row format, for read-mostly workloads
+     * 
+     * @param source graph to copy
+     * @return CSRGraph with the same edge type as the source graph
+     */
+    template<Graph G>
+    static auto CSRGraph(const G & source){
+        using E = typename G::edge_type;
+        using AdjacencyContainer_t = typename graph::__impl::CSRGraph<E>::AdjContainer;
+        return graph::__impl::CSRGraph<E>(AdjacencyContainer_t(source.getAdjacencyContainer()));
+    }
 };
 }
\ No newline at end of file
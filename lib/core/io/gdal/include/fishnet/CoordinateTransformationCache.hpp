@@ -0,0 +1,84 @@
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <stdexcept>
+#include "gdal/ogr_spatialref.h"
+#include "gdal/cpl_conv.h"
+
+namespace fishnet {
+
+/**
+ * @brief Cache of OGR coordinate transformations keyed by their source and target spatial reference (as WKT).
+ * Creating a transformation sets up a PROJ pipeline, which is orders of magnitude more expensive than transforming a few points.
+ * Transformations are not thread-safe, therefore each thread uses its own cache (see threadLocal()).
+ */
+class CoordinateTransformationCache {
+private:
+    struct TransformationDeleter {
+        void operator()(OGRCoordinateTransformation * transformation) const noexcept {
+            OGRCoordinateTransformation::DestroyCT(transformation);
+        }
+    };
+    using Key = std::pair<std::string,std::string>;
+    std::map<Key,std::unique_ptr<OGRCoordinateTransformation,TransformationDeleter>> transformations;
+    size_t clearCount = 0;
+
+    static std::string toWkt(const OGRSpatialReference & spatialReference) {
+        char * wkt = nullptr;
+        spatialReference.exportToWkt(&wkt);
+        std::string result = wkt ? wkt : "";
+        CPLFree(wkt);
+        return result;
+    }
+
+public:
+    /**
+     * @brief Get the transformation from the source to the target spatial reference, creating it on the first request
+     * @throws runtime_error if the transformation can not be created
+     * @param source source spatial reference
+     * @param target target spatial reference
+     * @return OGRCoordinateTransformation& transformation owned by the cache
+     */
+    OGRCoordinateTransformation & get(const OGRSpatialReference & source, const OGRSpatialReference & target) {
+        Key key {toWkt(source)+std::to_string(int(source.GetAxisMappingStrategy())),toWkt(target)+std::to_string(int(target.GetAxisMappingStrategy()))};
+        auto it = transformations.find(key);
+        if(it == transformations.end()){
+            OGRCoordinateTransformation * transformation = OGRCreateCoordinateTransformation(&source,&target);
+            if(not transformation)
+                throw std::runtime_error("Could not create coordinate transformation");
+            it = transformations.try_emplace(std::move(key),transformation).first;
+        }
+        return *it->second;
+    }
+
+    size_t size() const noexcept {
+        return transformations.size();
+    }
+
+    void clear() noexcept {
+        transformations.clear();
+        ++clearCount;
+    }
+
+    /**
+     * @brief Get the number of clear() calls, which invalidate all references to transformations obtained from the cache before
+     *
+     * @return size_t
+     */
+    size_t generation() const noexcept {
+        return clearCount;
+    }
+
+    /**
+     * @brief Get the cache of the calling thread
+     *
+     * @return CoordinateTransformationCache&
+     */
+    static CoordinateTransformationCache & threadLocal() noexcept {
+        thread_local CoordinateTransformationCache cache;
+        return cache;
+    }
+};
+}
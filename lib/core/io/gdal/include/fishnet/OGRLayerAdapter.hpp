@@ -1,3 +1,5 @@
+#pragma once
+#include <optional>
 #include <fishnet/VectorLayer.hpp>
 #include <gdal/gdal.h>
 #include <gdal/ogr_core.h>
@@ -62,55 +64,78 @@ private:
     };
 public:
     /**
-     * @brief Converts an OGRLayer to a fishnet::VectorLayer
+     * @brief Creates an empty fishnet::VectorLayer with the fields and the spatial reference of the OGRLayer
      * 
      * @param ogrLayer pointer to the OGRLayer
-     * @return util::Either<VectorLayer<G>, std::string> VectorLayer if successful, error message otherwise
+     * @return VectorLayer<G> layer without features
      */
-    static util::Either<VectorLayer<G>, std::string> fromOGR(OGRLayer * ogrLayer){
-        if(ogrLayer == nullptr)
-            return std::unexpected("Could not read from OGRLayer, pointer is null");
+    static VectorLayer<G> schemaFromOGR(OGRLayer * ogrLayer){
         VectorLayer<G> layer {};
         OGRFeatureDefn * layerDef = ogrLayer->GetLayerDefn();
         for(int i = 0; i < layerDef->GetFieldCount();i++) {
             addOGRField(layer, layerDef->GetFieldDefn(i),i);
         }
-        for(const auto & ogrFeature: ogrLayer){
-            auto geo = ogrFeature->GetGeometryRef();
-            if constexpr(G::type == fishnet::geometry::GeometryType::MULTIPOLYGON){
-                if(geo && wkbFlatten(geo->getGeometryType()) == GeometryTypeWKBAdapter::toWKB(G::polygon_type::type)) {
-                    auto converted = OGRGeometryAdapter::fromOGR<G::polygon_type::type>(*geo);
-                    if (not converted) 
-                        continue;
-                    Feature<G> f {{converted.value()}};
-                    for(const auto & [_,fieldDefinition]: layer.getFieldsMap()){
-                        std::visit(AddAttributeVisitor(&f,ogrFeature.get()),fieldDefinition);
-                    }
-                    layer.addFeature(std::move(f));
-                }                
-            }
-            if(geo && wkbFlatten(geo->getGeometryType()) == GeometryTypeWKBAdapter::toWKB(G::type)) {
-                auto converted = OGRGeometryAdapter::fromOGR<G::type>(*geo);
-                if (not converted) 
-                    continue;
-                Feature<G> f {converted.value()};
-                for(const auto & [_,fieldDefinition]: layer.getFieldsMap()){
-                    std::visit(AddAttributeVisitor(&f,ogrFeature.get()),fieldDefinition);
-                }
-                layer.addFeature(std::move(f));
+        if(ogrLayer->GetSpatialRef())
+            layer.setSpatialReference(*ogrLayer->GetSpatialRef());
+        return layer;
+    }
+
+    /**
+     * @brief Converts an OGRFeature to a fishnet::Feature, with the attributes of all fields of the schema
+     * 
+     * @param ogrFeature feature to be converted
+     * @param schema layer providing the field definitions, see schemaFromOGR()
+     * @return std::optional<Feature<G>> feature if its geometry is of type G (or a polygon for multi-polygon layers) and valid, otherwise empty
+     */
+    static std::optional<Feature<G>> featureFromOGR(OGRFeature & ogrFeature, const VectorLayer<G> & schema){
+        auto geo = ogrFeature.GetGeometryRef();
+        if(not geo)
+            return std::nullopt;
+        std::optional<Feature<G>> feature;
+        if constexpr(G::type == fishnet::geometry::GeometryType::MULTIPOLYGON){
+            if(wkbFlatten(geo->getGeometryType()) == GeometryTypeWKBAdapter::toWKB(G::polygon_type::type)) {
+                auto converted = OGRGeometryAdapter::fromOGR<G::polygon_type::type>(*geo);
+                if (converted) 
+                    feature.emplace(G{converted.value()});
+            }                
+        }
+        if(wkbFlatten(geo->getGeometryType()) == GeometryTypeWKBAdapter::toWKB(G::type)) {
+            auto converted = OGRGeometryAdapter::fromOGR<G::type>(*geo);
+            if (converted) 
+                feature.emplace(converted.value());
+        }
+        if(feature) {
+            for(const auto & [_,fieldDefinition]: schema.getFieldsMap()){
+                std::visit(AddAttributeVisitor(&feature.value(),&ogrFeature),fieldDefinition);
             }
         }
-        layer.setSpatialReference(*ogrLayer->GetSpatialRef()->Clone());
+        return feature;
+    }
+
+    /**
+     * @brief Converts an OGRLayer to a fishnet::VectorLayer
+     * 
+     * @param ogrLayer pointer to the OGRLayer
+     * @return util::Either<VectorLayer<G>, std::string> VectorLayer if successful, error message otherwise
+     */
+    static util::Either<VectorLayer<G>, std::string> fromOGR(OGRLayer * ogrLayer){
+        if(ogrLayer == nullptr)
+            return std::unexpected("Could not read from OGRLayer, pointer is null");
+        VectorLayer<G> layer = schemaFromOGR(ogrLayer);
+        for(const auto & ogrFeature: ogrLayer){
+            auto feature = featureFromOGR(*ogrFeature,layer);
+            if(feature)
+                layer.addFeature(std::move(feature.value()));
+        }
         return layer;
     }
     /**
-     * @brief Converts a fishnet::VectorLayer to an OGRLayer
+     * @brief Creates the fields of the fishnet::VectorLayer on the OGRLayer
      * 
-     * @param layer vector layer to be converted    
+     * @param layer vector layer providing the field definitions
      * @param outputLayer inout parameter, should be already created with the correct geometry type and spatial reference
-     * @return util::Either<OGRLayer, std::string> OGRLayer if successful, error message otherwise
      */
-    static util::Either<OGRLayer *, std::string> toOGR(const VectorLayer<G> & layer, OGRLayer * outputLayer){
+    static void schemaToOGR(const VectorLayer<G> & layer, OGRLayer * outputLayer){
         for(const auto & [fieldName,fieldDefinition] :  layer.getFieldsMap()) {
             OGRFieldType fieldType;
             // get OGRFieldType from FieldDefinition<T> type -> T
@@ -122,26 +147,48 @@ public:
             fieldDefn.SetPrecision(20);
             outputLayer->CreateField(&fieldDefn); // add OGRFieldDefinition to output layer
         }
-        for(const auto & f : layer.getFeatures()){
-            auto * feature = new OGRFeature(outputLayer->GetLayerDefn());
-            feature->SetGeometry(OGRGeometryAdapter::toOGR(f.getGeometry()).get());
+    }
 
-            for(const auto & [fieldName,fieldDefinition]: layer.getFieldsMap()){
-                // visitor to set attributes for OGRFeature
-                std::visit([&fieldName,&f,feature]( auto && var){
-                    auto optionalAttribute = f.getAttribute(var);
-                    if(optionalAttribute)
-                        OGRFieldAdapter::setFieldValue(feature, fieldName, optionalAttribute.value());
-                },fieldDefinition);
+    /**
+     * @brief Writes a fishnet::Feature to the OGRLayer, with the attributes of all fields of the schema
+     * 
+     * @param f feature to be written
+     * @param schema layer providing the field definitions, see schemaToOGR()
+     * @param outputLayer inout parameter, fields must be already created by schemaToOGR()
+     * @return util::Either<OGRLayer *, std::string> OGRLayer if successful, error message otherwise
+     */
+    static util::Either<OGRLayer *, std::string> featureToOGR(const Feature<G> & f, const VectorLayer<G> & schema, OGRLayer * outputLayer){
+        OGRFeature feature {outputLayer->GetLayerDefn()};
+        feature.SetGeometry(OGRGeometryAdapter::toOGR(f.getGeometry()).get());
+        for(const auto & [fieldName,fieldDefinition]: schema.getFieldsMap()){
+            // visitor to set attributes for OGRFeature
+            std::visit([&fieldName,&f,&feature]( auto && var){
+                auto optionalAttribute = f.getAttribute(var);
+                if(optionalAttribute)
+                    OGRFieldAdapter::setFieldValue(&feature, fieldName, optionalAttribute.value());
+            },fieldDefinition);
+        }
+        if(outputLayer->CreateFeature(&feature) != OGRERR_NONE){
+            return std::unexpected("Could not write Geometry: "+f.getGeometry().toString());
+        }
+        return outputLayer;
+    }
 
-            }
-            OGRErr success = outputLayer->CreateFeature(feature);
-            if(success != 0){
-                return std::unexpected("Could not write Geometry: "+f.getGeometry().toString());
-            }
+    /**
+     * @brief Converts a fishnet::VectorLayer to an OGRLayer
+     * 
+     * @param layer vector layer to be converted    
+     * @param outputLayer inout parameter, should be already created with the correct geometry type and spatial reference
+     * @return util::Either<OGRLayer, std::string> OGRLayer if successful, error message otherwise
+     */
+    static util::Either<OGRLayer *, std::string> toOGR(const VectorLayer<G> & layer, OGRLayer * outputLayer){
+        schemaToOGR(layer,outputLayer);
+        for(const auto & f : layer.getFeatures()){
+            auto result = featureToOGR(f,layer,outputLayer);
+            if(not result)
+                return result;
         }
         return outputLayer;
-        
     }
 };
 }
\ No newline at end of file
@@ -0,0 +1,240 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include <numbers>
+#include <algorithm>
+#include <fishnet/Vec2D.hpp>
+#include <fishnet/LinearGeometry.hpp>
+#include <fishnet/CollectionConcepts.hpp>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define FISHNET_WGS84_AVX2 1
+#endif
+
+namespace fishnet {
+/**
+ * @brief Precomputed sine and cosine of the half latitude and half longitude of points in (longitude,latitude), stored as structure of arrays.
+ * With these, the terms of the distance formula of WGS84Ellipsoid::distance() are obtained by the angle addition theorems,
+ * such that the distance of a pair of points requires no further sine or cosine.
+ */
+class WGS84PointCache {
+public:
+    struct HalfAngles {
+        double sinLat;
+        double cosLat;
+        double sinLon;
+        double cosLon;
+
+        HalfAngles(double longitude, double latitude) noexcept {
+            constexpr static double halfDegreeInRadians = std::numbers::pi / 360;
+            sinLat = std::sin(latitude * halfDegreeInRadians);
+            cosLat = std::cos(latitude * halfDegreeInRadians);
+            sinLon = std::sin(longitude * halfDegreeInRadians);
+            cosLon = std::cos(longitude * halfDegreeInRadians);
+        }
+    };
+private:
+    std::vector<double> sinLat;
+    std::vector<double> cosLat;
+    std::vector<double> sinLon;
+    std::vector<double> cosLon;
+public:
+    WGS84PointCache() = default;
+
+    explicit WGS84PointCache(util::forward_range_of<geometry::Vec2DReal> auto const & points) {
+        reserve(util::size(points));
+        for(const auto & p: points) {
+            add(p);
+        }
+    }
+
+    void add(geometry::IPoint auto const & point) {
+        HalfAngles angles {double(point.x),double(point.y)};
+        sinLat.push_back(angles.sinLat);
+        cosLat.push_back(angles.cosLat);
+        sinLon.push_back(angles.sinLon);
+        cosLon.push_back(angles.cosLon);
+    }
+
+    void reserve(size_t capacity) {
+        sinLat.reserve(capacity);
+        cosLat.reserve(capacity);
+        sinLon.reserve(capacity);
+        cosLon.reserve(capacity);
+    }
+
+    size_t size() const noexcept {
+        return sinLat.size();
+    }
+
+    bool empty() const noexcept {
+        return sinLat.empty();
+    }
+
+    const double * sinHalfLatitudes() const noexcept {
+        return sinLat.data();
+    }
+
+    const double * cosHalfLatitudes() const noexcept {
+        return cosLat.data();
+    }
+
+    const double * sinHalfLongitudes() const noexcept {
+        return sinLon.data();
+    }
+
+    const double * cosHalfLongitudes() const noexcept {
+        return cosLon.data();
+    }
+
+    HalfAngles operator[](size_t index) const noexcept {
+        HalfAngles angles {0,0};
+        angles.sinLat = sinLat[index];
+        angles.cosLat = cosLat[index];
+        angles.sinLon = sinLon[index];
+        angles.cosLon = cosLon[index];
+        return angles;
+    }
+};
+}
+
+/**
+ * @brief Batched kernels of the distance formula used in WGS84Ellipsoid::distance(), computing the distances from one point to many points.
+ * The AVX2 kernel is selected at runtime if supported by the CPU, otherwise the scalar kernel is used.
+ */
+namespace fishnet::__impl::wgs84 {
+/**
+ * @brief Distance of a single pair, given the half angles of both points
+ */
+static double distance(const WGS84PointCache::HalfAngles & a, double sinLat, double cosLat, double sinLon, double cosLon, double radius, double flattening, bool exact) noexcept {
+    double sinG = a.sinLat * cosLat - a.cosLat * sinLat; // G = (phiA - phiB) / 2
+    double cosG = a.cosLat * cosLat + a.sinLat * sinLat;
+    double sinF = a.sinLat * cosLat + a.cosLat * sinLat; // F = (phiA + phiB) / 2
+    double cosF = a.cosLat * cosLat - a.sinLat * sinLat;
+    double sinL = a.sinLon * cosLon - a.cosLon * sinLon; // l = (lambdaA - lambdaB) / 2
+    double cosL = a.cosLon * cosLon + a.sinLon * sinLon;
+    double sinG2 = sinG*sinG, cosG2 = cosG*cosG, sinF2 = sinF*sinF, cosF2 = cosF*cosF, sinL2 = sinL*sinL, cosL2 = cosL*cosL;
+    double S = sinG2 * cosL2 + cosF2 * sinL2;
+    double C = cosG2 * cosL2 + sinF2 * sinL2;
+    if(S == 0)
+        return 0;
+    double w = std::atan(std::sqrt(S / C));
+    double distance = 2 * w * radius;
+    if(not exact)
+        return distance;
+    double T = std::sqrt(S * C) / w;
+    double h1 = (3 * T - 1) / (2 * C);
+    double h2 = (3 * T + 1) / (2 * S);
+    return distance * (1 + flattening * h1 * sinF2 * cosG2 - flattening * h2 * cosF2 * sinG2);
+}
+
+static void distancesScalar(const WGS84PointCache::HalfAngles & a, const WGS84PointCache & points, size_t begin, double * out, double radius, double flattening, bool exact) noexcept {
+    for(size_t i = begin; i < points.size(); ++i) {
+        out[i] = distance(a,points.sinHalfLatitudes()[i],points.cosHalfLatitudes()[i],points.sinHalfLongitudes()[i],points.cosHalfLongitudes()[i],radius,flattening,exact);
+    }
+}
+
+#ifdef FISHNET_WGS84_AVX2
+/**
+ * @brief Vectorized arcus tangent for non-negative arguments, using the range reduction and rational approximation of the Cephes library:
+ * https://github.com/jeremybarnes/cephes/blob/master/cmath/atan.c
+ */
+__attribute__((target("avx2")))
+static __m256d atanNonNegative(__m256d x) noexcept {
+    const __m256d tan3PiOver8 = _mm256_set1_pd(2.41421356237309504880);
+    const __m256d threshold = _mm256_set1_pd(0.66);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d moreBits = _mm256_set1_pd(6.123233995736765886130E-17);
+    __m256d big = _mm256_cmp_pd(x,tan3PiOver8,_CMP_GT_OQ);
+    __m256d mid = _mm256_andnot_pd(big,_mm256_cmp_pd(x,threshold,_CMP_GT_OQ));
+    __m256d reduced = _mm256_blendv_pd(x,_mm256_div_pd(_mm256_sub_pd(x,one),_mm256_add_pd(x,one)),mid);
+    reduced = _mm256_blendv_pd(reduced,_mm256_div_pd(_mm256_set1_pd(-1.0),x),big);
+    __m256d offset = _mm256_blendv_pd(_mm256_setzero_pd(),_mm256_set1_pd(std::numbers::pi/4),mid);
+    offset = _mm256_blendv_pd(offset,_mm256_set1_pd(std::numbers::pi/2),big);
+    __m256d correction = _mm256_blendv_pd(_mm256_setzero_pd(),_mm256_mul_pd(_mm256_set1_pd(0.5),moreBits),mid);
+    correction = _mm256_blendv_pd(correction,moreBits,big);
+    __m256d z = _mm256_mul_pd(reduced,reduced);
+    __m256d p = _mm256_set1_pd(-8.750608600031904122785E-1);
+    for(double coefficient: {-1.615753718733365076637E1,-7.500855792314704667340E1,-1.228866684490136173410E2,-6.485021904942025371773E1}) {
+        p = _mm256_add_pd(_mm256_mul_pd(p,z),_mm256_set1_pd(coefficient));
+    }
+    __m256d q = _mm256_add_pd(z,_mm256_set1_pd(2.485846490142306297962E1));
+    for(double coefficient: {1.650270098316988542046E2,4.328810604912902668951E2,4.853903996359136964868E2,1.945506571482613964425E2}) {
+        q = _mm256_add_pd(_mm256_mul_pd(q,z),_mm256_set1_pd(coefficient));
+    }
+    __m256d result = _mm256_div_pd(_mm256_mul_pd(z,p),q);
+    result = _mm256_add_pd(_mm256_mul_pd(reduced,result),reduced);
+    return _mm256_add_pd(offset,_mm256_add_pd(result,correction));
+}
+
+/**
+ * @brief AVX2 kernel processing four points at once, the remainder is processed by the scalar kernel
+ */
+__attribute__((target("avx2")))
+static void distancesAVX2(const WGS84PointCache::HalfAngles & a, const WGS84PointCache & points, double * out, double radius, double flattening, bool exact) noexcept {
+    const __m256d aSinLat = _mm256_set1_pd(a.sinLat), aCosLat = _mm256_set1_pd(a.cosLat);
+    const __m256d aSinLon = _mm256_set1_pd(a.sinLon), aCosLon = _mm256_set1_pd(a.cosLon);
+    const __m256d one = _mm256_set1_pd(1.0), two = _mm256_set1_pd(2.0), three = _mm256_set1_pd(3.0);
+    const __m256d vRadius = _mm256_set1_pd(2 * radius), vFlattening = _mm256_set1_pd(flattening);
+    const __m256d zero = _mm256_setzero_pd();
+    size_t i = 0;
+    for(; i + 4 <= points.size(); i += 4) {
+        __m256d sinLat = _mm256_loadu_pd(points.sinHalfLatitudes()+i), cosLat = _mm256_loadu_pd(points.cosHalfLatitudes()+i);
+        __m256d sinLon = _mm256_loadu_pd(points.sinHalfLongitudes()+i), cosLon = _mm256_loadu_pd(points.cosHalfLongitudes()+i);
+        __m256d sinG = _mm256_sub_pd(_mm256_mul_pd(aSinLat,cosLat),_mm256_mul_pd(aCosLat,sinLat));
+        __m256d cosG = _mm256_add_pd(_mm256_mul_pd(aCosLat,cosLat),_mm256_mul_pd(aSinLat,sinLat));
+        __m256d sinF = _mm256_add_pd(_mm256_mul_pd(aSinLat,cosLat),_mm256_mul_pd(aCosLat,sinLat));
+        __m256d cosF = _mm256_sub_pd(_mm256_mul_pd(aCosLat,cosLat),_mm256_mul_pd(aSinLat,sinLat));
+        __m256d sinL = _mm256_sub_pd(_mm256_mul_pd(aSinLon,cosLon),_mm256_mul_pd(aCosLon,sinLon));
+        __m256d cosL = _mm256_add_pd(_mm256_mul_pd(aCosLon,cosLon),_mm256_mul_pd(aSinLon,sinLon));
+        __m256d sinG2 = _mm256_mul_pd(sinG,sinG), cosG2 = _mm256_mul_pd(cosG,cosG);
+        __m256d sinF2 = _mm256_mul_pd(sinF,sinF), cosF2 = _mm256_mul_pd(cosF,cosF);
+        __m256d sinL2 = _mm256_mul_pd(sinL,sinL), cosL2 = _mm256_mul_pd(cosL,cosL);
+        __m256d S = _mm256_add_pd(_mm256_mul_pd(sinG2,cosL2),_mm256_mul_pd(cosF2,sinL2));
+        __m256d C = _mm256_add_pd(_mm256_mul_pd(cosG2,cosL2),_mm256_mul_pd(sinF2,sinL2));
+        __m256d w = atanNonNegative(_mm256_sqrt_pd(_mm256_div_pd(S,C)));
+        __m256d distance = _mm256_mul_pd(w,vRadius);
+        if(exact) {
+            __m256d T = _mm256_div_pd(_mm256_sqrt_pd(_mm256_mul_pd(S,C)),w);
+            __m256d h1 = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(three,T),one),_mm256_mul_pd(two,C));
+            __m256d h2 = _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(three,T),one),_mm256_mul_pd(two,S));
+            __m256d correction = _mm256_sub_pd(
+                _mm256_add_pd(one,_mm256_mul_pd(_mm256_mul_pd(vFlattening,h1),_mm256_mul_pd(sinF2,cosG2))),
+                _mm256_mul_pd(_mm256_mul_pd(vFlattening,h2),_mm256_mul_pd(cosF2,sinG2))
+            );
+            distance = _mm256_mul_pd(distance,correction);
+        }
+        distance = _mm256_blendv_pd(distance,zero,_mm256_cmp_pd(S,zero,_CMP_EQ_OQ)); // identical points
+        _mm256_storeu_pd(out+i,distance);
+    }
+    distancesScalar(a,points,i,out,radius,flattening,exact);
+}
+
+static bool supportsAVX2() noexcept {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+/**
+ * @brief Computes the distances from the point a to all cached points
+ *
+ * @param a half angles of the point
+ * @param points cached points
+ * @param out output array with space for points.size() distances
+ * @param radius radius of the ellipsoid
+ * @param flattening flattening of the ellipsoid
+ * @param exact applies the correction for the flattening
+ * @param vectorized use the AVX2 kernel if supported
+ */
+static void distances(const WGS84PointCache::HalfAngles & a, const WGS84PointCache & points, double * out, double radius, double flattening, bool exact, bool vectorized = true) noexcept {
+#ifdef FISHNET_WGS84_AVX2
+    if(vectorized && supportsAVX2()) {
+        distancesAVX2(a,points,out,radius,flattening,exact);
+        return;
+    }
+#endif
+    distancesScalar(a,points,0,out,radius,flattening,exact);
+}
+}
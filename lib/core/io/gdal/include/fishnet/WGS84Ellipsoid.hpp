@@ -1,143 +1,391 @@
-#pragma once
-#include <math.h>
-#include <fishnet/Constants.hpp>
-#include <fishnet/Radians.hpp>
-#include <fishnet/Degrees.hpp>
-#include <fishnet/Angle.hpp>
-#include <fishnet/GeometryObject.hpp>
-#include <fishnet/Ring.hpp>
-#include <fishnet/Polygon.hpp>
-#include <fishnet/SimplePolygon.hpp>
-#include <algorithm>
-#include <ranges>
-#include "gdal/gdal.h"
-#include "gdal/ogr_geometry.h"
-#include "gdal/ogr_spatialref.h"
-#include "OGRGeometryAdapter.hpp"
-
-namespace fishnet {
-
-/**
- * @brief Utility class for computing distances and areas in metric units for GIS data using the WGS84 Spatial Reference System
- * 
- */
-class WGS84Ellipsoid {
-private:
-    static double cos2(double angle) {
-        return pow(cos((math::PI / 180) * angle), 2);
-    }
-
-    static double cos2(math::Degrees angle){
-        return pow(angle.cos(), 2);
-    }
-
-    static double sin2(double angle) {
-        return pow(sin((math::PI / 180) * angle), 2);
-    }
-
-    static double sin2(math::Degrees angle){
-        return pow(angle.sin(), 2);
-    }
-
-    /**
-     * @brief Projection to metric coordiante system
-     * @deprecated 
-     * @param ring ring to be projected
-     * @return object fulfilling the IRing concept
-     */
-    static auto projectToEckertIV(geometry::IRing auto const & ring) noexcept {
-        OGRSpatialReference targetRef = OGRSpatialReference();
-        targetRef.SetEckertIV(ring.centroid().x, 0, 0);
-        OGRCoordinateTransformation *transformation = OGRCreateCoordinateTransformation(&spatialReference, &targetRef);
-        auto ogrPolygonPointer = OGRGeometryAdapter::toOGR(ring);
-        ogrPolygonPointer->transform(transformation);
-        OCTDestroyCoordinateTransformation(transformation);
-        return OGRGeometryAdapter::fromOGR(*ogrPolygonPointer).value();
-    }
-
-    static inline OGRSpatialReference initWGS84(){
-        OGRSpatialReference wgs84 = OGRSpatialReference();
-        wgs84.importFromEPSG(4326);
-        return wgs84;
-    }
-
-public:
-    constexpr static double flattening = 1.0 / 298.257223563; // Flattening of the Earth: https://en.wikipedia.org/wiki/Earth_ellipsoid
-    constexpr static double radiusInMeter = 6378137; //Earth radius in m;
-    static inline OGRSpatialReference spatialReference = initWGS84();
-
-    /**
-     *
-     * @param lambdaA longitude of point A
-     * @param phiA latitude of point A
-     * @param lambdaB longitude of point B
-     * @param phiB latitude of point B
-     * @param exact applies additional correction for the distances
-     * For further reading consider: https://de.wikipedia.org/wiki/Orthodrome
-     * @return distance between A and B in meters
-     */
-    static double distance(double lambdaA, double phiA, double lambdaB, double phiB, bool exact = true) {
-        math::Degrees F = math::Degrees((phiA + phiB) / 2);
-        math::Degrees G = math::Degrees((phiA - phiB) / 2);
-        math::Degrees l = math::Degrees((lambdaA - lambdaB) / 2);
-        double S = sin2(G) * cos2(l) + cos2(F) * sin2(l);
-        double C = cos2(G) * cos2(l) + sin2(F) * sin2(l);
-        math::Radians w = math::Radians::atan(sqrt(S / C));
-        double distance = 2 * w.getAngleValue() * radiusInMeter;
-        if (not exact) {
-            return distance;
-        } else {
-            double T = sqrt(S * C) / w.getAngleValue();
-            double h1 = (3 * T - 1) / (2 * C);
-            double h2 = (3 * T + 1) / (2 * S);
-            double correction = (1 + flattening * h1 * sin2(F) * cos2(G) -
-                                 flattening * h2 * cos2(F) * sin2(G));
-            return distance * correction;
-        }
-    }
-
-    /**
-     * @brief Compute the distance between two points in metric units
-     * 
-     * @param p point (long,lat)
-     * @param q point (long,lat)
-     * @param exact applies additional correction for the distances
-     * @return distance between p and q in meters
-     */
-    static double distance(geometry::IPoint auto const & p, geometry::IPoint auto const & q,bool exact = true)noexcept{
-        return distance(p.x, p.y, q.x, q.y, exact);
-    }
-
-    /**
-     * Calculate the area of a Polygon in m² by projection
-     * @param polygon source polygon
-     * @deprecated
-     * @return area in m²
-     */
-    static double area(geometry::IPolygon auto const & polygon)noexcept{
-        return geometry::Polygon(projectToEckertIV(polygon.getBoundary()), std::views::transform(polygon.getHoles(), [](const auto & ring){ return projectToEckertIV(
-                ring);})).area();
-    }
-
-    /**
-     * @brief 
-     * @deprecated
-     * @param ring 
-     * @return double 
-     */
-    static double area(geometry::IRing auto const & ring) noexcept {
-        return projectToEckertIV(ring).area();
-    }
-    
-    /**
-     * @brief 
-     * @deprecated
-     * @param ring 
-     * @return double 
-     */
-    template<typename T>
-    static double area(geometry::SimplePolygon<T> const & polygon) noexcept {
-        return area(polygon.getBoundary());
-    }
-};
-}
+#pragma once
+#include <math.h>
+#include <fishnet/Constants.hpp>
+#include <fishnet/Radians.hpp>
+#include <fishnet/Degrees.hpp>
+#include <fishnet/Angle.hpp>
+#include <fishnet/Vec2D.hpp>
+#include <fishnet/LinearGeometry.hpp>
+#include <fishnet/CollectionConcepts.hpp>
+#include <fishnet/Ring.hpp>
+#include <fishnet/Polygon.hpp>
+#include <fishnet/SimplePolygon.hpp>
+#include <algorithm>
+#include <ranges>
+#include <array>
+#include <map>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <numeric>
+#include <optional>
+#include "gdal/gdal.h"
+#include "gdal/ogr_geometry.h"
+#include "gdal/ogr_spatialref.h"
+#include "OGRGeometryAdapter.hpp"
+#include "CoordinateTransformationCache.hpp"
+#include "WGS84DistanceKernel.hpp"
+
+namespace fishnet {
+
+/**
+ * @brief Utility class for computing distances and areas in metric units for GIS data using the WGS84 Spatial Reference System
+ * 
+ */
+class WGS84Ellipsoid {
+private:
+    static double cos2(double angle) {
+        return pow(cos((math::PI / 180) * angle), 2);
+    }
+
+    static double cos2(math::Degrees angle){
+        return pow(angle.cos(), 2);
+    }
+
+    static double sin2(double angle) {
+        return pow(sin((math::PI / 180) * angle), 2);
+    }
+
+    static double sin2(math::Degrees angle){
+        return pow(angle.sin(), 2);
+    }
+
+    /**
+     * @brief Get the cached transformation from WGS84 to the Eckert IV projection, centered at the central meridian.
+     * Eckert IV is an equal-area projection, hence the central meridian is rounded to whole degrees to share the transformations
+     * between nearby geometries without affecting the projected areas.
+     * @param centralMeridian longitude of the center of the projected geometries
+     * @return OGRCoordinateTransformation& transformation owned by the CoordinateTransformationCache of the calling thread
+     */
+    static OGRCoordinateTransformation & eckertIVTransformation(double centralMeridian) {
+        int meridian = std::clamp(int(std::lround(centralMeridian)),-180,180);
+        auto & cache = CoordinateTransformationCache::threadLocal();
+        // lookup table for the transformations owned by the cache, invalidated when the cache is cleared
+        thread_local std::array<OGRCoordinateTransformation *,361> transformations {};
+        thread_local size_t generation = cache.generation();
+        if(generation != cache.generation()) {
+            transformations.fill(nullptr);
+            generation = cache.generation();
+        }
+        auto & transformation = transformations[meridian+180];
+        if(not transformation) {
+            OGRSpatialReference source = spatialReference;
+            source.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER); // points are stored as (longitude,latitude)
+            OGRSpatialReference targetRef = OGRSpatialReference();
+            targetRef.SetEckertIV(meridian, 0, 0);
+            targetRef.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+            transformation = &cache.get(source,targetRef);
+        }
+        return *transformation;
+    }
+
+    /**
+     * @brief Rings in (longitude,latitude), batched by the central meridian of their projection.
+     * Each batch is projected to Eckert IV with a single transformation call.
+     */
+    class EckertIVBatches {
+    private:
+        struct Batch {
+            std::vector<double> x;
+            std::vector<double> y;
+            std::vector<std::pair<size_t,size_t>> rings; // (index of the ring, offset of its first point)
+        };
+        std::map<int,Batch> batches;
+        size_t count = 0;
+
+        static double shoelace(const double * x, const double * y, size_t size) noexcept {
+            double doubleArea = 0;
+            for(size_t i = 0, j = size-1; i < size; j = i++) {
+                doubleArea += (x[j] + x[i]) * (y[j] - y[i]);
+            }
+            return std::abs(doubleArea) / 2;
+        }
+    public:
+        void add(geometry::IRing auto const & ring) {
+            auto && points = ring.getPoints();
+            auto & batch = batches[int(std::lround((*std::ranges::begin(points)).x))];
+            batch.rings.emplace_back(count++,batch.x.size());
+            for(const auto & p: points) {
+                batch.x.push_back(double(p.x));
+                batch.y.push_back(double(p.y));
+            }
+        }
+
+        /**
+         * @brief Project all rings and compute their area
+         *
+         * @return std::vector<double> area in m² of each ring in order of insertion, NaN if the projection failed
+         */
+        std::vector<double> areas() {
+            std::vector<double> areas(count,std::numeric_limits<double>::quiet_NaN());
+            for(auto & [meridian,batch]: batches) {
+                std::vector<int> success(batch.x.size(),FALSE);
+                try{
+                    eckertIVTransformation(meridian).Transform(batch.x.size(),batch.x.data(),batch.y.data(),nullptr,success.data());
+                }catch(const std::runtime_error &){
+                    continue;
+                }
+                for(size_t i = 0; i < batch.rings.size(); ++i) {
+                    auto [index,offset] = batch.rings[i];
+                    size_t end = i+1 < batch.rings.size() ? batch.rings[i+1].second : batch.x.size();
+                    if(std::all_of(success.begin()+offset,success.begin()+end,[](int pointSuccess){return pointSuccess;}))
+                        areas[index] = shoelace(batch.x.data()+offset,batch.y.data()+offset,end-offset);
+                }
+            }
+            return areas;
+        }
+    };
+
+    /**
+     * @brief Decides whether the distance() between two points is at most maxDistance by localTangentPlaneDistance()
+     * @return std::optional<bool> the decision, empty if the error bound of the approximation is inconclusive
+     */
+    static std::optional<bool> withinLocalTangentPlaneDistance(geometry::IPoint auto const & p, geometry::IPoint auto const & q, double maxDistance) noexcept {
+        double approximation = localTangentPlaneDistance(p,q);
+        double error = localTangentPlaneRelativeError(approximation,std::max(std::abs(double(p.y)),std::abs(double(q.y))));
+        if(error < 0.5) {
+            if(approximation / (1 - error) <= maxDistance)
+                return true;
+            if(approximation / (1 + error) > maxDistance)
+                return false;
+        }
+        return std::nullopt;
+    }
+
+    static inline OGRSpatialReference initWGS84(){
+        OGRSpatialReference wgs84 = OGRSpatialReference();
+        wgs84.importFromEPSG(4326);
+        return wgs84;
+    }
+
+public:
+    constexpr static double flattening = 1.0 / 298.257223563; // Flattening of the Earth: https://en.wikipedia.org/wiki/Earth_ellipsoid
+    constexpr static double radiusInMeter = 6378137; //Earth radius in m;
+    static inline OGRSpatialReference spatialReference = initWGS84();
+
+    /**
+     *
+     * @param lambdaA longitude of point A
+     * @param phiA latitude of point A
+     * @param lambdaB longitude of point B
+     * @param phiB latitude of point B
+     * @param exact applies additional correction for the distances
+     * For further reading consider: https://de.wikipedia.org/wiki/Orthodrome
+     * @return distance between A and B in meters
+     */
+    static double distance(double lambdaA, double phiA, double lambdaB, double phiB, bool exact = true) {
+        math::Degrees F = math::Degrees((phiA + phiB) / 2);
+        math::Degrees G = math::Degrees((phiA - phiB) / 2);
+        math::Degrees l = math::Degrees((lambdaA - lambdaB) / 2);
+        double S = sin2(G) * cos2(l) + cos2(F) * sin2(l);
+        double C = cos2(G) * cos2(l) + sin2(F) * sin2(l);
+        math::Radians w = math::Radians::atan(sqrt(S / C));
+        double distance = 2 * w.getAngleValue() * radiusInMeter;
+        if (not exact) {
+            return distance;
+        } else {
+            double T = sqrt(S * C) / w.getAngleValue();
+            double h1 = (3 * T - 1) / (2 * C);
+            double h2 = (3 * T + 1) / (2 * S);
+            double correction = (1 + flattening * h1 * sin2(F) * cos2(G) -
+                                 flattening * h2 * cos2(F) * sin2(G));
+            return distance * correction;
+        }
+    }
+
+    /**
+     * @brief Compute the distance between two points in metric units
+     * 
+     * @param p point (long,lat)
+     * @param q point (long,lat)
+     * @param exact applies additional correction for the distances
+     * @return distance between p and q in meters
+     */
+    static double distance(geometry::IPoint auto const & p, geometry::IPoint auto const & q,bool exact = true)noexcept{
+        return distance(p.x, p.y, q.x, q.y, exact);
+    }
+
+    /**
+     * @brief Compute the distances from one point to many points in metric units, using the same formula as distance().
+     * The sine and cosine terms of the points are precomputed in the cache, the distances are computed four at a time with AVX2 if available.
+     *
+     * @param p point (long,lat)
+     * @param points cached points (long,lat)
+     * @param exact applies additional correction for the distances
+     * @return std::vector<double> distance between p and each point in meters
+     */
+    static std::vector<double> distances(geometry::IPoint auto const & p, const WGS84PointCache & points, bool exact = true) {
+        std::vector<double> result(points.size());
+        __impl::wgs84::distances(WGS84PointCache::HalfAngles(double(p.x),double(p.y)),points,result.data(),radiusInMeter,flattening,exact);
+        return result;
+    }
+
+    /**
+     * @brief Compute the distances from one point to many points in metric units, using the same formula as distance()
+     *
+     * @param p point (long,lat)
+     * @param points range of points (long,lat)
+     * @param exact applies additional correction for the distances
+     * @return std::vector<double> distance between p and each point in meters
+     */
+    static std::vector<double> distances(geometry::IPoint auto const & p, util::forward_range_of<geometry::Vec2DReal> auto const & points, bool exact = true) {
+        return distances(p,WGS84PointCache(points),exact);
+    }
+
+    /**
+     * @brief Approximate the distance between two close points by projecting them onto the plane tangent to the ellipsoid at their mean latitude,
+     * scaled by the meridional and the prime vertical radius of curvature. Requires one sine, one cosine and one square root.
+     * The relative error to distance() is bounded by localTangentPlaneRelativeError().
+     *
+     * @param p point (long,lat)
+     * @param q point (long,lat)
+     * @return approximate distance between p and q in meters
+     */
+    static double localTangentPlaneDistance(geometry::IPoint auto const & p, geometry::IPoint auto const & q) noexcept {
+        constexpr static double degreeInRadians = math::PI / 180;
+        constexpr static double eccentricity2 = flattening * (2 - flattening);
+        double meanLatitude = (double(p.y) + double(q.y)) / 2 * degreeInRadians;
+        double sinLatitude = std::sin(meanLatitude);
+        double w = std::sqrt(1 - eccentricity2 * sinLatitude * sinLatitude);
+        double primeVerticalRadius = radiusInMeter / w;
+        double meridionalRadius = radiusInMeter * (1 - eccentricity2) / (w * w * w);
+        double deltaLongitude = double(p.x) - double(q.x);
+        deltaLongitude -= 360 * std::round(deltaLongitude / 360); // shortest way across the antimeridian
+        double dx = primeVerticalRadius * std::cos(meanLatitude) * deltaLongitude * degreeInRadians;
+        double dy = meridionalRadius * (double(p.y) - double(q.y)) * degreeInRadians;
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    /**
+     * @brief Upper bound of the relative error of localTangentPlaneDistance() compared to distance().
+     * The error grows quadratically with the distance and with the secant of the latitude; validated up to 500 km and 89.5° latitude.
+     *
+     * @param distance (approximate) distance in meters
+     * @param maxAbsLatitude largest absolute latitude of both points in degrees
+     * @return relative error bound
+     */
+    static double localTangentPlaneRelativeError(double distance, double maxAbsLatitude) noexcept {
+        double cosLatitude = std::cos(maxAbsLatitude * math::PI / 180);
+        double angle = distance / radiusInMeter;
+        return 2e-5 + 0.1 * angle * angle / (cosLatitude * cosLatitude);
+    }
+
+    /**
+     * @brief Tests whether the distance() between two points is at most maxDistance.
+     * Decided by localTangentPlaneDistance() if its error bound is conclusive, otherwise by distance().
+     *
+     * @param p point (long,lat)
+     * @param q point (long,lat)
+     * @param maxDistance maximum distance in meters
+     * @return true if p and q are within the maximum distance
+     */
+    static bool withinDistance(geometry::IPoint auto const & p, geometry::IPoint auto const & q, double maxDistance) noexcept {
+        if(auto decision = withinLocalTangentPlaneDistance(p,q,maxDistance))
+            return decision.value();
+        return p == q || distance(p,q) <= maxDistance;
+    }
+
+    /**
+     * @brief Tests for many points whether their distance() to p is at most maxDistance.
+     * Each point is decided by localTangentPlaneDistance() if its error bound is conclusive,
+     * the remaining points are decided by the batched distances() from p.
+     *
+     * @param p point (long,lat)
+     * @param points range of points (long,lat)
+     * @param maxDistance maximum distance in meters
+     * @return std::vector<bool> true at the index of each point within the maximum distance of p
+     */
+    static std::vector<bool> withinDistance(geometry::IPoint auto const & p, util::forward_range_of<geometry::Vec2DReal> auto const & points, double maxDistance) {
+        std::vector<bool> result;
+        std::vector<size_t> undecided;
+        WGS84PointCache exactPoints;
+        for(const auto & q: points) {
+            auto decision = withinLocalTangentPlaneDistance(p,q,maxDistance);
+            if(not decision && p == q)
+                decision = true;
+            if(not decision) {
+                undecided.push_back(result.size());
+                exactPoints.add(q);
+            }
+            result.push_back(decision.value_or(false));
+        }
+        if(exactPoints.empty())
+            return result;
+        auto exactDistances = distances(p,exactPoints);
+        for(size_t i = 0; i < undecided.size(); ++i) {
+            result[undecided[i]] = exactDistances[i] <= maxDistance;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Calculate the area of a polygon in m² by projection to Eckert IV
+     * @param polygon source polygon in (longitude,latitude)
+     * @return area in m², NaN if the projection failed
+     */
+    static double area(geometry::IPolygon auto const & polygon) noexcept {
+        EckertIVBatches batches;
+        batches.add(polygon.getBoundary());
+        for(const auto & hole: polygon.getHoles()) {
+            batches.add(hole);
+        }
+        auto ringAreas = batches.areas();
+        return ringAreas.front() - std::accumulate(ringAreas.begin()+1,ringAreas.end(),0.0);
+    }
+
+    /**
+     * @brief Calculate the area of a ring in m² by projection to Eckert IV
+     * @param ring source ring in (longitude,latitude)
+     * @return area in m², NaN if the projection failed
+     */
+    static double area(geometry::IRing auto const & ring) noexcept {
+        EckertIVBatches batches;
+        batches.add(ring);
+        return batches.areas().front();
+    }
+
+    /**
+     * @brief Calculate the areas of the rings in m², projecting all rings with one transformation call per central meridian
+     * @param rings source rings in (longitude,latitude)
+     * @return std::vector<double> area in m² of each ring, NaN if the projection failed
+     */
+    static std::vector<double> areas(geometry::RingRange auto const & rings) {
+        EckertIVBatches batches;
+        for(const auto & ring: rings) {
+            batches.add(ring);
+        }
+        return batches.areas();
+    }
+
+    /**
+     * @brief Calculate the areas of the polygons in m², projecting all rings with one transformation call per central meridian
+     * @param polygons source polygons in (longitude,latitude)
+     * @return std::vector<double> area in m² of each polygon (excluding its holes), NaN if the projection failed
+     */
+    static std::vector<double> areas(geometry::PolygonRange auto const & polygons) {
+        EckertIVBatches batches;
+        std::vector<size_t> holes;
+        for(const auto & polygon: polygons) {
+            batches.add(polygon.getBoundary());
+            size_t numberOfHoles = 0;
+            for(const auto & hole: polygon.getHoles()) {
+                batches.add(hole);
+                ++numberOfHoles;
+            }
+            holes.push_back(numberOfHoles);
+        }
+        auto ringAreas = batches.areas();
+        std::vector<double> result;
+        result.reserve(holes.size());
+        size_t ringIndex = 0;
+        for(size_t numberOfHoles: holes) {
+            double polygonArea = ringAreas[ringIndex++];
+            for(size_t i = 0; i < numberOfHoles; ++i) {
+                polygonArea -= ringAreas[ringIndex++];
+            }
+            result.push_back(polygonArea);
+        }
+        return result;
+    }
+};
+}
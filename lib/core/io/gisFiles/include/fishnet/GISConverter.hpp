@@ -1,6 +1,7 @@
 #pragma once
 #include "Shapefile.hpp"
 #include "GeoTiff.hpp"
+#include "TiledPolygonizer.hpp"
 #include <gdal/gdal.h>
 #include <gdal_alg.h>
 #include <ogrsf_frmts.h>
@@ -10,60 +11,114 @@
 
 namespace fishnet{
 class GISConverter {
-public:
+private:
+    struct Destination {
+        GDALDatasetUniquePtr dataset;
+        OGRLayer * layer;
+        int fieldID;
+    };
+
+    static std::filesystem::path defaultDestination(const GeoTiff & geoTiff) {
+        return geoTiff.getPath().parent_path() / geoTiff.getPath().stem().replace_extension(".shp");
+    }
+
     /**
-     * @brief Tries to convert a GeoTiff to Shp file
-     * 
-     * @param geoTiff source geoTiff file
-     * @param maskZero see: GDALPolygonize(...) 
-     * @param showProgress show progress in console
-     * @return std::expected<Shapefile,std::string>: Shapefile on success, otherwise string explaining the error
+     * @brief Creates the destination shapefile with a polygon layer in the spatial reference of the source and an integer field for the pixel values
      */
-    static std::expected<Shapefile,std::string> convert(const GeoTiff & geoTiff,bool maskZero = true, bool showProgress=false) noexcept{
-        GDALAllRegister();
-        GDALDataset *src = (GDALDataset *) GDALOpen(geoTiff.getPath().c_str(), GA_ReadOnly);
-        if(src == nullptr)
-            return std::unexpected("Could not open Geotiff-Dataset: "+geoTiff.getPath().string());
+    static std::expected<Destination,std::string> createDestination(GDALDataset & src, const Shapefile & destination) {
         auto driver = GetGDALDriverManager()->GetDriverByName("ESRI Shapefile");
         if(driver == nullptr)
             return std::unexpected("No suitable ESRI Shapefile driver detected");
-        std::filesystem::path destPath = geoTiff.getPath().parent_path() / geoTiff.getPath().stem().replace_extension(".shp");
-        GDALDataset *dest = driver->Create(destPath.c_str(), 0,0, 0, GDT_Unknown,nullptr);
-        auto spatialReference = src->GetSpatialRef();
-        OGRLayer * layer = dest->CreateLayer(destPath.stem().c_str(),spatialReference->Clone(),wkbPolygon, nullptr);
+        const std::filesystem::path & destPath = destination.getPath();
+        GDALDatasetUniquePtr dest {driver->Create(destPath.c_str(), 0,0, 0, GDT_Unknown,nullptr)};
+        if(not dest)
+            return std::unexpected("Could not create Shapefile: "+destPath.string());
+        OGRLayer * layer = dest->CreateLayer(destPath.stem().c_str(),src.GetSpatialRef(),wkbPolygon, nullptr);
+        if(layer == nullptr)
+            return std::unexpected("Could not create layer in Shapefile: "+destPath.string());
         const char *fieldName = "pixel_val";
         OGRFieldDefn fieldDefn = OGRFieldDefn(fieldName, OFTInteger);
         if(layer->CreateField(&fieldDefn)!=OGRERR_NONE)
             return std::unexpected("Could not create field for pixel values");
         int fieldID = layer->GetLayerDefn()->GetFieldIndex(fieldName);
-        char ** papszOptions = nullptr;
-        papszOptions = CSLSetNameValue(papszOptions, "8CONNECTED", "8");
-        if(maskZero) {
-            if (showProgress) {
-                GDALPolygonize(src->GetRasterBand(1), src->GetRasterBand(1), layer, fieldID, papszOptions,
-                               GDALTermProgress,
-                               nullptr);
-            } else {
-                GDALPolygonize(src->GetRasterBand(1), src->GetRasterBand(1), layer, fieldID, papszOptions,
-                               nullptr,
-                               nullptr);
-            }
+        return Destination{std::move(dest),layer,fieldID};
+    }
+public:
+    /**
+     * @brief Tries to convert a GeoTiff to Shp file, next to the GeoTiff
+     *
+     * @param geoTiff source geoTiff file
+     * @param maskZero see: GDALPolygonize(...)
+     * @param showProgress show progress in console
+     * @return std::expected<Shapefile,std::string>: Shapefile on success, otherwise string explaining the error
+     */
+    static std::expected<Shapefile,std::string> convert(const GeoTiff & geoTiff,bool maskZero = true, bool showProgress=false) noexcept{
+        return convert(geoTiff,Shapefile(defaultDestination(geoTiff)),maskZero,showProgress);
+    }
 
-        } else {
-            if (showProgress) {
-                GDALPolygonize(src->GetRasterBand(1), nullptr, layer, fieldID, papszOptions,
-                               GDALTermProgress,
-                               nullptr);
-            } else {
-                GDALPolygonize(src->GetRasterBand(1), nullptr, layer, fieldID, papszOptions,
-                               nullptr,
-                               nullptr);
-            }
+    /**
+     * @brief Tries to convert a GeoTiff to Shp file, polygonizing tiles of rows in parallel (see TiledPolygonizer).
+     * The polygons equal those of a single GDALPolygonize(...) call, see: convertSequential(...)
+     *
+     * @param geoTiff source geoTiff file
+     * @param destination destination shapefile, overwritten if it exists
+     * @param maskZero see: GDALPolygonize(...)
+     * @param showProgress show progress in console
+     * @param tileRows number of rows per tile
+     * @param numThreads number of tiles polygonized concurrently
+     * @param maxWindowRows maximum number of rows polygonized again to stitch a polygon across tiles, larger polygons are merged from their tiles
+     * @return std::expected<Shapefile,std::string>: Shapefile on success, otherwise string explaining the error
+     */
+    static std::expected<Shapefile,std::string> convert(const GeoTiff & geoTiff, const Shapefile & destination, bool maskZero = true, bool showProgress=false,
+                                                        size_t tileRows = TiledPolygonizer::DEFAULT_TILE_ROWS, size_t numThreads = std::thread::hardware_concurrency(),
+                                                        size_t maxWindowRows = TiledPolygonizer::DEFAULT_MAX_WINDOW_ROWS) noexcept{
+        GDALAllRegister();
+        GDALDatasetUniquePtr src {(GDALDataset *) GDALOpen(geoTiff.getPath().c_str(), GA_ReadOnly)};
+        if(src == nullptr)
+            return std::unexpected("Could not open Geotiff-Dataset: "+geoTiff.getPath().string());
+        auto dest = createDestination(*src,destination);
+        if(not dest)
+            return std::unexpected(dest.error());
+        src.reset();
+        try{
+            auto polygonized = TiledPolygonizer(geoTiff.getPath(),maskZero,tileRows,numThreads,maxWindowRows).polygonize(dest->layer,dest->fieldID,showProgress);
+            if(not polygonized)
+                return std::unexpected(polygonized.error());
+        }catch(const std::exception & e) {
+            return std::unexpected("Could not polygonize Geotiff-Dataset: "+geoTiff.getPath().string()+"\n"+e.what());
         }
-        layer->SyncToDisk();
-        GDALClose(src);
-        GDALClose(dest);
-        return Shapefile(destPath);
+        dest->layer->SyncToDisk();
+        return destination;
+    }
+
+    /**
+     * @brief Tries to convert a GeoTiff to Shp file with a single GDALPolygonize(...) call over the whole raster
+     *
+     * @param geoTiff source geoTiff file
+     * @param destination destination shapefile, overwritten if it exists
+     * @param maskZero see: GDALPolygonize(...)
+     * @param showProgress show progress in console
+     * @return std::expected<Shapefile,std::string>: Shapefile on success, otherwise string explaining the error
+     */
+    static std::expected<Shapefile,std::string> convertSequential(const GeoTiff & geoTiff, const Shapefile & destination, bool maskZero = true, bool showProgress=false) noexcept{
+        GDALAllRegister();
+        GDALDatasetUniquePtr src {(GDALDataset *) GDALOpen(geoTiff.getPath().c_str(), GA_ReadOnly)};
+        if(src == nullptr)
+            return std::unexpected("Could not open Geotiff-Dataset: "+geoTiff.getPath().string());
+        auto dest = createDestination(*src,destination);
+        if(not dest)
+            return std::unexpected(dest.error());
+        char ** papszOptions = nullptr;
+        papszOptions = CSLSetNameValue(papszOptions, "8CONNECTED", "8");
+        GDALRasterBand * band = src->GetRasterBand(1);
+        CPLErr error = GDALPolygonize(band, maskZero ? band : nullptr, dest->layer, dest->fieldID, papszOptions,
+                                      showProgress ? GDALTermProgress : nullptr,
+                                      nullptr);
+        CSLDestroy(papszOptions);
+        if(error != CE_None)
+            return std::unexpected("Could not polygonize Geotiff-Dataset: "+geoTiff.getPath().string());
+        dest->layer->SyncToDisk();
+        return destination;
     }
 };
 }
@@ -35,7 +35,18 @@ public:
     }
 
     /**
-     * @brief Get all GIS files in a directory/ or a single file from a path
+     * @brief Checks whether a file can be used as input, i.e. converted to a shapefile by asShapefile()
+     * 
+     * @param path path to the file
+     * @return true if the file is a shapefile or geotiff
+     */
+    static bool isInputFile(const std::filesystem::path & path){
+        auto fileType = getGISFileType(path);
+        return fileType == GISFileType::SHAPEFILE || fileType == GISFileType::GEOTIFF;
+    }
+
+    /**
+     * @brief Get all input GIS files (shapefiles and geotiffs) in a directory/ or a single file from a path
      * 
      * @param directory search directory
      * @return std::vector<std::filesystem::path> list of gis files in that directory
@@ -45,12 +56,12 @@ public:
         auto dir = path;
         if(std::filesystem::is_symlink(path))
             dir = std::filesystem::read_symlink(path);
-        if(not std::filesystem::is_directory(dir) && std::filesystem::is_regular_file(path) && getGISFileType(path).has_value()){
+        if(not std::filesystem::is_directory(dir) && std::filesystem::is_regular_file(path) && isInputFile(path)){
             gisFiles.emplace_back(path);
             return gisFiles;
         }
         for(auto && file: std::filesystem::directory_iterator(dir)){
-            if(file.is_regular_file() && getGISFileType(file).has_value()){
+            if(file.is_regular_file() && isInputFile(file)){
                 gisFiles.push_back(std::move(file));
             }
         }
@@ -8,7 +8,7 @@
 namespace fishnet{
 
 enum class GISFileType{
-    SHAPEFILE,GEOTIFF,GEOPACKAGE
+    SHAPEFILE,GEOTIFF,GEOPACKAGE,GEOMETRY_CACHE
 };
 
 static std::optional<GISFileType> getGISFileType(const std::filesystem::path & path) {
@@ -21,6 +21,9 @@ static std::optional<GISFileType> getGISFileType(const std::filesystem::path & p
     else if (ext == ".gpkg") {
         return GISFileType::GEOPACKAGE;
     }
+    else if (ext == ".fgc") {
+        return GISFileType::GEOMETRY_CACHE;
+    }
     return std::nullopt;
 }
 
@@ -0,0 +1,30 @@
+#pragma once
+#include "GISFile.hpp"
+
+namespace fishnet {
+/**
+ * @brief Handle of a fishnet geometry cache (.fgc), a memory-mappable binary vector file, see: GeometryCacheIO.hpp
+ * 
+ */
+class GeometryCache: public AbstractVectorFile {
+public:
+    GeometryCache(std::filesystem::path path):AbstractVectorFile(path){
+        if(not supports(path)){
+            throw std::invalid_argument("Not a geometry cache file: "+ path.string());
+        }
+    }
+
+    bool remove() const noexcept override;
+
+    constexpr GISFileType type() const noexcept override {
+        return GISFileType::GEOMETRY_CACHE;
+    }
+
+    GeometryCache & move(std::filesystem::path const & path);
+
+    GeometryCache copy(std::filesystem::path const & path) const;
+
+    std::string toString() const noexcept;
+};
+static_assert(VectorGISFile<GeometryCache>);
+}
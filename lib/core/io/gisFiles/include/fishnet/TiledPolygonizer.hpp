@@ -0,0 +1,548 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <iterator>
+#include <mutex>
+#include <numeric>
+#include <ranges>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <gdal/gdal.h>
+#include <gdal_alg.h>
+#include <ogrsf_frmts.h>
+#include <gdal/ogr_core.h>
+#include <gdal/gdal_priv.h>
+#include <fishnet/ThreadPool.hpp>
+#include <fishnet/ProgressPrinter.h>
+
+namespace fishnet {
+namespace __impl {
+/**
+ * @brief Sequential disjoint-set (union-find) over the ids [0,size), the root of each set is its smallest id
+ */
+class DisjointSet {
+private:
+    std::vector<size_t> parent;
+public:
+    explicit DisjointSet(size_t size = 0):parent(size){
+        std::iota(parent.begin(),parent.end(),0);
+    }
+
+    size_t add() {
+        parent.push_back(parent.size());
+        return parent.size()-1;
+    }
+
+    size_t size() const noexcept {
+        return parent.size();
+    }
+
+    size_t find(size_t id) noexcept {
+        while(parent[id] != id) {
+            parent[id] = parent[parent[id]]; // path halving
+            id = parent[id];
+        }
+        return id;
+    }
+
+    void unite(size_t lhs, size_t rhs) noexcept {
+        lhs = find(lhs);
+        rhs = find(rhs);
+        if(lhs == rhs)
+            return;
+        if(lhs < rhs)
+            std::swap(lhs,rhs);
+        parent[lhs] = rhs;
+    }
+};
+}
+
+/**
+ * @brief Polygonizes the first band of a raster in tiles of consecutive rows, which are processed in parallel.
+ * Each tile is labeled into 8-connected components of equal pixel values (as GDALPolygonize(...) with "8CONNECTED=8")
+ * and the label raster is polygonized in pixel coordinates. Polygons not touching a seam between two tiles are written immediately,
+ * such that only the polygons along the seams are kept in memory. Components connected across a seam are polygonized again
+ * from a window of rows containing all of their tiles, instead of merging their parts geometrically: GDALPolygonize(...) returns a
+ * single polygon for parts touching only at a corner, where a geometric union would return a multi-polygon.
+ * Hence the result equals a single GDALPolygonize(...) call over the whole raster, up to the order of the features and the start vertex of the rings.
+ * The windows are polygonized concurrently. A window holds the values, mask and labels of all of its rows, therefore windows with more than
+ * maxWindowRows rows (e.g. a single component spanning most of the raster) are not polygonized again: the polygons of their components are
+ * merged from the polygons of the tiles by a geometric union instead, such that each thread holds at most maxWindowRows rows of the raster. Such components may differ from GDALPolygonize(...) by being a multi-polygon
+ * where their parts touch only at a corner and by additional collinear vertices along the seams. The number of these components is reported in the progress.
+ */
+class TiledPolygonizer {
+public:
+    constexpr static size_t DEFAULT_TILE_ROWS = 512;
+    constexpr static size_t DEFAULT_MAX_WINDOW_ROWS = 8 * DEFAULT_TILE_ROWS;
+private:
+    constexpr static bool EIGHT_CONNECTED = true;
+
+    struct Tile {
+        std::vector<int32_t> componentValues; // pixel value of the component labeled i+1
+        std::vector<int32_t> firstRow; // labels of the first row, if it borders a seam
+        std::vector<int32_t> lastRow; // labels of the last row, if it borders a seam
+        std::unordered_map<int32_t,std::vector<OGRGeometryUniquePtr>> seamGeometries; // polygons of the components touching a seam
+    };
+
+    std::filesystem::path source;
+    bool maskZero;
+    size_t tileRows;
+    size_t numThreads;
+    size_t maxWindowRows;
+    int width = 0;
+    int height = 0;
+    std::array<double,6> geoTransform {0,1,0,0,0,1};
+    std::vector<Tile> tiles;
+    OGRLayer * destination = nullptr;
+    int fieldID = 0;
+    std::mutex destinationMutex;
+
+    template<typename F>
+    static void forEachRing(OGRGeometry & geometry, F && f) {
+        switch(wkbFlatten(geometry.getGeometryType())) {
+            case wkbPolygon:
+                for(auto * ring: *geometry.toPolygon())
+                    f(*ring);
+                break;
+            case wkbMultiPolygon:
+                for(auto * polygon: *geometry.toMultiPolygon())
+                    for(auto * ring: *polygon)
+                        f(*ring);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void applyGeoTransform(OGRLinearRing & ring) const {
+        for(int i = 0; i < ring.getNumPoints(); ++i) {
+            double x = ring.getX(i);
+            double y = ring.getY(i);
+            ring.setPoint(i,geoTransform[0] + x*geoTransform[1] + y*geoTransform[2], geoTransform[3] + x*geoTransform[4] + y*geoTransform[5]);
+        }
+    }
+
+    /**
+     * @brief Transforms the geometry from pixel coordinates to coordinates of the raster and writes it to the destination layer
+     */
+    std::optional<std::string> write(OGRGeometryUniquePtr geometry, int32_t value) {
+        forEachRing(*geometry,[this](OGRLinearRing & ring){applyGeoTransform(ring);});
+        std::lock_guard lock {destinationMutex};
+        OGRFeatureUniquePtr feature {OGRFeature::CreateFeature(destination->GetLayerDefn())};
+        feature->SetField(fieldID,value);
+        feature->SetGeometryDirectly(geometry.release());
+        if(destination->CreateFeature(feature.get()) != OGRERR_NONE)
+            return "Could not write polygon with pixel value "+std::to_string(value);
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Labels the connected components of equal pixel values, skipping pixels with a mask value of zero
+     *
+     * @param values pixel values of the tile
+     * @param mask mask values of the tile, empty if no pixel is masked
+     * @param rows number of rows of the tile
+     * @param componentValues output, pixel value of the component labeled i+1 at index i
+     * @return std::vector<int32_t> label of each pixel in 1..n, 0 for masked pixels
+     */
+    std::vector<int32_t> labelComponents(const std::vector<int32_t> & values, const std::vector<GByte> & mask, size_t rows, std::vector<int32_t> & componentValues) const {
+        size_t columns = size_t(width);
+        std::vector<int32_t> labels(values.size(),0);
+        __impl::DisjointSet provisional {1}; // provisional label 0 marks masked pixels
+        for(size_t row = 0; row < rows; ++row) {
+            for(size_t column = 0; column < columns; ++column) {
+                size_t i = row*columns + column;
+                if(not mask.empty() && mask[i] == 0)
+                    continue;
+                int32_t label = 0;
+                auto connect = [&](size_t neighbour){
+                    if(labels[neighbour] == 0 || values[neighbour] != values[i])
+                        return;
+                    if(label == 0)
+                        label = labels[neighbour];
+                    else
+                        provisional.unite(size_t(label),size_t(labels[neighbour]));
+                };
+                if(column > 0)
+                    connect(i-1);
+                if(row > 0) {
+                    connect(i-columns);
+                    if(EIGHT_CONNECTED && column > 0)
+                        connect(i-columns-1);
+                    if(EIGHT_CONNECTED && column+1 < columns)
+                        connect(i-columns+1);
+                }
+                labels[i] = label != 0 ? label : int32_t(provisional.add());
+            }
+        }
+        std::vector<int32_t> compact(provisional.size(),0);
+        componentValues.clear();
+        for(size_t i = 0; i < labels.size(); ++i) {
+            if(labels[i] == 0)
+                continue;
+            size_t root = provisional.find(size_t(labels[i]));
+            if(compact[root] == 0) {
+                componentValues.push_back(values[i]);
+                compact[root] = int32_t(componentValues.size());
+            }
+            labels[i] = compact[root];
+        }
+        return labels;
+    }
+
+    /**
+     * @brief Reads rows of the first band, and its mask if pixels with value zero are skipped.
+     * Each call opens its own dataset, hence rows can be read concurrently.
+     * @param rowOffset first row
+     * @param rows number of rows
+     * @param values output, pixel values of the rows
+     * @param mask output, mask values of the rows, empty if no pixel is masked
+     * @return std::optional<std::string> error message, if the rows could not be read
+     */
+    std::optional<std::string> readRows(int rowOffset, int rows, std::vector<int32_t> & values, std::vector<GByte> & mask) const {
+        GDALDatasetUniquePtr src {GDALDataset::Open(source.c_str(),GDAL_OF_RASTER | GDAL_OF_READONLY)};
+        if(not src)
+            return "Could not open Geotiff-Dataset: "+source.string();
+        GDALRasterBand * band = src->GetRasterBand(1);
+        size_t pixels = size_t(width)*size_t(rows);
+        values.resize(pixels);
+        if(band->RasterIO(GF_Read,0,rowOffset,width,rows,values.data(),width,rows,GDT_Int32,0,0,nullptr) != CE_None)
+            return "Could not read rows "+std::to_string(rowOffset)+" to "+std::to_string(rowOffset+rows)+" of Geotiff-Dataset: "+source.string();
+        mask.clear();
+        if(maskZero) {
+            mask.resize(pixels); // read the band as its own mask, like GDALPolygonize(...) does
+            if(band->RasterIO(GF_Read,0,rowOffset,width,rows,mask.data(),width,rows,GDT_Byte,0,0,nullptr) != CE_None)
+                return "Could not read mask of rows "+std::to_string(rowOffset)+" to "+std::to_string(rowOffset+rows)+" of Geotiff-Dataset: "+source.string();
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Polygonizes the labels of rows in pixel coordinates with GDALPolygonize(...) and "8CONNECTED=8"
+     *
+     * @param labels label of each pixel, pixels labeled 0 are skipped
+     * @param rows number of rows
+     * @param rowOffset first row
+     * @param f callback for each polygon, receiving the label and the geometry and returning an optional error message
+     * @return std::optional<std::string> error message, if the labels could not be polygonized or the callback failed
+     */
+    template<typename F>
+    std::optional<std::string> polygonizeLabels(const std::vector<int32_t> & labels, int rows, int rowOffset, F && f) const {
+        GDALDriver * memoryRaster = GetGDALDriverManager()->GetDriverByName("MEM");
+        GDALDriver * memoryVector = GetGDALDriverManager()->GetDriverByName("Memory");
+        if(memoryRaster == nullptr || memoryVector == nullptr)
+            return "No suitable in-memory GDAL drivers detected";
+        GDALDatasetUniquePtr labelRaster {memoryRaster->Create("",width,rows,1,GDT_Int32,nullptr)};
+        double pixelTransform[6] = {0,1,0,double(rowOffset),0,1}; // pixel coordinates
+        labelRaster->SetGeoTransform(pixelTransform);
+        GDALRasterBand * labelBand = labelRaster->GetRasterBand(1);
+        if(labelBand->RasterIO(GF_Write,0,0,width,rows,const_cast<int32_t *>(labels.data()),width,rows,GDT_Int32,0,0,nullptr) != CE_None)
+            return "Could not write labels of rows "+std::to_string(rowOffset)+" to "+std::to_string(rowOffset+rows);
+        GDALDatasetUniquePtr polygons {memoryVector->Create("",0,0,0,GDT_Unknown,nullptr)};
+        OGRLayer * polygonLayer = polygons->CreateLayer("components",nullptr,wkbPolygon,nullptr);
+        OGRFieldDefn labelField {"label",OFTInteger};
+        if(polygonLayer == nullptr || polygonLayer->CreateField(&labelField) != OGRERR_NONE)
+            return "Could not create in-memory layer for rows "+std::to_string(rowOffset)+" to "+std::to_string(rowOffset+rows);
+        char ** options = CSLSetNameValue(nullptr,"8CONNECTED","8");
+        CPLErr error = GDALPolygonize(labelBand,labelBand,polygonLayer,0,options,nullptr,nullptr); // labels are non-zero for all unmasked pixels
+        CSLDestroy(options);
+        if(error != CE_None)
+            return "Could not polygonize rows "+std::to_string(rowOffset)+" to "+std::to_string(rowOffset+rows);
+        labelRaster.reset();
+        for(auto & feature: polygonLayer) {
+            int32_t label = feature->GetFieldAsInteger(0);
+            OGRGeometryUniquePtr geometry {feature->StealGeometry()};
+            if(not geometry || label <= 0)
+                continue;
+            if(auto callbackError = f(label,std::move(geometry)))
+                return callbackError;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Reads, labels and polygonizes a tile. Polygons of components not touching a seam are written to the destination.
+     * Each call opens its own dataset, hence tiles can be processed concurrently.
+     * @param index index of the tile
+     * @return std::optional<std::string> error message, if the tile could not be polygonized
+     */
+    std::optional<std::string> polygonizeTile(size_t index) {
+        Tile & tile = tiles[index];
+        int rowOffset = int(index*tileRows);
+        int rows = std::min(int(tileRows),height-rowOffset);
+        std::vector<int32_t> values;
+        std::vector<GByte> mask;
+        if(auto readError = readRows(rowOffset,rows,values,mask))
+            return readError;
+        std::vector<int32_t> labels = labelComponents(values,mask,size_t(rows),tile.componentValues);
+        values.clear();
+        values.shrink_to_fit();
+        mask.clear();
+        mask.shrink_to_fit();
+        std::vector<bool> touchesSeam(tile.componentValues.size()+1,false);
+        if(index > 0) {
+            tile.firstRow.assign(labels.begin(),labels.begin()+width);
+            for(auto label: tile.firstRow)
+                touchesSeam[size_t(label)] = true;
+        }
+        if(index+1 < tiles.size()) {
+            tile.lastRow.assign(labels.end()-width,labels.end());
+            for(auto label: tile.lastRow)
+                touchesSeam[size_t(label)] = true;
+        }
+        return polygonizeLabels(labels,rows,rowOffset,[this,&tile,&touchesSeam](int32_t label, OGRGeometryUniquePtr geometry) -> std::optional<std::string> {
+            if(touchesSeam[size_t(label)]) {
+                tile.seamGeometries[label].push_back(std::move(geometry));
+                return std::nullopt;
+            }
+            return write(std::move(geometry),tile.componentValues[size_t(label-1)]);
+        });
+    }
+
+    /**
+     * @brief Labels and polygonizes the rows of consecutive tiles again, writing only the components spanning more than one tile.
+     * The window must contain all tiles of these components.
+     * @param firstTile first tile of the window
+     * @param lastTile last tile of the window
+     * @return std::optional<std::string> error message, if the window could not be polygonized
+     */
+    std::optional<std::string> polygonizeWindow(size_t firstTile, size_t lastTile) {
+        int rowOffset = int(firstTile*tileRows);
+        int rows = std::min(int((lastTile+1)*tileRows),height)-rowOffset;
+        std::vector<int32_t> values;
+        std::vector<GByte> mask;
+        if(auto readError = readRows(rowOffset,rows,values,mask))
+            return readError;
+        std::vector<int32_t> componentValues;
+        std::vector<int32_t> labels = labelComponents(values,mask,size_t(rows),componentValues);
+        values.clear();
+        values.shrink_to_fit();
+        mask.clear();
+        mask.shrink_to_fit();
+        std::vector<std::pair<size_t,size_t>> tileRange(componentValues.size()+1,{lastTile,firstTile}); // first and last tile of each component
+        for(size_t i = 0; i < labels.size(); ++i) {
+            if(labels[i] == 0)
+                continue;
+            size_t tile = (size_t(rowOffset) + i/size_t(width))/tileRows;
+            auto & [first,last] = tileRange[size_t(labels[i])];
+            first = std::min(first,tile);
+            last = std::max(last,tile);
+        }
+        for(auto & label: labels) {
+            if(label != 0 && tileRange[size_t(label)].first == tileRange[size_t(label)].second)
+                label = 0; // already written with its tile
+        }
+        return polygonizeLabels(labels,rows,rowOffset,[this,&componentValues](int32_t label, OGRGeometryUniquePtr geometry){
+            return write(std::move(geometry),componentValues[size_t(label-1)]);
+        });
+    }
+
+    /**
+     * @brief Merges the polygons of a component from its tiles by a geometric union and writes the result
+     *
+     * @param value pixel value of the component
+     * @param parts polygons of the component in the tiles, in pixel coordinates
+     * @return std::optional<std::string> error message, if the polygons could not be merged or written
+     */
+    std::optional<std::string> mergeTileGeometries(int32_t value, std::vector<OGRGeometryUniquePtr> & parts) {
+        OGRMultiPolygon multiPolygon;
+        for(auto & part: parts) {
+            if(wkbFlatten(part->getGeometryType()) != wkbPolygon || multiPolygon.addGeometryDirectly(part.get()) != OGRERR_NONE)
+                return "Could not collect the tiles of a polygon with pixel value "+std::to_string(value);
+            part.release(); // owned by the multi-polygon
+        }
+        parts.clear();
+        OGRGeometryUniquePtr merged {multiPolygon.UnionCascaded()};
+        if(not merged)
+            return "Could not merge the tiles of a polygon with pixel value "+std::to_string(value);
+        return write(std::move(merged),value);
+    }
+
+    /**
+     * @brief Writes the polygons of components touching a seam. Components connected across seams are polygonized again
+     * in windows of consecutive tiles, see polygonizeWindow(...), or merged from their tiles if their window exceeds maxWindowRows,
+     * see mergeTileGeometries(...). Windows and merged components are processed concurrently on the pool.
+     *
+     * @param pool thread pool
+     * @param showProgress show progress in console
+     * @return std::optional<std::string> error message, if a polygon could not be created or written
+     */
+    std::optional<std::string> stitchSeams(util::ThreadPool & pool, bool showProgress) {
+        std::vector<size_t> offsets(tiles.size(),0); // global label = offset of the tile + label
+        for(size_t i = 1; i < tiles.size(); ++i) {
+            offsets[i] = offsets[i-1] + tiles[i-1].componentValues.size() + 1;
+        }
+        std::unordered_map<size_t,size_t> seamIndices;
+        __impl::DisjointSet components;
+        auto indexOf = [&seamIndices,&components](size_t globalLabel){
+            auto [iterator,inserted] = seamIndices.try_emplace(globalLabel,components.size());
+            if(inserted)
+                components.add();
+            return iterator->second;
+        };
+        for(size_t i = 0; i+1 < tiles.size(); ++i) {
+            const Tile & upper = tiles[i];
+            const Tile & lower = tiles[i+1];
+            for(int column = 0; column < width; ++column) {
+                int32_t upperLabel = upper.lastRow[size_t(column)];
+                if(upperLabel == 0)
+                    continue;
+                int32_t value = upper.componentValues[size_t(upperLabel-1)];
+                int reach = EIGHT_CONNECTED ? 1 : 0;
+                for(int neighbour = std::max(0,column-reach); neighbour <= std::min(width-1,column+reach); ++neighbour) {
+                    int32_t lowerLabel = lower.firstRow[size_t(neighbour)];
+                    if(lowerLabel != 0 && lower.componentValues[size_t(lowerLabel-1)] == value)
+                        components.unite(indexOf(offsets[i]+size_t(upperLabel)),indexOf(offsets[i+1]+size_t(lowerLabel)));
+                }
+            }
+        }
+        std::unordered_map<size_t,std::pair<size_t,size_t>> tileRanges; // first and last tile of each component touching a seam
+        for(size_t i = 0; i < tiles.size(); ++i) {
+            for(const auto & [label,_]: tiles[i].seamGeometries) {
+                auto [iterator,inserted] = tileRanges.try_emplace(components.find(indexOf(offsets[i]+size_t(label))),i,i);
+                auto & [first,last] = iterator->second;
+                first = std::min(first,i);
+                last = std::max(last,i);
+            }
+        }
+        std::vector<std::pair<size_t,size_t>> windows;
+        for(const auto & range: std::views::values(tileRanges)) {
+            if(range.first != range.second)
+                windows.push_back(range);
+        }
+        std::ranges::sort(windows);
+        size_t merged = 0;
+        for(size_t i = 0; i < windows.size(); ++i) {
+            if(merged > 0 && windows[i].first < windows[merged-1].second) // components share at least two tiles, otherwise each window contains all of its components
+                windows[merged-1].second = std::max(windows[merged-1].second,windows[i].second);
+            else
+                windows[merged++] = windows[i];
+        }
+        windows.resize(merged);
+        auto rowsOf = [this](const std::pair<size_t,size_t> & window){
+            return std::min((window.second+1)*tileRows,size_t(height)) - window.first*tileRows;
+        };
+        auto exceedsBudget = [this,&windows,&rowsOf](const std::pair<size_t,size_t> & range){
+            // windows overlap in at most one tile, hence the window containing a range spanning two or more tiles is the last one starting at or before its first tile
+            auto window = std::ranges::upper_bound(windows,range.first,std::less<>(),[](const auto & w){return w.first;}) - 1;
+            return rowsOf(*window) > maxWindowRows;
+        };
+        std::unordered_map<size_t,size_t> mergedIndices; // component -> index in mergedComponents
+        std::vector<std::pair<int32_t,std::vector<OGRGeometryUniquePtr>>> mergedComponents; // pixel value and polygons of each component merged from its tiles
+        for(size_t i = 0; i < tiles.size(); ++i) {
+            for(auto & [label,geometries]: tiles[i].seamGeometries) {
+                size_t component = components.find(indexOf(offsets[i]+size_t(label)));
+                const auto & range = tileRanges.at(component);
+                int32_t value = tiles[i].componentValues[size_t(label-1)];
+                if(range.first != range.second) { // connected across a seam
+                    if(not exceedsBudget(range))
+                        continue;
+                    auto [iterator,inserted] = mergedIndices.try_emplace(component,mergedComponents.size());
+                    if(inserted)
+                        mergedComponents.emplace_back(value,std::vector<OGRGeometryUniquePtr>());
+                    std::ranges::move(geometries,std::back_inserter(mergedComponents[iterator->second].second));
+                    continue;
+                }
+                for(auto & geometry: geometries) {
+                    if(auto writeError = write(std::move(geometry),value))
+                        return writeError;
+                }
+            }
+            tiles[i] = Tile();
+        }
+        std::erase_if(windows,[this,&rowsOf](const auto & window){return rowsOf(window) > maxWindowRows;});
+        std::optional<util::ProgressPrinter> progress;
+        if(showProgress)
+            progress.emplace(windows.size()+mergedComponents.size(),"Stitch seams of "+source.filename().string()+": "+std::to_string(windows.size())+" windows polygonized again, "
+                +std::to_string(mergedComponents.size())+" polygons exceeding "+std::to_string(maxWindowRows)+" rows merged from their tiles");
+        std::mutex progressMutex;
+        std::vector<std::optional<std::string>> errors(windows.size()+mergedComponents.size());
+        pool.parallelFor(0,errors.size(),[&](size_t i){
+            try {
+                if(i < windows.size())
+                    errors[i] = polygonizeWindow(windows[i].first,windows[i].second);
+                else
+                    errors[i] = mergeTileGeometries(mergedComponents[i-windows.size()].first,mergedComponents[i-windows.size()].second);
+            }catch(const std::exception & e) {
+                errors[i] = e.what();
+            }
+            if(progress) {
+                std::lock_guard lock {progressMutex};
+                progress->visit();
+            }
+        },1);
+        for(auto & error: errors) {
+            if(error)
+                return error;
+        }
+        return std::nullopt;
+    }
+
+public:
+    /**
+     * @brief Construct a new Tiled Polygonizer
+     *
+     * @param source path to the raster
+     * @param maskZero skip pixels with value zero, see: GDALPolygonize(...)
+     * @param tileRows number of rows per tile
+     * @param numThreads number of tiles polygonized concurrently
+     * @param maxWindowRows maximum number of rows of a window polygonized again, components in larger windows are merged from their tiles
+     */
+    TiledPolygonizer(std::filesystem::path source, bool maskZero, size_t tileRows = DEFAULT_TILE_ROWS, size_t numThreads = std::thread::hardware_concurrency(), size_t maxWindowRows = DEFAULT_MAX_WINDOW_ROWS)
+    :source(std::move(source)),maskZero(maskZero),tileRows(std::max<size_t>(tileRows,1)),numThreads(std::max<size_t>(numThreads,1)),maxWindowRows(maxWindowRows){}
+
+    /**
+     * @brief Polygonizes the raster into the destination layer
+     *
+     * @param destinationLayer layer receiving the polygons, in the spatial reference of the raster
+     * @param pixelValueField index of the integer field storing the pixel value of each polygon
+     * @param showProgress show progress in console
+     * @return std::expected<void,std::string> error message on failure
+     */
+    std::expected<void,std::string> polygonize(OGRLayer * destinationLayer, int pixelValueField, bool showProgress = false) {
+        destination = destinationLayer;
+        fieldID = pixelValueField;
+        {
+            GDALDatasetUniquePtr src {GDALDataset::Open(source.c_str(),GDAL_OF_RASTER | GDAL_OF_READONLY)};
+            if(not src)
+                return std::unexpected("Could not open Geotiff-Dataset: "+source.string());
+            width = src->GetRasterXSize();
+            height = src->GetRasterYSize();
+            src->GetGeoTransform(geoTransform.data()); // falls back to the identity, as GDALPolygonize(...)
+        }
+        tiles = std::vector<Tile>((size_t(height)+tileRows-1)/tileRows);
+        util::ThreadPool pool {std::clamp<size_t>(tiles.size(),1,numThreads)};
+        {
+            std::optional<util::ProgressPrinter> progress;
+            if(showProgress)
+                progress.emplace(tiles.size(),"Polygonize "+source.filename().string());
+            std::mutex progressMutex;
+            std::vector<std::optional<std::string>> errors(tiles.size());
+            pool.parallelFor(0,tiles.size(),[this,&errors,&progress,&progressMutex](size_t i){
+                try {
+                    errors[i] = polygonizeTile(i);
+                }catch(const std::exception & e) {
+                    errors[i] = e.what();
+                }
+                if(progress) {
+                    std::lock_guard lock {progressMutex};
+                    progress->visit();
+                }
+            },1);
+            for(auto & error: errors) {
+                if(error)
+                    return std::unexpected(error.value());
+            }
+        }
+        if(auto error = stitchSeams(pool,showProgress))
+            return std::unexpected(error.value());
+        return {};
+    }
+};
+}
@@ -0,0 +1,27 @@
+#include <fishnet/GeometryCache.hpp>
+#include <filesystem>
+
+using namespace fishnet;
+namespace fs = std::filesystem;
+
+bool GeometryCache::remove() const noexcept {
+    std::error_code error;
+    return fs::remove(this->pathToFile,error);
+}
+
+GeometryCache & GeometryCache::move(std::filesystem::path const & path) {
+    supportsOrThrow(path);
+    fs::rename(this->pathToFile, path);
+    this->pathToFile = path;
+    return *this;
+}
+
+GeometryCache GeometryCache::copy(std::filesystem::path const & path) const {
+    supportsOrThrow(path);
+    fs::copy(this->pathToFile, path, fs::copy_options::overwrite_existing);
+    return GeometryCache(path);
+}
+
+std::string GeometryCache::toString() const noexcept {
+    return "GeometryCache: "+ this->pathToFile.string();
+}
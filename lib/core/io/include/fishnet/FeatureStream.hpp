@@ -0,0 +1,202 @@
+#pragma once
+#include <memory>
+#include <optional>
+#include <iterator>
+#include <fishnet/Shapefile.hpp>
+#include <fishnet/Either.hpp>
+#include <fishnet/Rectangle.hpp>
+#include <fishnet/GDALInitializer.hpp>
+#include <fishnet/OGRLayerAdapter.hpp>
+
+#include <gdal/gdal.h>
+#include <gdal/gdal_priv.h>
+
+namespace fishnet {
+
+/**
+ * @brief Lazy, single-pass stream over the features of a vector file.
+ * Features are read and converted one at a time while iterating, instead of materializing the whole VectorLayer.
+ * Spatial and attribute filters are pushed down to OGR (OGRLayer::SetSpatialFilterRect / OGRLayer::SetAttributeFilter),
+ * hence filtered features are never converted. Each call of begin() restarts reading from the first feature.
+ * @tparam G geometry type of the features
+ */
+template<geometry::GeometryObject G>
+class FeatureStream {
+private:
+    struct DatasetDeleter {
+        void operator()(GDALDataset * dataset) const noexcept {
+            GDALClose(dataset);
+        }
+    };
+    struct FeatureDeleter {
+        void operator()(OGRFeature * feature) const noexcept {
+            OGRFeature::DestroyFeature(feature);
+        }
+    };
+    std::unique_ptr<GDALDataset,DatasetDeleter> dataset;
+    OGRLayer * ogrLayer;
+    VectorLayer<G> schema;
+    std::optional<Feature<G>> current;
+
+    FeatureStream(GDALDataset * dataset, OGRLayer * ogrLayer)
+    :dataset(dataset),ogrLayer(ogrLayer),schema(OGRLayerAdapter<G>::schemaFromOGR(ogrLayer)){}
+
+    /**
+     * @brief Reads the next feature of type G, skipping features of other types or with invalid geometries
+     */
+    void readNext() {
+        current.reset();
+        while(not current) {
+            std::unique_ptr<OGRFeature,FeatureDeleter> ogrFeature {ogrLayer->GetNextFeature()};
+            if(not ogrFeature)
+                return;
+            current = OGRLayerAdapter<G>::featureFromOGR(*ogrFeature,schema);
+        }
+    }
+
+public:
+    class iterator {
+    private:
+        FeatureStream * stream = nullptr;
+    public:
+        using value_type = Feature<G>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::input_iterator_tag;
+
+        iterator() = default;
+        explicit iterator(FeatureStream * stream):stream(stream){}
+
+        /**
+         * @brief Access the current feature, which may be moved from
+         */
+        Feature<G> & operator*() const noexcept {
+            return stream->current.value();
+        }
+
+        Feature<G> * operator->() const noexcept {
+            return &stream->current.value();
+        }
+
+        iterator & operator++() {
+            stream->readNext();
+            return *this;
+        }
+
+        void operator++(int) {
+            ++*this;
+        }
+
+        bool operator==(std::default_sentinel_t) const noexcept {
+            return stream == nullptr || not stream->current.has_value();
+        }
+    };
+
+    /**
+     * @brief Open a stream on the first layer of a file
+     *
+     * @param path path to the vector file
+     * @param openOptions GDAL open options
+     * @return util::Either<FeatureStream<G>,std::string> stream, or error message if the file could not be opened
+     */
+    static util::Either<FeatureStream<G>,std::string> open(const std::filesystem::path & path, const std::vector<std::string> & openOptions = {}) {
+        GDALInitializer::init();
+        if(not std::filesystem::exists(path))
+            return std::unexpected("File does not exists, could not read from File: \"" + path.string() + "\"");
+        std::vector<const char*> options;
+        for (const auto& option : openOptions) {
+            options.push_back(option.c_str());
+        }
+        options.push_back(nullptr);
+        auto * ds = (GDALDataset *) GDALOpenEx(path.c_str(), GDAL_OF_VECTOR,nullptr, options.data(),nullptr);
+        if(ds == nullptr)
+            return std::unexpected("Could not open vector file: \"" + path.string() + "\"");
+        OGRLayer * layer = ds->GetLayer(0);
+        if(layer == nullptr) {
+            GDALClose(ds);
+            return std::unexpected("Vector file contains no layer: \"" + path.string() + "\"");
+        }
+        return FeatureStream(ds,layer);
+    }
+
+    FeatureStream(FeatureStream && other) noexcept = default;
+    FeatureStream & operator=(FeatureStream && other) noexcept = default;
+    FeatureStream(const FeatureStream &) = delete;
+    FeatureStream & operator=(const FeatureStream &) = delete;
+
+    /**
+     * @brief Only stream features whose geometry intersects the rectangle (in coordinates of the spatial reference of the file)
+     *
+     * @param boundingBox rectangle
+     * @return FeatureStream& this stream
+     */
+    template<typename T>
+    FeatureStream & setSpatialFilter(const geometry::Rectangle<T> & boundingBox) noexcept {
+        ogrLayer->SetSpatialFilterRect(double(boundingBox.left()),double(boundingBox.bottom()),double(boundingBox.right()),double(boundingBox.top()));
+        return *this;
+    }
+
+    FeatureStream & clearSpatialFilter() noexcept {
+        ogrLayer->SetSpatialFilter(nullptr);
+        return *this;
+    }
+
+    /**
+     * @brief Only stream features satisfying the attribute query, e.g. "FISHNET_ID < 10"
+     * https://gdal.org/user/ogr_sql_dialect.html#where
+     * @throws invalid_argument if OGR can not parse the query
+     * @param query where clause of an OGR SQL query, an empty query removes the filter
+     * @return FeatureStream& this stream
+     */
+    FeatureStream & setAttributeFilter(const std::string & query) {
+        if(ogrLayer->SetAttributeFilter(query.empty() ? nullptr : query.c_str()) != OGRERR_NONE)
+            throw std::invalid_argument("Invalid attribute filter: \"" + query + "\"");
+        return *this;
+    }
+
+    /**
+     * @brief Get the number of features passing the filters. May require a full scan of the file, if OGR can not compute it directly.
+     *
+     * @return size_t number of features
+     */
+    size_t featureCount() const noexcept {
+        return size_t(std::max<GIntBig>(ogrLayer->GetFeatureCount(),0));
+    }
+
+    /**
+     * @brief Get the empty layer defining the fields and the spatial reference of the streamed features
+     *
+     * @return const VectorLayer<G>& layer without features
+     */
+    const VectorLayer<G> & getSchema() const noexcept {
+        return schema;
+    }
+
+    const OGRSpatialReference & getSpatialReference() const noexcept {
+        return schema.getSpatialReference();
+    }
+
+    iterator begin() {
+        ogrLayer->ResetReading();
+        readNext();
+        return iterator(this);
+    }
+
+    std::default_sentinel_t end() const noexcept {
+        return std::default_sentinel;
+    }
+
+    /**
+     * @brief Read all features passing the filters into a layer with the fields and spatial reference of the file
+     *
+     * @return VectorLayer<G>
+     */
+    VectorLayer<G> collect() {
+        VectorLayer<G> layer = schema;
+        for(auto & feature: *this) {
+            layer.addFeature(std::move(feature));
+        }
+        return layer;
+    }
+};
+static_assert(std::ranges::input_range<FeatureStream<geometry::Polygon<double>>>);
+}
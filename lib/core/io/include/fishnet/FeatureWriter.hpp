@@ -0,0 +1,116 @@
+#pragma once
+#include <memory>
+#include <fishnet/Shapefile.hpp>
+#include <fishnet/Either.hpp>
+#include <fishnet/GDALInitializer.hpp>
+#include <fishnet/GeometryTypeWKBAdapter.hpp>
+#include <fishnet/OGRLayerAdapter.hpp>
+
+#include <gdal/gdal.h>
+#include <gdal/gdal_priv.h>
+
+namespace fishnet {
+
+/**
+ * @brief Incremental writer for the features of a shapefile, counterpart of the FeatureStream.
+ * Features are converted and written one at a time, instead of materializing the whole VectorLayer before writing.
+ * The file is completed when the writer is closed or destroyed.
+ * @tparam G geometry type of the features
+ */
+template<geometry::GeometryObject G>
+class FeatureWriter {
+private:
+    struct DatasetDeleter {
+        void operator()(GDALDataset * dataset) const noexcept {
+            GDALClose(dataset);
+        }
+    };
+    std::unique_ptr<GDALDataset,DatasetDeleter> dataset;
+    OGRLayer * ogrLayer;
+    VectorLayer<G> schema;
+    size_t written = 0;
+
+    FeatureWriter(GDALDataset * dataset, OGRLayer * ogrLayer, VectorLayer<G> && schema)
+    :dataset(dataset),ogrLayer(ogrLayer),schema(std::move(schema)){}
+
+public:
+    /**
+     * @brief Create a writer on a new shapefile. Already existing files are overwritten
+     *
+     * @param output shapefile to be created
+     * @param schema layer defining the fields and the spatial reference of the written features (features of the layer are ignored)
+     * @return util::Either<FeatureWriter<G>,std::string> writer, or error message if the file could not be created
+     */
+    static util::Either<FeatureWriter<G>,std::string> create(const Shapefile & output, const VectorLayer<G> & schema) {
+        GDALInitializer::init();
+        GDALDriver * driver = GetGDALDriverManager()->GetDriverByName("ESRI Shapefile");
+        if (driver == nullptr)
+            return std::unexpected("Could not find GDAL driver for ESRI Shapefile");
+        output.remove(); // delete already existing files, if present
+        GDALDataset * ds = driver->Create(output.getPath().c_str(),0,0,0,GDT_Unknown,0);
+        if(ds == nullptr)
+            return std::unexpected("Could not create shapefile: \"" + output.getPath().string() + "\"");
+        const char * const options[] = {"SPATIAL_INDEX=YES",nullptr};
+        OGRLayer * layer = ds->CreateLayer(output.getPath().c_str(),schema.getSpatialReference().Clone(),GeometryTypeWKBAdapter::toWKB(G::type),const_cast<char **>(options));
+        if(layer == nullptr) {
+            GDALClose(ds);
+            return std::unexpected("Could not create layer in shapefile: \"" + output.getPath().string() + "\"");
+        }
+        VectorLayer<G> emptySchema {schema.getSpatialReference()};
+        schema.copyFields(emptySchema);
+        OGRLayerAdapter<G>::schemaToOGR(emptySchema,layer);
+        return FeatureWriter(ds,layer,std::move(emptySchema));
+    }
+
+    FeatureWriter(FeatureWriter && other) noexcept = default;
+    FeatureWriter & operator=(FeatureWriter && other) noexcept = default;
+    FeatureWriter(const FeatureWriter &) = delete;
+    FeatureWriter & operator=(const FeatureWriter &) = delete;
+
+    /**
+     * @brief Writes a feature, with the attributes of all fields of the schema
+     *
+     * @param feature feature to be written
+     * @throws runtime_error if the writer is closed or the feature could not be written
+     * @return FeatureWriter& this writer
+     */
+    FeatureWriter & write(const Feature<G> & feature) {
+        if(not dataset)
+            throw std::runtime_error("Write on closed feature writer");
+        OGRLayerAdapter<G>::featureToOGR(feature,schema,ogrLayer).value_or_throw();
+        written++;
+        return *this;
+    }
+
+    /**
+     * @brief Get the empty layer defining the fields and the spatial reference of the written features.
+     * Features have to use the field definitions of this layer
+     *
+     * @return const VectorLayer<G>& layer without features
+     */
+    const VectorLayer<G> & getSchema() const noexcept {
+        return schema;
+    }
+
+    /**
+     * @brief Get the number of features written so far
+     */
+    size_t size() const noexcept {
+        return written;
+    }
+
+    /**
+     * @brief Flushes the features to disk and closes the file. Further writes fail
+     */
+    void close() noexcept {
+        if(not dataset)
+            return;
+        ogrLayer->SyncToDisk();
+        dataset.reset();
+    }
+
+    ~FeatureWriter() {
+        close();
+    }
+};
+}
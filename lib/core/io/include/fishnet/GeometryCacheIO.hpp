@@ -0,0 +1,666 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <fishnet/IOConcepts.hpp>
+#include <fishnet/GeometryCache.hpp>
+#include <fishnet/Polygon.hpp>
+#include <fishnet/MultiPolygon.hpp>
+#include <fishnet/Rectangle.hpp>
+
+#include <gdal/ogr_spatialref.h>
+#include <gdal/cpl_conv.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace fishnet::__impl::geometry_cache {
+static_assert(std::endian::native == std::endian::little, "Geometry caches are stored in little endian byte order");
+
+constexpr static std::array<char,8> MAGIC = {'F','N','G','C','A','C','H','E'};
+constexpr static uint32_t VERSION = 1;
+constexpr static size_t ALIGNMENT = 8;
+constexpr static size_t MAX_FIELD_NAME_LENGTH = 15;
+
+/**
+ * @brief File header, followed by the sections it references.
+ * Offsets are in bytes from the start of the file and aligned to 8 bytes, such that the sections of a mapped file can be accessed in place.
+ * Coordinates are stored as flat arrays, polygons and rings are delimited by offset arrays with one more entry than elements:
+ * the rings of polygon p are [polygonRings[p],polygonRings[p+1]), the first ring of each polygon is its boundary,
+ * the points of ring r are [ringPoints[r],ringPoints[r+1]) without repeating the first point.
+ */
+struct Header {
+    std::array<char,8> magic;
+    uint32_t version;
+    uint32_t geometryType; // geometry::GeometryType of the features
+    uint64_t featureCount;
+    uint64_t polygonCount;
+    uint64_t ringCount;
+    uint64_t pointCount;
+    uint64_t fieldCount;
+    uint64_t spatialReference; // WKT of the spatial reference, not null-terminated
+    uint64_t spatialReferenceLength;
+    uint64_t boundingBoxes; // BoundingBox[featureCount]
+    uint64_t featureIds; // uint64_t[featureCount]
+    uint64_t featurePolygons; // uint64_t[featureCount+1]
+    uint64_t polygonRings; // uint64_t[polygonCount+1]
+    uint64_t ringPoints; // uint64_t[ringCount+1]
+    uint64_t xCoordinates; // double[pointCount]
+    uint64_t yCoordinates; // double[pointCount]
+    uint64_t fields; // FieldHeader[fieldCount]
+    uint64_t fileSize;
+};
+
+/**
+ * @brief Column of a field. Numeric values are stored as 8 bytes per feature (double for floating point, int64 / uint64 otherwise).
+ * Text values are stored as offsets (uint64_t[featureCount+1]) into the concatenated characters.
+ */
+struct FieldHeader {
+    std::array<char,MAX_FIELD_NAME_LENGTH+1> name; // null-terminated
+    uint64_t type; // index of the value type in FieldType
+    uint64_t values;
+    uint64_t present; // uint8_t[featureCount], non-zero if the feature has a value for the field
+    uint64_t text;
+    uint64_t textLength;
+};
+
+struct BoundingBox {
+    double left;
+    double top;
+    double right;
+    double bottom;
+};
+
+static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) % ALIGNMENT == 0);
+static_assert(std::is_trivially_copyable_v<FieldHeader> && sizeof(FieldHeader) % ALIGNMENT == 0);
+static_assert(std::is_trivially_copyable_v<BoundingBox> && sizeof(BoundingBox) == 4*sizeof(double));
+
+template<typename G>
+concept CacheableGeometry = geometry::GeometryObject<G> && (G::type == geometry::GeometryType::POLYGON || G::type == geometry::GeometryType::MULTIPOLYGON);
+
+/**
+ * @brief Growing byte buffer, in which the sections of a geometry cache are assembled
+ */
+class Buffer {
+private:
+    std::vector<char> bytes;
+public:
+    void align() {
+        bytes.resize((bytes.size() + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT,0);
+    }
+
+    /**
+     * @brief Appends the values at the next aligned offset
+     * @return uint64_t offset of the first value
+     */
+    template<typename T>
+    uint64_t append(std::span<const T> values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        align();
+        uint64_t offset = bytes.size();
+        bytes.resize(offset + values.size_bytes());
+        if(not values.empty())
+            std::memcpy(bytes.data()+offset,values.data(),values.size_bytes());
+        return offset;
+    }
+
+    template<typename T>
+    void overwrite(uint64_t offset, const T & value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        std::memcpy(bytes.data()+offset,&value,sizeof(T));
+    }
+
+    size_t size() const noexcept {
+        return bytes.size();
+    }
+
+    const char * data() const noexcept {
+        return bytes.data();
+    }
+};
+
+template<FieldValueType T>
+constexpr bool isText() noexcept {
+    return std::same_as<T,std::string> || std::same_as<T,const char *>;
+}
+
+/**
+ * @brief Stores numeric field values in 8 bytes
+ */
+template<FieldValueType T>
+uint64_t encode(T value) noexcept {
+    if constexpr(std::floating_point<T>)
+        return std::bit_cast<uint64_t>(double(value));
+    else if constexpr(std::signed_integral<T>)
+        return std::bit_cast<uint64_t>(int64_t(value));
+    else
+        return uint64_t(value);
+}
+
+template<FieldValueType T>
+T decode(uint64_t value) noexcept {
+    if constexpr(std::floating_point<T>)
+        return T(std::bit_cast<double>(value));
+    else if constexpr(std::signed_integral<T>)
+        return T(std::bit_cast<int64_t>(value));
+    else
+        return T(value);
+}
+
+/**
+ * @brief Calls f with std::type_identity of the type with the given index in FieldType, to dispatch on the value type
+ * @return false if the index is out of range
+ */
+template<size_t I = 0>
+bool visitFieldType(uint64_t typeIndex, auto && f) {
+    if constexpr(I < std::variant_size_v<FieldType>) {
+        if(typeIndex == I) {
+            using T = std::variant_alternative_t<I,FieldType>;
+            f(std::type_identity<T>());
+            return true;
+        }
+        return visitFieldType<I+1>(typeIndex,f);
+    }else {
+        return false;
+    }
+}
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ */
+class MappedFile {
+private:
+    const char * address = nullptr;
+    size_t length = 0;
+    MappedFile(const char * address, size_t length):address(address),length(length){}
+public:
+    static util::Either<MappedFile,std::string> open(const std::filesystem::path & path) noexcept {
+        int fd = ::open(path.c_str(),O_RDONLY);
+        if(fd < 0)
+            return std::unexpected("Could not open file: \"" + path.string() + "\"");
+        struct stat status {};
+        if(::fstat(fd,&status) != 0 || status.st_size <= 0) {
+            ::close(fd);
+            return std::unexpected("Could not determine size of file or file is empty: \"" + path.string() + "\"");
+        }
+        size_t size = size_t(status.st_size);
+        void * mapped = ::mmap(nullptr,size,PROT_READ,MAP_PRIVATE,fd,0);
+        ::close(fd); // the mapping keeps the file open
+        if(mapped == MAP_FAILED)
+            return std::unexpected("Could not map file into memory: \"" + path.string() + "\"");
+        return MappedFile(static_cast<const char *>(mapped),size);
+    }
+
+    MappedFile(MappedFile && other) noexcept:address(std::exchange(other.address,nullptr)),length(std::exchange(other.length,0)){}
+
+    MappedFile & operator=(MappedFile && other) noexcept {
+        if(this != &other) {
+            this->~MappedFile();
+            address = std::exchange(other.address,nullptr);
+            length = std::exchange(other.length,0);
+        }
+        return *this;
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    ~MappedFile() {
+        if(address != nullptr)
+            ::munmap(const_cast<char *>(address),length);
+    }
+
+    const char * data() const noexcept {
+        return address;
+    }
+
+    size_t size() const noexcept {
+        return length;
+    }
+};
+}
+
+namespace fishnet {
+/**
+ * @brief Zero-copy, read-only view on a memory-mapped GeometryCache.
+ * Coordinates, offsets, bounding boxes, feature ids and field values are accessed in place, geometries are only
+ * materialized on request and without re-verifying their rings, since the cache is written from valid geometries.
+ * The file layout is described in __impl::geometry_cache::Header.
+ */
+class MappedGeometryCache {
+private:
+    using Header = __impl::geometry_cache::Header;
+    using FieldHeader = __impl::geometry_cache::FieldHeader;
+    __impl::geometry_cache::MappedFile file;
+    Header header;
+
+    MappedGeometryCache(__impl::geometry_cache::MappedFile && file, const Header & header):file(std::move(file)),header(header){}
+
+    template<typename T>
+    std::span<const T> section(uint64_t offset, uint64_t count) const noexcept {
+        return {reinterpret_cast<const T *>(file.data()+offset),size_t(count)};
+    }
+
+    static bool validSection(const Header & header, uint64_t offset, uint64_t count, size_t elementSize) noexcept {
+        return offset % __impl::geometry_cache::ALIGNMENT == 0 && offset <= header.fileSize && count <= (header.fileSize - offset) / elementSize;
+    }
+
+    /**
+     * @brief Section of an offset array with count+1 entries, rejects counts for which count+1 overflows
+     */
+    static bool validOffsetSection(const Header & header, uint64_t offset, uint64_t count) noexcept {
+        return count < std::numeric_limits<uint64_t>::max() && validSection(header,offset,count+1,sizeof(uint64_t));
+    }
+
+    /**
+     * @brief Offsets have to start at 0, end at total and delimit at least minEntries entries per element, e.g. each polygon has a boundary ring
+     */
+    static bool validOffsets(std::span<const uint64_t> offsets, uint64_t total, uint64_t minEntries = 0) noexcept {
+        if(offsets.empty() || offsets.front() != 0 || offsets.back() != total)
+            return false;
+        return std::ranges::adjacent_find(offsets,[minEntries](uint64_t current, uint64_t next){
+            return next < current || next - current < minEntries;
+        }) == offsets.end();
+    }
+
+    template<typename T>
+    static geometry::Ring<T> toRing(std::span<const double> xs, std::span<const double> ys) {
+        std::vector<geometry::Vec2D<T>> points;
+        points.reserve(xs.size());
+        for(size_t i = 0; i < xs.size(); ++i) {
+            points.emplace_back(T(xs[i]),T(ys[i]));
+        }
+        return geometry::Ring<T>(points,true);
+    }
+
+public:
+    using BoundingBox = __impl::geometry_cache::BoundingBox;
+
+    /**
+     * @brief Map a geometry cache into memory and validate its header and offset arrays
+     *
+     * @param cache geometry cache file
+     * @return util::Either<MappedGeometryCache,std::string> view, or error message if the file is not a valid geometry cache
+     */
+    static util::Either<MappedGeometryCache,std::string> open(const GeometryCache & cache) noexcept {
+        using namespace __impl::geometry_cache;
+        auto mapped = MappedFile::open(cache.getPath());
+        if(not mapped)
+            return std::unexpected(mapped.error());
+        const std::string invalid = "Invalid geometry cache: \"" + cache.getPath().string() + "\"";
+        if(mapped->size() < sizeof(Header))
+            return std::unexpected(invalid);
+        Header header;
+        std::memcpy(&header,mapped->data(),sizeof(Header));
+        if(header.magic != MAGIC || header.version != VERSION || header.fileSize != mapped->size())
+            return std::unexpected(invalid);
+        if(not validSection(header,header.spatialReference,header.spatialReferenceLength,1)
+            || not validSection(header,header.boundingBoxes,header.featureCount,sizeof(BoundingBox))
+            || not validSection(header,header.featureIds,header.featureCount,sizeof(uint64_t))
+            || not validOffsetSection(header,header.featurePolygons,header.featureCount)
+            || not validOffsetSection(header,header.polygonRings,header.polygonCount)
+            || not validOffsetSection(header,header.ringPoints,header.ringCount)
+            || not validSection(header,header.xCoordinates,header.pointCount,sizeof(double))
+            || not validSection(header,header.yCoordinates,header.pointCount,sizeof(double))
+            || not validSection(header,header.fields,header.fieldCount,sizeof(FieldHeader)))
+            return std::unexpected(invalid);
+        MappedGeometryCache view {std::move(mapped.value()),header};
+        if(not validOffsets(view.featurePolygonOffsets(),header.polygonCount)
+            || not validOffsets(view.polygonRingOffsets(),header.ringCount,1)
+            || not validOffsets(view.ringPointOffsets(),header.pointCount,3)) // rings have at least three points
+            return std::unexpected(invalid);
+        for(const auto & field: view.fieldHeaders()) {
+            bool text = false;
+            if(field.name.back() != '\0' || not visitFieldType(field.type,[&text]<typename T>(std::type_identity<T>){text = isText<T>();}))
+                return std::unexpected(invalid);
+            if(not validSection(header,field.present,header.featureCount,1))
+                return std::unexpected(invalid);
+            if(text) {
+                if(not validOffsetSection(header,field.values,header.featureCount)
+                    || not validSection(header,field.text,field.textLength,1)
+                    || not validOffsets(view.section<uint64_t>(field.values,header.featureCount+1),field.textLength))
+                    return std::unexpected(invalid);
+            }else if(not validSection(header,field.values,header.featureCount,sizeof(uint64_t))) {
+                return std::unexpected(invalid);
+            }
+        }
+        return view;
+    }
+
+    MappedGeometryCache(MappedGeometryCache &&) noexcept = default;
+    MappedGeometryCache & operator=(MappedGeometryCache &&) noexcept = default;
+
+    size_t size() const noexcept {
+        return size_t(header.featureCount);
+    }
+
+    geometry::GeometryType geometryType() const noexcept {
+        return geometry::GeometryType(header.geometryType);
+    }
+
+    std::string_view spatialReferenceWkt() const noexcept {
+        return {file.data()+header.spatialReference,size_t(header.spatialReferenceLength)};
+    }
+
+    OGRSpatialReference spatialReference() const {
+        OGRSpatialReference spatialReference;
+        std::string wkt {spatialReferenceWkt()};
+        if(not wkt.empty())
+            spatialReference.importFromWkt(wkt.c_str());
+        return spatialReference;
+    }
+
+    std::span<const BoundingBox> boundingBoxes() const noexcept {
+        return section<BoundingBox>(header.boundingBoxes,header.featureCount);
+    }
+
+    geometry::Rectangle<double> boundingBox(size_t feature) const noexcept {
+        const auto & box = boundingBoxes()[feature];
+        return geometry::Rectangle<double>(box.left,box.top,box.right,box.bottom);
+    }
+
+    std::span<const uint64_t> featureIds() const noexcept {
+        return section<uint64_t>(header.featureIds,header.featureCount);
+    }
+
+    std::span<const uint64_t> featurePolygonOffsets() const noexcept {
+        return section<uint64_t>(header.featurePolygons,header.featureCount+1);
+    }
+
+    std::span<const uint64_t> polygonRingOffsets() const noexcept {
+        return section<uint64_t>(header.polygonRings,header.polygonCount+1);
+    }
+
+    std::span<const uint64_t> ringPointOffsets() const noexcept {
+        return section<uint64_t>(header.ringPoints,header.ringCount+1);
+    }
+
+    std::span<const double> xCoordinates() const noexcept {
+        return section<double>(header.xCoordinates,header.pointCount);
+    }
+
+    std::span<const double> yCoordinates() const noexcept {
+        return section<double>(header.yCoordinates,header.pointCount);
+    }
+
+    std::span<const FieldHeader> fieldHeaders() const noexcept {
+        return section<FieldHeader>(header.fields,header.fieldCount);
+    }
+
+    /**
+     * @brief Get whether each feature has a value for the field
+     */
+    std::span<const uint8_t> fieldPresence(const FieldHeader & field) const noexcept {
+        return section<uint8_t>(field.present,header.featureCount);
+    }
+
+    /**
+     * @brief Get the encoded values of a numeric field, see: __impl::geometry_cache::decode()
+     */
+    std::span<const uint64_t> numericValues(const FieldHeader & field) const noexcept {
+        return section<uint64_t>(field.values,header.featureCount);
+    }
+
+    std::string_view textValue(const FieldHeader & field, size_t feature) const noexcept {
+        auto offsets = section<uint64_t>(field.values,header.featureCount+1);
+        return {file.data()+field.text+offsets[feature],size_t(offsets[feature+1]-offsets[feature])};
+    }
+
+    /**
+     * @brief Materializes a polygon of the cache, without verifying its rings
+     *
+     * @tparam T numeric type of the polygon
+     * @param index index of the polygon, see featurePolygonOffsets()
+     * @return geometry::Polygon<T>
+     */
+    template<math::Number T = double>
+    geometry::Polygon<T> polygon(size_t index) const {
+        auto rings = polygonRingOffsets();
+        auto points = ringPointOffsets();
+        auto xs = xCoordinates();
+        auto ys = yCoordinates();
+        auto ring = [&](size_t r){
+            size_t begin = points[r];
+            size_t count = points[r+1] - begin;
+            return toRing<T>(xs.subspan(begin,count),ys.subspan(begin,count));
+        };
+        std::vector<geometry::Ring<T>> holes;
+        holes.reserve(rings[index+1] - rings[index] - 1);
+        for(size_t r = rings[index] + 1; r < rings[index+1]; ++r) {
+            holes.push_back(ring(r));
+        }
+        return geometry::Polygon<T>(ring(rings[index]),std::move(holes),true);
+    }
+
+    /**
+     * @brief Materializes the geometry of a feature, without verifying its rings
+     *
+     * @tparam G geometry type, polygon or multi-polygon
+     * @param feature index of the feature
+     * @return G geometry of the feature
+     */
+    template<__impl::geometry_cache::CacheableGeometry G>
+    G geometry(size_t feature) const {
+        using T = typename G::numeric_type;
+        auto offsets = featurePolygonOffsets();
+        if constexpr(G::type == geometry::GeometryType::MULTIPOLYGON) {
+            std::vector<typename G::polygon_type> polygons;
+            for(size_t p = offsets[feature]; p < offsets[feature+1]; ++p) {
+                polygons.push_back(polygon<T>(p));
+            }
+            return G(polygons,true);
+        }else {
+            return polygon<T>(offsets[feature]);
+        }
+    }
+};
+
+/**
+ * @brief Reads a VectorLayer from a GeometryCache, including the fields and the spatial reference
+ *
+ * @tparam G geometry type, polygon or multi-polygon. Features of a multi-polygon cache are skipped when reading polygons, unless they consist of a single polygon.
+ */
+template<geometry::GeometryObject G>
+class GeometryCacheReader {
+public:
+    using geometry_type = G;
+    using file_type = GeometryCache;
+
+    util::Either<VectorLayer<G>,std::string> operator()(const GeometryCache & cache) const {
+        static_assert(__impl::geometry_cache::CacheableGeometry<G>, "Geometry caches store polygons and multi-polygons only");
+        auto mapped = MappedGeometryCache::open(cache);
+        if(not mapped)
+            return std::unexpected(mapped.error());
+        const MappedGeometryCache & view = mapped.value();
+        VectorLayer<G> layer {view.spatialReference()};
+        std::vector<std::function<void(Feature<G> &,size_t)>> attributeReaders;
+        for(const auto & field: view.fieldHeaders()) {
+            __impl::geometry_cache::visitFieldType(field.type,[&]<typename T>(std::type_identity<T>){
+                using namespace __impl::geometry_cache;
+                using ValueType = std::conditional_t<isText<T>(),std::string,T>;
+                auto fieldDefinition = layer.template addField<ValueType>(std::string(field.name.data()));
+                if(not fieldDefinition)
+                    return;
+                attributeReaders.push_back([&view,&field,definition = fieldDefinition.value()](Feature<G> & feature, size_t index){
+                    if(view.fieldPresence(field)[index] == 0)
+                        return;
+                    if constexpr(isText<T>()) {
+                        feature.addAttribute(definition,std::string(view.textValue(field,index)));
+                    }else {
+                        feature.addAttribute(definition,decode<T>(view.numericValues(field)[index]));
+                    }
+                });
+            });
+        }
+        for(size_t i = 0; i < view.size(); ++i) {
+            if constexpr(G::type == geometry::GeometryType::POLYGON) {
+                auto polygons = view.featurePolygonOffsets();
+                if(polygons[i+1] - polygons[i] != 1)
+                    continue;
+            }
+            Feature<G> feature {view.geometry<G>(i)};
+            for(const auto & reader: attributeReaders) {
+                reader(feature,i);
+            }
+            layer.addFeature(std::move(feature));
+        }
+        return layer;
+    }
+};
+
+/**
+ * @brief Writes a VectorLayer to a GeometryCache, including the fields and the spatial reference
+ *
+ * @tparam G geometry type, polygon or multi-polygon
+ */
+template<geometry::GeometryObject G>
+class GeometryCacheWriter {
+private:
+    std::optional<std::string> idFieldName;
+
+    template<FieldValueType T>
+    static __impl::geometry_cache::FieldHeader writeField(__impl::geometry_cache::Buffer & buffer, const VectorLayer<G> & layer, const FieldDefinition<T> & definition) {
+        using namespace __impl::geometry_cache;
+        FieldHeader field {};
+        std::ranges::copy_n(definition.getFieldName().begin(),std::min(definition.getFieldName().size(),MAX_FIELD_NAME_LENGTH),field.name.begin());
+        field.type = FieldType(T()).index();
+        std::vector<uint8_t> present;
+        present.reserve(layer.size());
+        if constexpr(isText<T>()) {
+            std::vector<uint64_t> offsets {0};
+            std::string text;
+            for(const auto & feature: layer.getFeatures()) {
+                auto value = feature.getAttribute(definition);
+                present.push_back(value.has_value());
+                if(value)
+                    text += value.value();
+                offsets.push_back(text.size());
+            }
+            field.values = buffer.append(std::span<const uint64_t>(offsets));
+            field.text = buffer.append(std::span<const char>(text));
+            field.textLength = text.size();
+        }else {
+            std::vector<uint64_t> values;
+            values.reserve(layer.size());
+            for(const auto & feature: layer.getFeatures()) {
+                auto value = feature.getAttribute(definition);
+                present.push_back(value.has_value());
+                values.push_back(value ? encode<T>(value.value()) : 0);
+            }
+            field.values = buffer.append(std::span<const uint64_t>(values));
+        }
+        field.present = buffer.append(std::span<const uint8_t>(present));
+        return field;
+    }
+
+public:
+    GeometryCacheWriter() = default;
+
+    /**
+     * @brief Construct a new Geometry Cache Writer
+     *
+     * @param idFieldName name of the size field (e.g. FISHNET_ID) stored as feature ids. Without this field, the index of the feature is stored.
+     */
+    explicit GeometryCacheWriter(std::string idFieldName):idFieldName(std::move(idFieldName)){}
+
+    util::Either<GeometryCache,std::string> operator()(const VectorLayer<G> & layer, const GeometryCache & output) const {
+        using namespace __impl::geometry_cache;
+        static_assert(CacheableGeometry<G>, "Geometry caches store polygons and multi-polygons only");
+        std::vector<BoundingBox> boundingBoxes;
+        std::vector<uint64_t> featureIds;
+        std::vector<uint64_t> featurePolygons {0};
+        std::vector<uint64_t> polygonRings {0};
+        std::vector<uint64_t> ringPoints {0};
+        std::vector<double> xs;
+        std::vector<double> ys;
+        boundingBoxes.reserve(layer.size());
+        featureIds.reserve(layer.size());
+        auto idField = idFieldName ? layer.getSizeField(idFieldName.value()) : std::nullopt;
+        auto addRing = [&](const auto & ring){
+            for(const auto & point: ring.getPoints()) {
+                xs.push_back(double(point.x));
+                ys.push_back(double(point.y));
+            }
+            ringPoints.push_back(xs.size());
+        };
+        auto addPolygon = [&](const auto & polygon, BoundingBox & box){
+            size_t first = xs.size();
+            addRing(polygon.getBoundary());
+            box.left = std::min(box.left,*std::ranges::min_element(std::span(xs).subspan(first)));
+            box.right = std::max(box.right,*std::ranges::max_element(std::span(xs).subspan(first)));
+            box.bottom = std::min(box.bottom,*std::ranges::min_element(std::span(ys).subspan(first)));
+            box.top = std::max(box.top,*std::ranges::max_element(std::span(ys).subspan(first)));
+            for(const auto & hole: polygon.getHoles()) {
+                addRing(hole);
+            }
+            polygonRings.push_back(ringPoints.size()-1);
+        };
+        for(const auto & feature: layer.getFeatures()) {
+            constexpr double infinity = std::numeric_limits<double>::infinity();
+            BoundingBox box {infinity,-infinity,-infinity,infinity};
+            if constexpr(G::type == geometry::GeometryType::MULTIPOLYGON) {
+                for(const auto & polygon: feature.getGeometry().getPolygons()) {
+                    addPolygon(polygon,box);
+                }
+            }else {
+                addPolygon(feature.getGeometry(),box);
+            }
+            featurePolygons.push_back(polygonRings.size()-1);
+            boundingBoxes.push_back(box);
+            size_t index = featureIds.size();
+            featureIds.push_back(idField ? feature.getAttribute(idField.value()).value_or(index) : index);
+        }
+        char * wkt = nullptr;
+        layer.getSpatialReference().exportToWkt(&wkt);
+        std::string spatialReference = wkt ? wkt : "";
+        CPLFree(wkt);
+
+        Buffer buffer;
+        Header header {};
+        buffer.append(std::span<const Header>(&header,1));
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.geometryType = uint32_t(G::type);
+        header.featureCount = layer.size();
+        header.polygonCount = polygonRings.size()-1;
+        header.ringCount = ringPoints.size()-1;
+        header.pointCount = xs.size();
+        header.spatialReference = buffer.append(std::span<const char>(spatialReference));
+        header.spatialReferenceLength = spatialReference.size();
+        header.boundingBoxes = buffer.append(std::span<const BoundingBox>(boundingBoxes));
+        header.featureIds = buffer.append(std::span<const uint64_t>(featureIds));
+        header.featurePolygons = buffer.append(std::span<const uint64_t>(featurePolygons));
+        header.polygonRings = buffer.append(std::span<const uint64_t>(polygonRings));
+        header.ringPoints = buffer.append(std::span<const uint64_t>(ringPoints));
+        header.xCoordinates = buffer.append(std::span<const double>(xs));
+        header.yCoordinates = buffer.append(std::span<const double>(ys));
+        std::vector<FieldHeader> fields;
+        for(const auto & [_,fieldDefinition]: layer.getFieldsMap()) {
+            std::visit([&](const auto & definition){
+                fields.push_back(writeField(buffer,layer,definition));
+            },fieldDefinition);
+        }
+        header.fieldCount = fields.size();
+        header.fields = buffer.append(std::span<const FieldHeader>(fields));
+        buffer.align();
+        header.fileSize = buffer.size();
+        buffer.overwrite(0,header);
+
+        output.remove(); // delete already existing file, if present
+        std::ofstream stream {output.getPath(),std::ios::binary | std::ios::trunc};
+        if(not stream.write(buffer.data(),std::streamsize(buffer.size())))
+            return std::unexpected("Could not write geometry cache: \"" + output.getPath().string() + "\"");
+        return output;
+    }
+};
+
+static_assert(VectorLayerReader<GeometryCacheReader<geometry::Polygon<double>>, GeometryCache, geometry::Polygon<double>>, "GeometryCacheReader must satisfy VectorLayerReader concept");
+static_assert(VectorLayerWriter<GeometryCacheWriter<geometry::Polygon<double>>, geometry::Polygon<double>, GeometryCache>, "GeometryCacheWriter must satisfy VectorLayerWriter concept");
+}
@@ -1,6 +1,9 @@
 #pragma once
 #include <fishnet/VectorLayer.hpp>
 #include <fishnet/ShapefileIO.hpp>
+#include <fishnet/GeometryCacheIO.hpp>
+#include <fishnet/FeatureStream.hpp>
+#include <fishnet/FeatureWriter.hpp>
 #include <fishnet/Either.hpp>
 #include <regex>
 
@@ -100,6 +103,73 @@ inline VectorLayer<geometry::Polygon<double>> readPolygonLayer(const Shapefile &
     return read<geometry::Polygon<double>>(shapefile);
 }
 
+template<geometry::GeometryObject G>
+VectorLayer<G> read(const GeometryCache & cache) {
+    return read(GeometryCacheReader<G>(), cache);
+}
+
+/**
+ * @brief Reads a VectorLayer from a vector file, choosing the reader by the file extension (.shp or .fgc)
+ * 
+ * @tparam G geometry type of the layer
+ * @param path path to the vector file
+ * @return util::Either<VectorLayer<G>,std::string> layer, or error message if the file could not be read or its type is not supported
+ */
+template<geometry::GeometryObject G>
+util::Either<VectorLayer<G>,std::string> tryRead(const std::filesystem::path & path) {
+    auto fileType = getGISFileType(path);
+    if(not fileType)
+        return std::unexpected("Unsupported vector file type: \"" + path.string() + "\"");
+    switch(fileType.value()) {
+        case GISFileType::SHAPEFILE:
+            return tryRead(ShapefileReader<G>(),Shapefile(path));
+        case GISFileType::GEOMETRY_CACHE:
+            return tryRead(GeometryCacheReader<G>(),GeometryCache(path));
+        default:
+            return std::unexpected("Unsupported vector file type: \"" + path.string() + "\"");
+    }
+}
+
+template<geometry::GeometryObject G>
+VectorLayer<G> read(const std::filesystem::path & path) {
+    return tryRead<G>(path).value_or_throw();
+}
+
+/**
+ * @brief Opens a lazy stream over the features of the shapefile, see FeatureStream
+ * 
+ * @tparam G geometry type of the features
+ * @param shapefile input file
+ * @return util::Either<FeatureStream<G>,std::string> stream, or error message if the file could not be opened
+ */
+template<geometry::GeometryObject G>
+util::Either<FeatureStream<G>,std::string> tryStream(const Shapefile & shapefile) {
+    return FeatureStream<G>::open(shapefile.getPath(),{"ADJUST_TYPE=YES"});
+}
+
+template<geometry::GeometryObject G>
+FeatureStream<G> stream(const Shapefile & shapefile) {
+    return tryStream<G>(shapefile).value_or_throw();
+}
+
+/**
+ * @brief Creates an incremental writer on the shapefile, overwriting existing files, see FeatureWriter
+ * 
+ * @tparam G geometry type of the features
+ * @param schema layer defining the fields and spatial reference of the output
+ * @param shapefile output file
+ * @return util::Either<FeatureWriter<G>,std::string> writer, or error message if the file could not be created
+ */
+template<geometry::GeometryObject G>
+util::Either<FeatureWriter<G>,std::string> tryOpenWriter(const VectorLayer<G> & schema, const Shapefile & shapefile) {
+    return FeatureWriter<G>::create(shapefile,schema);
+}
+
+template<geometry::GeometryObject G>
+FeatureWriter<G> openWriter(const VectorLayer<G> & schema, const Shapefile & shapefile) {
+    return tryOpenWriter(schema,shapefile).value_or_throw();
+}
+
 template<geometry::GeometryObject G,VectorGISFile F>
 util::Either<F,std::string> tryOverwrite(const VectorLayerWriter<G,F> auto & writer, const VectorLayer<G> & layer, const F & destination){
     return writer(layer, destination);
@@ -131,4 +201,53 @@ Shapefile overwrite(const VectorLayer<G> & layer, const Shapefile & destination)
     return overwrite(ShapefileWriter<G>(), layer, destination);
 }
 
+template<geometry::GeometryObject G>
+GeometryCache write(const VectorLayer<G> & layer, const GeometryCache & destination) {
+    return write(GeometryCacheWriter<G>(), layer, destination);
+}
+
+template<geometry::GeometryObject G>
+GeometryCache overwrite(const VectorLayer<G> & layer, const GeometryCache & destination) {
+    return overwrite(GeometryCacheWriter<G>(), layer, destination);
+}
+
+/**
+ * @brief Writes a VectorLayer to a vector file without overwriting existing files, choosing the writer by the file extension (.shp or .fgc)
+ * 
+ * @tparam G geometry type of the layer
+ * @param layer layer to be written
+ * @param destination path of the vector file
+ * @return std::filesystem::path path of the written file, which may differ from the destination if it already existed
+ * @throws runtime_error if the file could not be written or its type is not supported
+ */
+template<geometry::GeometryObject G>
+std::filesystem::path write(const VectorLayer<G> & layer, const std::filesystem::path & destination) {
+    auto fileType = getGISFileType(destination);
+    if(not fileType)
+        throw std::runtime_error("Unsupported vector file type: \"" + destination.string() + "\"");
+    switch(fileType.value()) {
+        case GISFileType::SHAPEFILE:
+            return write(layer,Shapefile(destination)).getPath();
+        case GISFileType::GEOMETRY_CACHE:
+            return write(layer,GeometryCache(destination)).getPath();
+        default:
+            throw std::runtime_error("Unsupported vector file type: \"" + destination.string() + "\"");
+    }
+}
+
+template<geometry::GeometryObject G>
+std::filesystem::path overwrite(const VectorLayer<G> & layer, const std::filesystem::path & destination) {
+    auto fileType = getGISFileType(destination);
+    if(not fileType)
+        throw std::runtime_error("Unsupported vector file type: \"" + destination.string() + "\"");
+    switch(fileType.value()) {
+        case GISFileType::SHAPEFILE:
+            return overwrite(layer,Shapefile(destination)).getPath();
+        case GISFileType::GEOMETRY_CACHE:
+            return overwrite(layer,GeometryCache(destination)).getPath();
+        default:
+            throw std::runtime_error("Unsupported vector file type: \"" + destination.string() + "\"");
+    }
+}
+
 } // namespace fishnet::VectorIO
\ No newline at end of file
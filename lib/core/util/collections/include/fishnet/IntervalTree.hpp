@@ -0,0 +1,153 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <concepts>
+#include <ranges>
+
+namespace fishnet::util{
+
+/**
+ * @brief Interval tree over a fixed set of closed intervals [low,high], which can be activated and deactivated.
+ * Intended as status structure of sweep lines, where all intervals are known upfront but only the active ones are queried.
+ * The intervals are stored sorted by their lower bound as an implicit balanced binary search tree (the middle of each index range is the root of the subtree),
+ * each node is augmented with the maximum upper bound of the active intervals in its subtree.
+ * Activating and deactivating costs O(log n), finding the k active intervals overlapping a query interval costs O(k log n).
+ * Intervals are identified by their index in the constructor range.
+ * @tparam T bound type
+ */
+template<typename T>
+requires std::totally_ordered<T>
+class IntervalTree {
+private:
+    constexpr static T NONE = std::numeric_limits<T>::lowest();
+
+    std::vector<T> lows; // sorted
+    std::vector<T> highs;
+    std::vector<size_t> ids; // position -> interval index
+    std::vector<size_t> positions; // interval index -> position
+    std::vector<bool> active; // per position
+    std::vector<T> maxHigh; // per position: maximum upper bound of the active intervals in the subtree, NONE if no interval is active
+    size_t activeCount = 0;
+
+    T subtreeMax(size_t first, size_t last) const noexcept {
+        return first < last ? maxHigh[first + (last-first)/2] : NONE;
+    }
+
+    void update(size_t first, size_t last, size_t position) noexcept {
+        size_t middle = first + (last-first)/2;
+        if(position < middle)
+            update(first,middle,position);
+        else if(position > middle)
+            update(middle+1,last,position);
+        maxHigh[middle] = std::max({active[middle] ? highs[middle] : NONE, subtreeMax(first,middle), subtreeMax(middle+1,last)});
+    }
+
+    template<typename F>
+    bool visit(size_t first, size_t last, const T & low, const T & high, F & f) const {
+        if(first >= last)
+            return true;
+        size_t middle = first + (last-first)/2;
+        if(maxHigh[middle] == NONE || maxHigh[middle] < low)
+            return true; // no active interval of the subtree reaches the query interval
+        if(not visit(first,middle,low,high,f))
+            return false;
+        if(high < lows[middle])
+            return true; // all intervals of the right subtree start behind the query interval
+        if(active[middle] && low <= highs[middle] && not f(ids[middle]))
+            return false;
+        return visit(middle+1,last,low,high,f);
+    }
+
+    void setActive(size_t index, bool value) {
+        if(index >= positions.size())
+            throw std::out_of_range("Interval index out of range");
+        size_t position = positions[index];
+        if(active[position] == value)
+            return;
+        active[position] = value;
+        value ? activeCount++ : activeCount--;
+        update(0,lows.size(),position);
+    }
+
+public:
+    /**
+     * @brief Construct a new Interval Tree, with all intervals inactive
+     *
+     * @param intervals range of pairs (low,high), with low <= high
+     */
+    template<std::ranges::input_range R>
+    IntervalTree(R && intervals) {
+        std::vector<std::pair<T,T>> bounds;
+        for(const auto & [low,high]: intervals) {
+            bounds.emplace_back(low,high);
+        }
+        std::vector<size_t> order(bounds.size());
+        std::iota(order.begin(),order.end(),0);
+        std::ranges::stable_sort(order,{},[&bounds](size_t index){return bounds[index].first;});
+        lows.reserve(bounds.size());
+        highs.reserve(bounds.size());
+        positions.resize(bounds.size());
+        for(size_t position = 0; position < order.size(); ++position) {
+            lows.push_back(bounds[order[position]].first);
+            highs.push_back(bounds[order[position]].second);
+            positions[order[position]] = position;
+        }
+        ids = std::move(order);
+        active.assign(bounds.size(),false);
+        maxHigh.assign(bounds.size(),NONE);
+    }
+
+    void activate(size_t index) {
+        setActive(index,true);
+    }
+
+    void deactivate(size_t index) {
+        setActive(index,false);
+    }
+
+    bool isActive(size_t index) const {
+        return active[positions.at(index)];
+    }
+
+    /**
+     * @brief Number of intervals in the tree, active or not
+     */
+    size_t size() const noexcept {
+        return lows.size();
+    }
+
+    size_t activeSize() const noexcept {
+        return activeCount;
+    }
+
+    /**
+     * @brief Calls f(index) for each active interval overlapping the closed query interval [low,high], in ascending order of the lower bounds.
+     * Stops as soon as f returns false
+     *
+     * @param low lower bound of the query interval
+     * @param high upper bound of the query interval
+     * @param f callable taking the index of the interval, returning whether to continue
+     * @return true if all overlapping intervals were visited, false if f stopped the query
+     */
+    template<typename F>
+    requires std::predicate<F&,size_t>
+    bool forEachActiveOverlapping(const T & low, const T & high, F && f) const {
+        return visit(0,lows.size(),low,high,f);
+    }
+
+    /**
+     * @brief Get the indices of all active intervals overlapping the closed query interval [low,high]
+     */
+    std::vector<size_t> activeOverlapping(const T & low, const T & high) const {
+        std::vector<size_t> result;
+        forEachActiveOverlapping(low,high,[&result](size_t index){
+            result.push_back(index);
+            return true;
+        });
+        return result;
+    }
+};
+}
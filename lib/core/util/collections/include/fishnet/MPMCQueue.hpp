@@ -0,0 +1,236 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <new>
+#include <thread>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <iterator>
+#include <ranges>
+#include <bit>
+#include <algorithm>
+
+namespace fishnet::util{
+
+namespace __impl {
+/**
+ * @brief Wait strategy for the blocking operations of the MPMCQueue.
+ * Spins with exponentially growing pauses first, then yields and finally sleeps
+ */
+class Backoff {
+private:
+    constexpr static size_t SPIN_LIMIT = 6;
+    constexpr static size_t YIELD_LIMIT = 16;
+    size_t step = 0;
+public:
+    void operator()() noexcept {
+        if(step <= SPIN_LIMIT) {
+            for(size_t i = 0; i < (size_t(1) << step); ++i) {
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+            }
+        }else if(step <= YIELD_LIMIT) {
+            std::this_thread::yield();
+        }else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            return;
+        }
+        ++step;
+    }
+
+    void reset() noexcept {
+        step = 0;
+    }
+};
+}
+
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer queue on a ring buffer (Vyukov).
+ * Each slot stores a sequence number, which tells producers and consumers whether the slot is free or filled for their turn.
+ * Elements are moved into and out of the queue, therefore move-only types are supported.
+ * Instead of poison pills, the producers close() the queue: take() returns std::nullopt once the queue is closed and empty.
+ * @tparam T value type
+ */
+template<typename T>
+class MPMCQueue {
+private:
+    constexpr static size_t CACHE_LINE_SIZE = 64;
+
+    struct Slot {
+        std::atomic_size_t sequence;
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T * get() noexcept {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    size_t mask;
+    std::unique_ptr<Slot[]> slots;
+    alignas(CACHE_LINE_SIZE) std::atomic_size_t enqueuePosition = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic_size_t dequeuePosition = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic_bool closed = false;
+
+    template<typename U>
+    bool tryEmplace(U && value) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        while(true) {
+            Slot & slot = slots[position & mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if(difference == 0) {
+                if(enqueuePosition.compare_exchange_weak(position,position+1,std::memory_order_relaxed)){
+                    new (slot.storage) T(std::forward<U>(value));
+                    slot.sequence.store(position+1,std::memory_order_release);
+                    return true;
+                }
+            }else if(difference < 0) {
+                return false; // full
+            }else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new queue
+     *
+     * @param capacity maximum number of elements, rounded up to the next power of two
+     */
+    MPMCQueue(size_t capacity = 1024):mask(std::bit_ceil(std::max<size_t>(capacity,2))-1),slots(std::make_unique<Slot[]>(mask+1)){
+        for(size_t i = 0; i <= mask; ++i) {
+            slots[i].sequence.store(i,std::memory_order_relaxed);
+        }
+    }
+
+    MPMCQueue(const MPMCQueue &) = delete;
+    MPMCQueue & operator=(const MPMCQueue &) = delete;
+
+    ~MPMCQueue() {
+        while(tryTake()) {}
+    }
+
+    size_t capacity() const noexcept {
+        return mask+1;
+    }
+
+    /**
+     * @brief Approximate number of elements, exact if no other thread accesses the queue
+     */
+    size_t size() const noexcept {
+        auto enqueued = enqueuePosition.load(std::memory_order_acquire);
+        auto dequeued = dequeuePosition.load(std::memory_order_acquire);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    bool tryPut(T && value) {
+        return tryEmplace(std::move(value));
+    }
+
+    bool tryPut(const T & value) requires std::copy_constructible<T> {
+        return tryEmplace(value);
+    }
+
+    /**
+     * @brief Adds an element, waiting with backoff while the queue is full
+     * @throws std::runtime_error if the queue is closed
+     */
+    void put(T value) {
+        if(closed.load(std::memory_order_acquire))
+            throw std::runtime_error("Put on closed queue");
+        __impl::Backoff backoff;
+        while(not tryEmplace(std::move(value))) {
+            backoff();
+        }
+    }
+
+    /**
+     * @brief Adds all elements of the range (moved if the range is an rvalue), waiting with backoff while the queue is full
+     */
+    template<std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_value_t<R>,T>
+    void putBatch(R && range) {
+        for(auto && value: range) {
+            if constexpr(std::is_lvalue_reference_v<R>)
+                put(T(value));
+            else
+                put(T(std::move(value)));
+        }
+    }
+
+    std::optional<T> tryTake() {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        while(true) {
+            Slot & slot = slots[position & mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position+1);
+            if(difference == 0) {
+                if(dequeuePosition.compare_exchange_weak(position,position+1,std::memory_order_relaxed)){
+                    std::optional<T> result {std::move(*slot.get())};
+                    slot.get()->~T();
+                    slot.sequence.store(position+mask+1,std::memory_order_release);
+                    return result;
+                }
+            }else if(difference < 0) {
+                return std::nullopt; // empty
+            }else {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes an element, waiting with backoff while the queue is empty
+     * @return std::optional<T> element, or std::nullopt if the queue is closed and empty
+     */
+    std::optional<T> take() {
+        __impl::Backoff backoff;
+        while(true) {
+            bool wasClosed = closed.load(std::memory_order_acquire);
+            if(auto value = tryTake())
+                return value;
+            if(wasClosed)
+                return std::nullopt;
+            backoff();
+        }
+    }
+
+    /**
+     * @brief Removes up to maxCount elements, waiting with backoff until at least one element is present
+     *
+     * @param output output iterator receiving the elements
+     * @param maxCount maximum number of elements taken
+     * @return size_t number of elements taken, 0 if the queue is closed and empty
+     */
+    template<std::output_iterator<T> O>
+    size_t takeBatch(O output, size_t maxCount) {
+        if(maxCount == 0)
+            return 0;
+        auto first = take();
+        if(not first)
+            return 0;
+        *output++ = std::move(first.value());
+        size_t count = 1;
+        while(count < maxCount) {
+            auto value = tryTake();
+            if(not value)
+                break;
+            *output++ = std::move(value.value());
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Signals that no more elements are added. Pending elements can still be taken
+     */
+    void close() noexcept {
+        closed.store(true,std::memory_order_release);
+    }
+
+    bool isClosed() const noexcept {
+        return closed.load(std::memory_order_acquire);
+    }
+};
+}
@@ -0,0 +1,296 @@
+#pragma once
+#include <thread>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <exception>
+#include <condition_variable>
+#include <functional>
+#include <fishnet/FunctionalConcepts.hpp>
+
+namespace fishnet::util{
+
+namespace __impl {
+/**
+ * @brief Task queue of a single worker.
+ * The owning worker pushes and pops at the back (LIFO), other threads steal from the front (FIFO)
+ */
+class WorkerQueue {
+private:
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+public:
+    void push(std::function<void()> && task) {
+        std::lock_guard lock {mutex};
+        tasks.push_back(std::move(task));
+    }
+
+    bool pop(std::function<void()> & task) {
+        std::lock_guard lock {mutex};
+        if(tasks.empty())
+            return false;
+        task = std::move(tasks.back());
+        tasks.pop_back();
+        return true;
+    }
+
+    bool steal(std::function<void()> & task) {
+        std::unique_lock lock {mutex,std::try_to_lock};
+        if(not lock || tasks.empty())
+            return false;
+        task = std::move(tasks.front());
+        tasks.pop_front();
+        return true;
+    }
+};
+}
+
+/**
+ * @brief Thread pool with a task queue per worker.
+ * Tasks submitted from a worker are pushed to its own queue, tasks submitted from other threads are distributed round robin.
+ * Idle workers steal tasks from the queues of the other workers, therefore submitting many small tasks does not contend on a single lock.
+ * Threads waiting on a TaskGroup or parallelFor(...) execute pending tasks while waiting.
+ */
+class WorkStealingThreadPool {
+private:
+    struct WorkerContext {
+        WorkStealingThreadPool * pool = nullptr;
+        size_t index = 0;
+    };
+
+    std::vector<std::unique_ptr<__impl::WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic_size_t pending = 0; // number of tasks in the queues
+    std::atomic_size_t sleeping = 0;
+    std::atomic_size_t nextQueue = 0;
+    std::atomic_bool stop = false;
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+
+    static WorkerContext & context() noexcept {
+        thread_local WorkerContext workerContext;
+        return workerContext;
+    }
+
+    std::optional<size_t> workerIndex() const noexcept {
+        const auto & ctx = context();
+        if(ctx.pool == this)
+            return ctx.index;
+        return std::nullopt;
+    }
+
+    bool tryTake(std::function<void()> & task) {
+        auto index = workerIndex();
+        if(index && queues[index.value()]->pop(task)){
+            pending--;
+            return true;
+        }
+        size_t start = index.value_or(nextQueue.load(std::memory_order_relaxed));
+        for(size_t i = 1; i <= queues.size(); ++i) {
+            if(queues[(start + i) % queues.size()]->steal(task)){
+                pending--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(size_t index) {
+        context() = WorkerContext{this,index};
+        std::function<void()> task;
+        while(true) {
+            if(tryTake(task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+            if(pending > 0) {
+                std::this_thread::yield(); // task is queued, but its queue was locked
+                continue;
+            }
+            std::unique_lock lock {sleepMutex};
+            sleeping++;
+            sleepCondition.wait(lock,[this]{return stop || pending > 0;});
+            sleeping--;
+            if(stop && pending == 0)
+                return;
+        }
+    }
+
+    void push(std::function<void()> && task) {
+        auto index = workerIndex();
+        size_t queue = index ? index.value() : nextQueue.fetch_add(1,std::memory_order_relaxed) % queues.size();
+        pending++; // counted before it is visible to thieves, which decrement it
+        queues[queue]->push(std::move(task));
+        if(sleeping > 0) {
+            std::lock_guard lock {sleepMutex}; // a worker may be about to wait, the lock prevents missing the notification
+        }
+        sleepCondition.notify_one();
+    }
+
+public:
+    /**
+     * @brief Group of tasks, which can be waited for collectively.
+     * The first exception thrown by a task of the group is rethrown by wait()
+     */
+    class TaskGroup {
+    private:
+        WorkStealingThreadPool & pool;
+        std::atomic_size_t outstanding = 0;
+        std::mutex mutex; // guards the exception and the last decrement of outstanding, so the group outlives the notification
+        std::condition_variable finished;
+        std::exception_ptr exception;
+
+        void finish(std::exception_ptr error) {
+            std::lock_guard lock {mutex};
+            if(error && not exception)
+                exception = std::move(error);
+            if(--outstanding == 0)
+                finished.notify_all();
+        }
+
+        void awaitFinished() {
+            std::unique_lock lock {mutex};
+            finished.wait(lock,[this]{return outstanding == 0;});
+        }
+    public:
+        TaskGroup(WorkStealingThreadPool & pool):pool(pool){}
+
+        TaskGroup(const TaskGroup &) = delete;
+        TaskGroup & operator=(const TaskGroup &) = delete;
+
+        ~TaskGroup() {
+            awaitFinished(); // tasks reference this group, do not rethrow in the destructor
+        }
+
+        template<fishnet::util::Task F>
+        void run(F && f) {
+            outstanding++;
+            pool.push([this,f=std::forward<F>(f)]()mutable{
+                std::exception_ptr error;
+                try{
+                    f();
+                }catch(...){
+                    error = std::current_exception();
+                }
+                finish(std::move(error));
+            });
+        }
+
+        /**
+         * @brief Blocks until all tasks of the group are finished, executing pending tasks of the pool in the meantime
+         * @throws the first exception thrown by a task of the group
+         */
+        void wait() {
+            std::function<void()> task;
+            while(outstanding > 0) {
+                if(pool.tryTake(task)) {
+                    task();
+                    task = nullptr;
+                }else if(pool.pending > 0) {
+                    std::this_thread::yield();
+                }else {
+                    awaitFinished();
+                }
+            }
+            std::lock_guard lock {mutex}; // the last task notifies under the lock
+            if(exception)
+                std::rethrow_exception(std::exchange(exception,nullptr));
+        }
+    };
+
+    WorkStealingThreadPool(size_t numThreads = std::thread::hardware_concurrency()) {
+        if(numThreads == 0)
+            numThreads = 1;
+        queues.reserve(numThreads);
+        for(size_t i = 0; i < numThreads; ++i) {
+            queues.push_back(std::make_unique<__impl::WorkerQueue>());
+        }
+        threads.reserve(numThreads);
+        for(size_t i = 0; i < numThreads; ++i) {
+            threads.emplace_back([this,i]{work(i);});
+        }
+    }
+
+    WorkStealingThreadPool(const WorkStealingThreadPool &) = delete;
+    WorkStealingThreadPool & operator=(const WorkStealingThreadPool &) = delete;
+
+    size_t size() const noexcept {
+        return threads.size();
+    }
+
+    /**
+     * @brief Pool of the calling thread, allows nested parallel work to share the pool instead of starting more threads
+     * @return WorkStealingThreadPool* pool, if the calling thread is one of its workers, nullptr otherwise
+     */
+    static WorkStealingThreadPool * current() noexcept {
+        return context().pool;
+    }
+
+    template<fishnet::util::Task F>
+    void submit(F && f) {
+        push(std::forward<F>(f));
+    }
+
+    /**
+     * @brief Submits a callable and returns a future to its result
+     */
+    template<std::invocable F>
+    auto async(F && f) -> std::future<std::invoke_result_t<F>> {
+        using Result_t = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<Result_t()>>(std::forward<F>(f)); // std::function requires copyable callables
+        auto future = task->get_future();
+        push([task]{(*task)();});
+        return future;
+    }
+
+    /**
+     * @brief Calls f(i) for each i in [first,last) on the pool and blocks until all calls are finished.
+     * The range is split into chunks of chunkSize indices, by default about 4 chunks per worker
+     * @throws the first exception thrown by f
+     */
+    template<typename F>
+    requires std::invocable<F&,size_t>
+    void parallelFor(size_t first, size_t last, F && f, size_t chunkSize = 0) {
+        if(first >= last)
+            return;
+        size_t count = last - first;
+        if(chunkSize == 0)
+            chunkSize = std::max<size_t>(1,count / (4*size()));
+        TaskGroup group {*this};
+        for(size_t begin = first; begin < last; begin+=std::min(chunkSize,last-begin)) {
+            size_t end = begin + std::min(chunkSize,last-begin);
+            group.run([&f,begin,end]{
+                for(size_t i = begin; i < end; ++i) {
+                    f(i);
+                }
+            });
+        }
+        group.wait();
+    }
+
+    /**
+     * @brief Waits until all submitted tasks are finished and stops the workers
+     */
+    void join() {
+        if(stop.exchange(true))
+            return;
+        {
+            std::lock_guard lock {sleepMutex};
+        }
+        sleepCondition.notify_all();
+        for(std::thread & thread : threads)
+            thread.join();
+    }
+
+    ~WorkStealingThreadPool() {
+        join();
+    }
+};
+}
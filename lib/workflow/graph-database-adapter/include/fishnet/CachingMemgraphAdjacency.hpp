@@ -121,6 +121,14 @@ public:
         return cache.hasAdjacency(from.key(),to.key());
     }
 
+    std::vector<bool> hasAdjacencies(fishnet::util::forward_range_of<std::pair<N,N>> auto && edges) const noexcept {
+        std::vector<bool> result;
+        for(const auto & [from,to]: edges) {
+            result.push_back(cache.hasAdjacency(from.key(),to.key()));
+        }
+        return result;
+    }
+
     fishnet::util::view_of<const N> auto adjacency(const N & node) const noexcept {
         return cache.adjacency(node.key()) | std::views::transform([this](auto nodeId){
             return this->keyToNodeMap.at(nodeId);
@@ -0,0 +1,236 @@
+#pragma once
+#include <mutex>
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <optional>
+#include <concepts>
+#include <stdexcept>
+#include <fishnet/Either.hpp>
+#include "MemgraphConnection.hpp"
+
+/**
+ * @brief Thread-safe pool of at most maxSize database connections.
+ * Connections are created lazily by the factory. lease() hands out a connection exclusively to the caller,
+ * blocking while all connections are in use, and the connection is returned to the pool when the lease is destroyed.
+ * Idle connections are health checked when borrowed and replaced by a new connection if the check fails.
+ * All leases share the state of the pool, hence a lease may outlive the pool it was borrowed from.
+ * @tparam C connection type
+ */
+template<CipherConnection C>
+class ConnectionPool {
+public:
+    using Factory = std::function<fishnet::util::Either<C,std::string>()>;
+    using HealthCheck = std::function<bool(const C &)>;
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable available;
+        std::vector<std::unique_ptr<C>> idle;
+        size_t open = 0;
+        size_t maxSize;
+        Factory factory;
+        HealthCheck healthCheck;
+        std::mutex setupMutex;
+        bool setupDone = false;
+
+        State(Factory && factory, size_t maxSize, HealthCheck && healthCheck)
+        :maxSize(maxSize),factory(std::move(factory)),healthCheck(std::move(healthCheck)){}
+
+        /**
+         * @brief Returns a connection to the idle connections, or closes its slot if the connection is null
+         *
+         * @param connection
+         */
+        void giveBack(std::unique_ptr<C> && connection) noexcept {
+            {
+                std::lock_guard lock {mutex};
+                if(connection)
+                    idle.push_back(std::move(connection));
+                else
+                    --open;
+            }
+            available.notify_one();
+        }
+    };
+    std::shared_ptr<State> state;
+
+public:
+    /**
+     * @brief Exclusive access to a connection, which is returned to its pool on destruction.
+     * Leases constructed from a connection are not pooled and own the connection.
+     */
+    class Lease {
+        friend ConnectionPool;
+    private:
+        std::unique_ptr<C> connection;
+        std::shared_ptr<State> pool;
+
+        Lease(std::unique_ptr<C> && connection, std::shared_ptr<State> pool):connection(std::move(connection)),pool(std::move(pool)){}
+
+        void release() noexcept {
+            if(pool)
+                pool->giveBack(std::move(connection));
+            pool = nullptr;
+            connection = nullptr;
+        }
+    public:
+        explicit Lease(C && connection):connection(std::make_unique<C>(std::move(connection))),pool(nullptr){}
+
+        Lease(Lease && other) noexcept = default;
+
+        /**
+         * @brief Leases are move-only, since a copy would have to borrow another connection from the pool,
+         * which blocks (or deadlocks) while all connections are in use
+         */
+        Lease(const Lease & other) = delete;
+
+        Lease & operator=(Lease && other) noexcept {
+            if(this != &other) {
+                release();
+                connection = std::move(other.connection);
+                pool = std::move(other.pool);
+            }
+            return *this;
+        }
+
+        Lease & operator=(const Lease & other) = delete;
+
+        C & operator*() const noexcept {
+            return *connection;
+        }
+
+        C * operator->() const noexcept {
+            return connection.get();
+        }
+
+        bool isPooled() const noexcept {
+            return pool != nullptr;
+        }
+
+        /**
+         * @brief Runs the setup (e.g. creating constraints and indexes) on the leased connection only once per pool.
+         * Unpooled leases always run the setup. If the setup fails, the next lease of the pool retries it.
+         * @param setup unary predicate on the connection, returning true on success
+         * @return true if the setup succeeded on this or any previous lease of the pool
+         */
+        bool setupOnce(std::predicate<const C &> auto && setup) const {
+            if(not pool)
+                return setup(*connection);
+            std::lock_guard lock {pool->setupMutex};
+            if(not pool->setupDone)
+                pool->setupDone = setup(*connection);
+            return pool->setupDone;
+        }
+
+        /**
+         * @brief Closes a broken connection instead of returning it to the pool, freeing its slot for a new connection.
+         * The lease is empty afterwards.
+         */
+        void invalidate() noexcept {
+            connection = nullptr;
+            release();
+        }
+
+        ~Lease(){
+            release();
+        }
+    };
+
+private:
+    static std::optional<Lease> acquire(const std::shared_ptr<State> & state, std::optional<std::chrono::steady_clock::time_point> deadline) {
+        std::unique_lock lock {state->mutex};
+        while(true) {
+            if(not state->idle.empty()) {
+                auto connection = std::move(state->idle.back());
+                state->idle.pop_back();
+                lock.unlock();
+                if(state->healthCheck(*connection))
+                    return Lease(std::move(connection),state);
+                connection = nullptr;
+                lock.lock();
+                --state->open;
+                continue;
+            }
+            if(state->open < state->maxSize) {
+                ++state->open;
+                lock.unlock();
+                auto created = state->factory();
+                if(created)
+                    return Lease(std::make_unique<C>(std::move(created.value())),state);
+                state->giveBack(nullptr);
+                throw std::runtime_error(created.error());
+            }
+            if(not deadline)
+                state->available.wait(lock);
+            else if(state->available.wait_until(lock,deadline.value()) == std::cv_status::timeout)
+                return std::nullopt;
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new Connection Pool
+     *
+     * @param factory creates a new connection, or returns an error message
+     * @param maxSize maximum number of open connections (at least 1)
+     * @param healthCheck tests an idle connection before it is leased
+     */
+    ConnectionPool(Factory factory, size_t maxSize, HealthCheck healthCheck = [](const C &){return true;})
+    :state(std::make_shared<State>(std::move(factory),std::max<size_t>(maxSize,1),std::move(healthCheck))){}
+
+    /**
+     * @brief Lease a connection, waiting until one is available
+     * @throws runtime_error if a new connection can not be created
+     * @return Lease
+     */
+    Lease lease() const {
+        return acquire(state,std::nullopt).value();
+    }
+
+    /**
+     * @brief Lease a connection, waiting at most for the timeout
+     * @throws runtime_error if a new connection can not be created
+     * @param timeout
+     * @return std::optional<Lease> empty if no connection became available in time
+     */
+    std::optional<Lease> tryLease(std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) const {
+        return acquire(state,std::chrono::steady_clock::now()+timeout);
+    }
+
+    /**
+     * @brief Get the number of open connections, either idle or leased
+     *
+     * @return size_t
+     */
+    size_t size() const noexcept {
+        std::lock_guard lock {state->mutex};
+        return state->open;
+    }
+
+    size_t idleCount() const noexcept {
+        std::lock_guard lock {state->mutex};
+        return state->idle.size();
+    }
+
+    size_t capacity() const noexcept {
+        return state->maxSize;
+    }
+};
+
+/**
+ * @brief Pool of memgraph connections sharing the connection parameters.
+ * Borrowed connections are checked with a trivial query, which reconnects broken connections (see MemgraphConnection::execute()).
+ */
+class MemgraphConnectionPool: public ConnectionPool<MemgraphConnection> {
+public:
+    MemgraphConnectionPool(const mg::Client::Params & params, size_t maxSize)
+    :ConnectionPool<MemgraphConnection>([params](){return MemgraphConnection::create(params);},maxSize,isHealthy){}
+
+    static bool isHealthy(const MemgraphConnection & connection) {
+        return connection.isConnected() && connection.executeAndDiscard(CipherQuery("RETURN 1"));
+    }
+};
@@ -159,6 +159,18 @@ public:
         return client.containsEdge(from.key(),to.key());
     }
 
+    /**
+     * @brief Tests multiple adjacencies in batched queries, instead of one database round trip per adjacency
+     * 
+     * @param edges range of pairs (from,to)
+     * @return std::vector<bool> true at the index of each existing adjacency
+     */
+    std::vector<bool> hasAdjacencies(fishnet::util::forward_range_of<std::pair<N,N>> auto && edges) const noexcept {
+        return client.containsEdges(std::views::all(edges) | std::views::transform([](const auto & pair){
+            return std::make_pair(pair.first.key(),pair.second.key());
+        }));
+    }
+
     fishnet::util::view_of<const N> auto adjacency(const N & node) const noexcept {
         std::vector<size_t> adjacentIds = client.adjacency(createNodeReference(node));
         return std::views::all(keyToNodeMap) 
@@ -1,9 +1,11 @@
 #pragma once
 #include "MemgraphConnection.hpp"
+#include "ConnectionPool.hpp"
 #include "CipherQuery.hpp"
 #include "MemgraphModel.hpp"
 #include <unordered_map>
 #include <memory>
+#include <algorithm>
 #include <expected>
 #include <sstream>
 #include <mgclient.hpp>
@@ -41,40 +43,53 @@ struct ComponentReference{
 
 class MemgraphClient{
 private:
-    MemgraphConnection mgConnection;
+    MemgraphConnectionPool::Lease lease;
+
+    const MemgraphConnection & mgConnection() const noexcept {
+        return *lease;
+    }
 public:
-    explicit MemgraphClient(MemgraphConnection && clientPtr):mgConnection(std::move(clientPtr)){
-        if(not createConstraints() || not createIndexes()) {
+    constexpr static size_t EDGE_BATCH_SIZE = 10000;
+
+    explicit MemgraphClient(MemgraphConnection && clientPtr):MemgraphClient(MemgraphConnectionPool::Lease(std::move(clientPtr))){}
+
+    /**
+     * @brief Construct a new Memgraph Client on a connection leased from a pool.
+     * The connection is returned to the pool when the client is destroyed, hence the client is move-only.
+     * Constraints and indexes are created once per pool, instead of once per client.
+     * @param lease 
+     */
+    explicit MemgraphClient(MemgraphConnectionPool::Lease && lease):lease(std::move(lease)){
+        if(not this->lease.setupOnce([this](const MemgraphConnection &){return createConstraints() && createIndexes();})) {
             throw std::runtime_error("Could not create constraints. Check the database connection");
         }
     }
 
-
     const std::unique_ptr<mg::Client> & getConnection() const noexcept  {
-        return this->mgConnection.get();
+        return mgConnection().get();
     }
 
     const MemgraphConnection & getMemgraphConnection() const noexcept {
-        return this->mgConnection;
+        return mgConnection();
     }
 
 
     bool createConstraints()const noexcept {
-        return mgConnection.executeAndDiscard(
+        return mgConnection().executeAndDiscard(
             CipherQuery("CREATE CONSTRAINT ON ").append(Node{.name="n",.label=Label::Settlement}).append(" ASSERT n.id IS UNIQUE"),
             CipherQuery("CREATE CONSTRAINT ON ").append(Node{.name="f",.label=Label::File}).append(" ASSERT f.id IS UNIQUE"),
             CipherQuery("CREATE CONSTRAINT ON ").append(Node{.name="f",.label=Label::File}).append(" ASSERT exists(f.path)"));
     }
 
     bool dropConstraints() const noexcept {
-        return mgConnection.executeAndDiscard(
+        return mgConnection().executeAndDiscard(
             CipherQuery("DROP CONSTRAINT ON ").append(Node{.name="n",.label=Label::Settlement}).append(" ASSERT n.id IS UNIQUE"),
             CipherQuery("DROP CONSTRAINT ON ").append(Node{.name="f",.label=Label::File}).append(" ASSERT f.id IS UNIQUE"),
             CipherQuery("DROP CONSTRAINT ON ").append(Node{.name="f",.label=Label::File}).append(" ASSERT exists(f.path)"));
     }
 
     bool createIndexes() const noexcept {
-        return mgConnection.executeAndDiscard(
+        return mgConnection().executeAndDiscard(
             CipherQuery::CREATE_INDEX(Index(Label::Settlement,"id")),
             CipherQuery::CREATE_INDEX(Index{.label=Label::File}),
             CipherQuery::CREATE_INDEX(Index{.label=Label::Component}),
@@ -84,7 +99,7 @@ public:
     }
 
     bool dropIndexes() const noexcept {
-        return mgConnection.executeAndDiscard(
+        return mgConnection().executeAndDiscard(
             CipherQuery::DROP_INDEX(Index(Label::Settlement,"id")),
             CipherQuery::DROP_INDEX(Index{.label=Label::File}),
             CipherQuery::DROP_INDEX(Index{.label=Label::Component}),
@@ -107,10 +122,10 @@ public:
         CipherQuery query;
         query.merge(Node("f",Label::File,"path:$path")).set("path",mg::Value(path.string())).ret("ID(f)");
 
-        if(not mgConnection.execute(query)) {
+        if(not mgConnection().execute(query)) {
             return std::nullopt;
         }
-        auto queryResult = mgConnection->FetchAll();
+        auto queryResult = mgConnection()->FetchAll();
         if(queryResult && queryResult->front().front().type() == mg::Value::Type::Int) {
             return FileReference(queryResult->front().front().ValueInt());
         }
@@ -118,7 +133,7 @@ public:
     }
 
     bool insertEdge(NodeReference const & from, NodeReference const & to) const noexcept {
-        return mgConnection.executeAndDiscard(
+        return mgConnection().executeAndDiscard(
             CipherQuery().match(Node{.name="ff",.label=Label::File}).where("ID(ff)=$fromFile")
             .setInt("fromFile",from.fileRef.fileId)
             .match(Node{.name="ft",.label=Label::File}).where("ID(ft)=$toFile")
@@ -156,11 +171,11 @@ public:
             data.push_back(mg::Value(std::move(currentEdge)));
         }
         query.set("data",mg::Value(mg::List(std::move(data))));
-        return mgConnection.executeAndDiscard(query);
+        return mgConnection().executeAndDiscard(query);
     }
 
     bool insertNode(NodeReference const & node) const noexcept{
-        return mgConnection.executeAndDiscard(
+        return mgConnection().executeAndDiscard(
             CipherQuery().match(Node{.name="f",.label=Label::File}).where("ID(f)=$fid")
             .setInt("fid",node.fileRef.fileId)
             .merge(Node("n",Label::Settlement,"id:$nid"))
@@ -181,11 +196,11 @@ public:
             data.push_back(mg::Value(std::move(currentNode)));
         }
         query.set("data",mg::Value(mg::List(std::move(data))));
-        return mgConnection.executeAndDiscard(query);
+        return mgConnection().executeAndDiscard(query);
     }
 
     bool removeNode(NodeReference const & node) const noexcept {
-        return mgConnection.executeAndDiscard(
+        return mgConnection().executeAndDiscard(
             CipherQuery().match(Node("n",Label::Settlement,"id:$id"))
             .setInt("id",node.nodeId)
             .del("n"));
@@ -201,11 +216,11 @@ public:
             data.push_back(mg::Value(std::move(currentNode)));
         }
         query.set("data",mg::Value(mg::List(std::move(data))));
-        return mgConnection.executeAndDiscard(query);
+        return mgConnection().executeAndDiscard(query);
     }
 
     bool removeEdge(NodeReference const & from, NodeReference const & to) const noexcept {
-        return mgConnection.executeAndDiscard(
+        return mgConnection().executeAndDiscard(
             CipherQuery::MATCH(Relation("a",Node("f",Label::Settlement,"id:$fromId"),Label::neighbours,Node("t",Label::Settlement,"id:$toId")))
             .setInt("fromId",from.nodeId)
             .setInt("toId",to.nodeId)
@@ -224,7 +239,7 @@ public:
             data.push_back(mg::Value(std::move(currentEdge)));
         }
         query.set("data",mg::Value(mg::List(std::move(data))));
-        return mgConnection.executeAndDiscard(query);
+        return mgConnection().executeAndDiscard(query);
     }
 
     std::optional<ComponentReference> createComponent(fishnet::util::forward_range_of<NodeIdType> auto && nodesOfComponent) const noexcept {
@@ -235,7 +250,7 @@ public:
         std::ranges::transform(nodesOfComponent,std::back_inserter(data),[](NodeIdType nodeId){
             return mg::Value(asInt(nodeId));
         });
-        if( mgConnection.execute(CipherQuery()
+        if( mgConnection().execute(CipherQuery()
             .create(Node{.name="c",.label=Label::Component}).endl()
             .append("WITH $data as nodes,c").endl()
             .append("UNWIND nodes as nodeId").endl()
@@ -244,7 +259,7 @@ public:
             .set("data",mg::Value(mg::List(std::move(data))))
             .ret("ID(c)"))
         ){
-            auto queryResult = mgConnection->FetchAll();
+            auto queryResult = mgConnection()->FetchAll();
             if(queryResult && queryResult->front().front().type() == mg::Value::Type::Int) {
                 return ComponentReference(queryResult->front().front().ValueInt());
             }
@@ -272,9 +287,9 @@ public:
             data.push_back(mg::Value(mg::List(std::move(current))));
         }
         query.set("data",mg::Value(mg::List(std::move(data))));
-        if(mgConnection.execute(query)) {
+        if(mgConnection().execute(query)) {
             std::vector<ComponentReference> result;
-            while(auto currentRow = mgConnection->FetchOne()) {
+            while(auto currentRow = mgConnection()->FetchOne()) {
                 if(currentRow->front().type() == mg::Value::Type::Int){
                     result.emplace_back(currentRow->front().ValueInt());
                 }
@@ -285,15 +300,15 @@ public:
     }
 
     bool containsNode(size_t nodeId) const noexcept {
-        if(mgConnection.execute(CipherQuery().match(Node{"n",Label::Settlement,"id:$id"}).setInt("id",nodeId).ret("ID(n)"))){
-                auto result =  mgConnection->FetchAll();
+        if(mgConnection().execute(CipherQuery().match(Node{"n",Label::Settlement,"id:$id"}).setInt("id",nodeId).ret("ID(n)"))){
+                auto result =  mgConnection()->FetchAll();
                 return result.has_value() && result->size() > 0;
         }
         return false;
     }
 
     bool containsEdge(size_t from, size_t to) const noexcept {
-        if(mgConnection.execute(
+        if(mgConnection().execute(
             CipherQuery().match(Relation{
                 .name="r",
                 .from=Node{.label=Label::Settlement,.attributes="id:$fid"},
@@ -301,14 +316,65 @@ public:
                 .to= Node{.label=Label::Settlement,.attributes="id:$tid"}
             }).setInt("fid",from).setInt("tid",to).ret("ID(r)"))
         ){
-            auto result = mgConnection->FetchAll();
+            auto result = mgConnection()->FetchAll();
             return result.has_value() && result->size() > 0;
         }
         return false;
     }
 
+    /**
+     * @brief Tests the existence of many edges with one query per batch instead of one query per edge.
+     * Each batch is sent as list parameter, unwound by the database and answered with the indices of the existing edges.
+     * @param connection database connection
+     * @param edges range of pairs (from,to) of node ids
+     * @param batchSize maximum number of edges per query
+     * @return std::vector<bool> bitmap, true at the index of each existing edge. Edges of failed queries are reported as missing.
+     */
+    static std::vector<bool> containsEdges(const CipherConnection auto & connection, fishnet::util::forward_range_of<std::pair<NodeIdType,NodeIdType>> auto && edges, size_t batchSize = EDGE_BATCH_SIZE) noexcept {
+        std::vector<bool> result;
+        std::vector<mg::Value> data;
+        auto queryBatch = [&connection,&result,&data](){
+            if(data.empty())
+                return;
+            CipherQuery query {"UNWIND $data AS edge "};
+            query.match(Relation{
+                .from=Node{.label=Label::Settlement,.attributes="id:edge.from"},
+                .label=Label::neighbours,
+                .to=Node{.label=Label::Settlement,.attributes="id:edge.to"}
+            }).ret("DISTINCT edge.index");
+            query.set("data",mg::Value(mg::List(std::move(data))));
+            data = std::vector<mg::Value>();
+            if(connection.execute(query)) {
+                while(auto currentRow = connection->FetchOne()) {
+                    if(currentRow->front().type() == mg::Value::Type::Int){
+                        size_t index = asNodeIdType(currentRow->front().ValueInt());
+                        if(index < result.size())
+                            result[index] = true;
+                    }
+                }
+            }
+        };
+        batchSize = std::max<size_t>(batchSize,1);
+        for(const auto & [from,to]: edges) {
+            mg::Map currentEdge {3};
+            currentEdge.Insert("index",mg::Value(asInt(result.size())));
+            currentEdge.Insert("from",mg::Value(asInt(from)));
+            currentEdge.Insert("to",mg::Value(asInt(to)));
+            data.push_back(mg::Value(std::move(currentEdge)));
+            result.push_back(false);
+            if(data.size() == batchSize)
+                queryBatch();
+        }
+        queryBatch();
+        return result;
+    }
+
+    std::vector<bool> containsEdges(fishnet::util::forward_range_of<std::pair<NodeIdType,NodeIdType>> auto && edges, size_t batchSize = EDGE_BATCH_SIZE) const noexcept {
+        return containsEdges(mgConnection(),std::forward<decltype(edges)>(edges),batchSize);
+    }
+
     std::vector<NodeIdType> adjacency(const NodeReference & node) const noexcept {
-        if(mgConnection.execute(
+        if(mgConnection().execute(
             CipherQuery().match(Relation{
                 .from=Node{.label=Label::Settlement,.attributes="id:$id"},
                 .label=Label::neighbours,
@@ -316,7 +382,7 @@ public:
             }).setInt("id",node.nodeId).ret("x.id"))
         ){
             std::vector<NodeIdType> output;
-            while(auto currentRow = mgConnection->FetchOne()){
+            while(auto currentRow = mgConnection()->FetchOne()){
                 if(currentRow->front().type() == mg::Value::Type::Int){
                     NodeIdType nodeId = asNodeIdType(currentRow->front().ValueInt());
                     output.push_back(nodeId);
@@ -328,7 +394,7 @@ public:
     }
 
     std::unordered_map<NodeIdType,std::vector<NodeIdType>> edges() const noexcept {
-        if(mgConnection.execute(
+        if(mgConnection().execute(
             CipherQuery().match(Relation{
                 .from=Node{.name="f",.label=Label::Settlement},
                 .label=Label::neighbours,
@@ -336,7 +402,7 @@ public:
             }).ret("f.id","t.id"))
         ){
             std::unordered_map<NodeIdType,std::vector<NodeIdType>> output;
-            while(auto currentRow = mgConnection->FetchOne()) {
+            while(auto currentRow = mgConnection()->FetchOne()) {
                 NodeIdType from = asNodeIdType(currentRow->at(0).ValueInt());
                 NodeIdType to = asNodeIdType(currentRow->at(1).ValueInt());
                 if(not output.contains(from))
@@ -349,9 +415,9 @@ public:
     }
 
     std::vector<NodeIdType> nodes() const noexcept {
-        if(mgConnection.execute(CipherQuery().match(Node{.name="n",.label=Label::Settlement}).ret("n.id"))){
+        if(mgConnection().execute(CipherQuery().match(Node{.name="n",.label=Label::Settlement}).ret("n.id"))){
             std::vector<NodeIdType> output;
-            while(auto currentRow = mgConnection->FetchOne()) {
+            while(auto currentRow = mgConnection()->FetchOne()) {
                 output.push_back(asNodeIdType(currentRow->at(0).ValueInt()));
             }
             return output;
@@ -364,7 +430,7 @@ public:
         std::ranges::transform(componentIds,std::back_inserter(data),[](ComponentReference componentRef){
             return mg::Value(componentRef.componentId);
         });
-        if(mgConnection.execute(CipherQuery("WITH $data as components").endl()
+        if(mgConnection().execute(CipherQuery("WITH $data as components").endl()
             .set("data",mg::Value(mg::List(std::move(data))))
             .append("UNWIND components as component_id").endl()
             .match(Node{.name="c",.label=Label::Component}).where("ID(c)=component_id")
@@ -372,7 +438,7 @@ public:
             .ret("n.id"))
         ){
             std::vector<NodeIdType> result;
-            while(auto currentRow = mgConnection->FetchOne()) {
+            while(auto currentRow = mgConnection()->FetchOne()) {
                 result.push_back(asNodeIdType(currentRow->at(0).ValueInt()));
             }
             return result;
@@ -383,7 +449,7 @@ public:
     bool clearAll() const noexcept{
         bool result = true;
         for(Label label: {Label::Settlement,Label::File,Label::Component}){
-            result &= mgConnection.executeAndDiscard(CipherQuery().match(Node{.name="n",.label=label}).del("n"));
+            result &= mgConnection().executeAndDiscard(CipherQuery().match(Node{.name="n",.label=label}).del("n"));
         }
         return result && dropConstraints() && dropIndexes();
     }
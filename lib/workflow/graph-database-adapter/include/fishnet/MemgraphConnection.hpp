@@ -1,6 +1,7 @@
 #pragma once
 #include <mgclient.hpp>
 #include <memory>
+#include <atomic>
 #include <expected>
 #include <sstream>
 #include <iostream>
@@ -29,6 +30,7 @@ concept CipherConnection = requires(const C & constConnection, const CipherQuery
  */
 class Session{
     friend class std::optional<Session>;
+    friend class MemgraphConnection;
 private:
     size_t _id = 0;
     Session(size_t id):_id(id){}
@@ -77,11 +79,23 @@ class MemgraphConnection {
 private:
     mutable std::unique_ptr<mg::Client> connection;
     mg::Client::Params params;
-     static inline std::unique_ptr<Session> session = nullptr;
+    static inline std::atomic_size_t currentSessionID = 0; // zero implies no session. Atomic, since tasks running in the same process read it concurrently
 
     explicit MemgraphConnection(std::unique_ptr<mg::Client> && connection,const mg::Client::Params & params)
     :connection(std::move(connection)),params(params){}
 
+    /**
+     * @brief Finalizes the mgclient library once, when the process exits
+     * 
+     */
+    static void finalizeAtExit() {
+        static const struct Finalizer {
+            ~Finalizer(){
+                mg::Client::Finalize();
+            }
+        } finalizer;
+    }
+
 public:
     constexpr static uint8_t MAX_RETRIES = 1;
     MemgraphConnection()=default;
@@ -111,6 +125,7 @@ public:
      * @return Either<MemgraphClient,std::string>: Containing the MemgraphClient on success or a string explaining the error
      */
     static fishnet::util::Either<MemgraphConnection,std::string> create(const mg::Client::Params & params) {
+        finalizeAtExit();
         auto clientPtr = mg::Client::Connect(params);
         if(not clientPtr){
             std::ostringstream connectionError;
@@ -126,7 +141,8 @@ public:
 
 
     /**
-     * @brief Factory Method to create a Memgraph Connection from Memgraph params loading a unique Session
+     * @brief Factory Method to create a Memgraph Connection from Memgraph params loading a unique Session.
+     * If the session is already set, e.g. by the scheduler running the tasks in its process, it is left unchanged.
      * 
      * @param params parameters for the database connection (e.g hostname, port,...)
      * @param sessionID unique session id to distinguish concurrent workflows runs on the basis of labels
@@ -134,7 +150,7 @@ public:
      */
     static fishnet::util::Either<MemgraphConnection,std::string> create(const mg::Client::Params & params, size_t sessionID) {
         auto eitherConnection = create(params);
-        if(sessionID==0)
+        if(sessionID==0 || MemgraphConnection::currentSessionID == sessionID)
             return eitherConnection; // sessionID of zero implies no session
         if(eitherConnection) {
             auto optSession = Session::of(eitherConnection.value(),sessionID);
@@ -196,26 +212,21 @@ public:
     }
 
 
-    constexpr static inline Session getSession() noexcept {
+    static inline Session getSession() noexcept {
         assert(MemgraphConnection::hasSession());
-        return *MemgraphConnection::session.get();
-    }
-
-    constexpr static inline bool hasSession() noexcept {
-        return MemgraphConnection::session != nullptr;
+        return Session(MemgraphConnection::currentSessionID);
     }
 
-    constexpr static inline void setSession(const Session & session){
-        MemgraphConnection::session = std::unique_ptr<Session>(new Session(session));
+    static inline bool hasSession() noexcept {
+        return MemgraphConnection::currentSessionID != 0;
     }
 
-    constexpr static inline void resetSession(){
-        MemgraphConnection::session = nullptr;
+    static inline void setSession(const Session & session){
+        MemgraphConnection::currentSessionID = session.id();
     }
 
-    ~MemgraphConnection(){
-        connection.reset(nullptr);
-        mg::Client::Finalize();
+    static inline void resetSession(){
+        MemgraphConnection::currentSessionID = 0;
     }
 };
 static_assert(CipherConnection<MemgraphConnection>);
\ No newline at end of file
@@ -34,8 +34,10 @@ struct MemgraphTaskConfig : public TaskConfig{
     constexpr static const char * MEMGRAPH_USE_SSL_KEY = "memgraph-use-ssl";
     constexpr static const char * MEMGRAPH_USERNAME_KEY = "memgraph-user";
     constexpr static const char * MEMGRAPH_PASSWORD_KEY = "memgraph-password";
+    constexpr static const char * MEMGRAPH_CONNECTIONS_KEY = "memgraph-connections";
 
     mg::Client::Params params;
+    size_t connections = 1; // maximum number of concurrent connections for tasks using a connection pool
 
     MemgraphTaskConfig(const json & configDescription):TaskConfig(configDescription){
         jsonDescription.at(MEMGRAPH_HOSTNAME_KEY).get_to(params.host);
@@ -43,6 +45,7 @@ struct MemgraphTaskConfig : public TaskConfig{
         set_or_else(jsonDescription,MEMGRAPH_USE_SSL_KEY,params.use_ssl,false);
         set_or_else(jsonDescription,MEMGRAPH_USERNAME_KEY,params.username,"");
         set_or_else(jsonDescription,MEMGRAPH_PASSWORD_KEY,params.password,"");
+        set_or_else(jsonDescription,MEMGRAPH_CONNECTIONS_KEY,connections,1);
     }
 private:
     template<typename T>
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <fishnet/KdTree.hpp>
+#include "Testutil.h"
+
+using namespace fishnet::geometry;
+using namespace testutil;
+
+class KdTreeTest: public ::testing::Test{
+protected:
+    void SetUp() override {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> coordinate(-1000,1000);
+        for(size_t i = 0; i < 2000; ++i) {
+            points.emplace_back(coordinate(gen),coordinate(gen));
+        }
+        for(size_t i = 0; i < 200; ++i) {
+            points.emplace_back(std::round(coordinate(gen)/100),std::round(coordinate(gen)/100)); // duplicates and equal coordinates
+        }
+        for(size_t i = 0; i < 100; ++i) {
+            queries.emplace_back(coordinate(gen)*1.2,coordinate(gen)*1.2);
+        }
+        queries.push_back(points.front());
+    }
+
+    std::vector<double> sortedDistances(const Vec2D<double> & query, const std::vector<size_t> & ids) const {
+        std::vector<double> distances;
+        for(size_t id: ids) {
+            distances.push_back(query.distance(points[id]));
+        }
+        return distances;
+    }
+
+    std::vector<double> bruteForceDistances(const Vec2D<double> & query, size_t k) const {
+        std::vector<double> distances;
+        for(const auto & p: points) {
+            distances.push_back(query.distance(p));
+        }
+        std::ranges::sort(distances);
+        distances.resize(std::min(k,distances.size()));
+        return distances;
+    }
+
+    std::vector<Vec2D<double>> points;
+    std::vector<Vec2D<double>> queries;
+};
+
+TEST_F(KdTreeTest, empty){
+    KdTree<double> tree {std::vector<Vec2D<double>>{}};
+    EXPECT_TRUE(tree.empty());
+    EXPECT_TRUE(tree.kNearest(Vec2D(0.0,0.0),3).empty());
+    EXPECT_FALSE(tree.nearest(Vec2D(0.0,0.0)).has_value());
+    EXPECT_TRUE(tree.withinRadius(Vec2D(0.0,0.0),10).empty());
+}
+
+TEST_F(KdTreeTest, kNearestMatchesBruteForce){
+    KdTree<double> tree {points};
+    EXPECT_EQ(tree.size(),points.size());
+    for(size_t k : {1,2,7,30}) {
+        for(const auto & q: queries) {
+            auto ids = tree.kNearest(q,k);
+            ASSERT_EQ(ids.size(),k);
+            auto distances = sortedDistances(q,ids);
+            EXPECT_TRUE(std::ranges::is_sorted(distances));
+            auto expected = bruteForceDistances(q,k);
+            for(size_t i = 0; i < k; ++i) {
+                EXPECT_DOUBLE_EQ(distances[i],expected[i]);
+            }
+        }
+    }
+}
+
+TEST_F(KdTreeTest, kExceedsSize){
+    std::vector<Vec2D<double>> few {{0,0},{1,1},{2,2}};
+    KdTree<double> tree {few};
+    auto ids = tree.kNearest(Vec2D(2.1,2.1),10);
+    EXPECT_EQ(ids,(std::vector<size_t>{2,1,0}));
+}
+
+TEST_F(KdTreeTest, predicate){
+    KdTree<double> tree {points};
+    const auto & query = points.front();
+    auto ids = tree.kNearest(query,5,[&query](const Vec2D<double> & p){return p != query;});
+    ASSERT_EQ(ids.size(),5);
+    for(size_t id: ids) {
+        EXPECT_NE(points[id],query);
+    }
+    auto nearest = tree.nearest(query);
+    ASSERT_TRUE(nearest.has_value());
+    EXPECT_EQ(points[nearest.value()],query);
+}
+
+TEST_F(KdTreeTest, withinRadius){
+    KdTree<double> tree {points};
+    for(double radius: {0.0,5.0,50.0,300.0}) {
+        for(const auto & q: queries) {
+            auto ids = tree.withinRadius(q,radius);
+            std::ranges::sort(ids);
+            std::vector<size_t> expected;
+            for(size_t i = 0; i < points.size(); ++i) {
+                if(q.distance(points[i]) <= radius)
+                    expected.push_back(i);
+            }
+            EXPECT_EQ(ids,expected);
+        }
+    }
+}
@@ -5,6 +5,9 @@
 #include "Testutil.h"
 #include "ShapeSamples.h"
 #include <unordered_map>
+#include <atomic>
+#include <memory>
+#include <span>
 
 using namespace testutil;
 using namespace fishnet::geometry;
@@ -79,6 +82,24 @@ TEST_F(PolygonNeighboursTest, touching){
     EXPECT_CONTAINS(result.at(b1),touchesB1);
 }
 
+TEST_F(PolygonNeighboursTest, concurrentMatchesSequential){
+    std::vector<PolygonType> grid;
+    for(int x = 0; x < 40; ++x) {
+        for(int y = 0; y < 40; ++y) {
+            double offset = (x*7+y*3)%5 * 0.1;
+            grid.push_back(SimplePolygonSamples::aaBB({x*1.5+offset,y*1.5},{x*1.5+offset+1,y*1.5+1}));
+        }
+    }
+    auto sequential = findNeighbouringPolygons(grid,DistancePredicate{1},BoxWrapper(1),3);
+    EXPECT_FALSE(sequential.empty());
+    for(size_t workers : {0,2,3,8}) {
+        auto concurrent = findNeighbouringPolygons(grid,DistancePredicate{1},BoxWrapper(1),3,workers);
+        EXPECT_EQ(concurrent,sequential);
+    }
+    auto fewPolygons = findNeighbouringPolygons(polygons,DistancePredicate{1},BoxWrapper(1),2,64);
+    EXPECT_EQ(fewPolygons,findNeighbouringPolygons(polygons,DistancePredicate{1},BoxWrapper(1),2));
+}
+
 // #define TEST_PERFORMANCE false
 // #if TEST_PERFORMANCE
 // #include <fishnet/VectorLayer.hpp>
@@ -131,4 +152,37 @@ TEST_F(PolygonNeighboursTest, touching){
 // //     std::cout << "Quadtree output size: " << fishnet::util::size(other) << std::endl;
 // //     quadtree.stopAndPrint();
 // }
-// #endif
\ No newline at end of file
+// #endif
+
+/**
+ * @brief Distance predicate on BoundingBoxPolygons, deciding all candidates at once
+ */
+struct BatchedDistancePredicate {
+    double maxDistance;
+    std::shared_ptr<std::atomic_size_t> batches = std::make_shared<std::atomic_size_t>(0);
+
+    bool operator()(const BoundingBoxPolygon<PolygonType> & lhs, const BoundingBoxPolygon<PolygonType> & rhs) const noexcept {
+        return lhs.getPolygon().distance(rhs.getPolygon()) <= maxDistance;
+    }
+
+    std::vector<bool> batch(const BoundingBoxPolygon<PolygonType> & current, std::span<const BoundingBoxPolygon<PolygonType> * const> candidates) const {
+        ++*batches;
+        std::vector<bool> result;
+        for(const auto * candidate: candidates) {
+            result.push_back((*this)(current,*candidate));
+        }
+        return result;
+    }
+};
+static_assert(BatchedBiPredicate<BatchedDistancePredicate,BoundingBoxPolygon<PolygonType>>);
+
+TEST_F(PolygonNeighboursTest, batchedMatchesPairwise){
+    double maxDistance = 1;
+    auto pairwise = findNeighbouringPolygons(polygons,DistancePredicate{maxDistance},BoxWrapper(maxDistance),2);
+    for(size_t workers: {1,3}) {
+        BatchedDistancePredicate batched {maxDistance};
+        auto result = findNeighbouringPolygonsTemplate(polygons,batched,BoxWrapper(maxDistance),2,workers);
+        EXPECT_EQ(result,pairwise);
+        EXPECT_EQ(batched.batches->load(),polygons.size());
+    }
+}
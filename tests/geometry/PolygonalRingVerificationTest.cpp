@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <numbers>
+#include <fishnet/PolygonalRingVerification.hpp>
+#include <fishnet/Ring.hpp>
+#include "Testutil.h"
+
+using namespace fishnet::geometry;
+using namespace testutil;
+
+static std::vector<Segment<double>> toSegments(const std::vector<Vec2D<double>> & points) {
+    std::vector<Segment<double>> segments;
+    for(size_t i = 0; i < points.size(); ++i) {
+        segments.emplace_back(points[i],points[(i+1)%points.size()]);
+    }
+    return segments;
+}
+
+static std::vector<Vec2D<double>> starShaped(size_t count, unsigned seed) {
+    std::mt19937 generator {seed};
+    std::uniform_real_distribution<double> radius {10,100};
+    std::vector<Vec2D<double>> points;
+    for(size_t i = 0; i < count; ++i) {
+        double angle = 2 * std::numbers::pi * double(i) / double(count);
+        double r = radius(generator);
+        points.emplace_back(r*std::cos(angle),r*std::sin(angle));
+    }
+    return points;
+}
+
+static std::vector<Vec2D<double>> staircase(size_t steps) {
+    std::vector<Vec2D<double>> points;
+    for(size_t i = 0; i < steps; ++i) {
+        points.emplace_back(double(i),double(i));
+        points.emplace_back(double(i+1),double(i));
+    }
+    points.emplace_back(double(steps),double(steps));
+    points.emplace_back(0,double(steps));
+    return points;
+}
+
+static bool sweepIsValid(const std::vector<Segment<double>> & segments) {
+    return not __impl::findIntersectingSegmentsSweep<double>(segments).has_value();
+}
+
+static bool bruteForceIsValid(const std::vector<Segment<double>> & segments) {
+    return not __impl::findIntersectingSegmentsBruteForce(segments).has_value();
+}
+
+TEST(PolygonalRingVerificationTest, validStarShaped) {
+    for(unsigned seed = 0; seed < 10; ++seed) {
+        auto segments = toSegments(starShaped(500,seed));
+        EXPECT_TRUE(bruteForceIsValid(segments));
+        EXPECT_TRUE(sweepIsValid(segments));
+        EXPECT_TRUE(isValidPolygonalRing<double>(segments));
+    }
+}
+
+TEST(PolygonalRingVerificationTest, validAxisParallel) {
+    auto segments = toSegments(staircase(200));
+    EXPECT_TRUE(bruteForceIsValid(segments));
+    EXPECT_TRUE(sweepIsValid(segments));
+}
+
+TEST(PolygonalRingVerificationTest, touchingVertex) {
+    // two star-shaped lobes touching in the origin
+    std::vector<Vec2D<double>> points;
+    for(int i = 0; i <= 100; ++i) {
+        points.emplace_back(double(i+1),double(51-std::abs(i-50)));
+    }
+    points.emplace_back(0,0);
+    for(int i = 0; i <= 100; ++i) {
+        points.emplace_back(double(-i-1),double(-51+std::abs(i-50)));
+    }
+    points.emplace_back(0,0);
+    auto segments = toSegments(points);
+    EXPECT_TRUE(bruteForceIsValid(segments));
+    EXPECT_TRUE(sweepIsValid(segments));
+}
+
+TEST(PolygonalRingVerificationTest, selfIntersecting) {
+    auto points = starShaped(500,42);
+    std::swap(points[100],points[350]);
+    auto segments = toSegments(points);
+    EXPECT_FALSE(bruteForceIsValid(segments));
+    EXPECT_FALSE(sweepIsValid(segments));
+    EXPECT_FALSE(isValidPolygonalRing<double>(segments));
+    EXPECT_THROW(verifyPolygonalRing<double>(segments),InvalidGeometryException);
+}
+
+TEST(PolygonalRingVerificationTest, overlappingCollinear) {
+    auto points = staircase(100);
+    points.emplace_back(0,50); // back-and-forth along the left edge
+    points.emplace_back(0,150);
+    auto segments = toSegments(points);
+    EXPECT_FALSE(bruteForceIsValid(segments));
+    EXPECT_FALSE(sweepIsValid(segments));
+}
+
+TEST(PolygonalRingVerificationTest, randomGridMatchesBruteForce) {
+    std::mt19937 generator {7};
+    std::uniform_int_distribution<int> coordinate {0,12};
+    for(size_t iteration = 0; iteration < 20000; ++iteration) {
+        std::vector<Vec2D<double>> points;
+        size_t count = 3 + iteration % 8;
+        for(size_t i = 0; i < count; ++i) {
+            points.emplace_back(coordinate(generator),coordinate(generator));
+        }
+        auto segments = toSegments(points);
+        if(__impl::findOpenSegment(segments))
+            continue; // intersections are only searched for closed rings
+        EXPECT_EQ(sweepIsValid(segments),bruteForceIsValid(segments));
+    }
+}
+
+TEST(PolygonalRingVerificationTest, uncheckedRing) {
+    std::vector<Vec2D<double>> bowTie {{0,0},{2,2},{2,0},{0,2}};
+    EXPECT_THROW(Ring<double>{bowTie},InvalidGeometryException);
+    EXPECT_NO_THROW(Ring<double>(bowTie,true));
+}
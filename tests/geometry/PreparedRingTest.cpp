@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <numbers>
+#include <fishnet/PreparedRing.hpp>
+#include "ShapeSamples.h"
+#include "Testutil.h"
+
+using namespace fishnet::geometry;
+using namespace testutil;
+
+/**
+ * @brief Star shaped ring with random radii, many vertices share their y-coordinate to exercise the vertex cases of the ray casting
+ */
+static Ring<double> randomStar(size_t vertices, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> radius(2000,10000);
+    std::vector<Vec2D<double>> points;
+    for(size_t i = 0; i < vertices; ++i) {
+        double angle = 2 * std::numbers::pi * double(i) / double(vertices);
+        double r = radius(gen);
+        points.emplace_back(std::round(r * std::cos(angle)),std::round(r * std::sin(angle)));
+    }
+    auto last = std::ranges::unique(points);
+    points.erase(last.begin(),last.end());
+    return Ring<double>(points);
+}
+
+/**
+ * @brief Query points: vertices, midpoints of segments, points on the horizontal lines through vertices and random points around the ring
+ */
+static std::vector<Vec2D<double>> queryPoints(const Ring<double> & ring, size_t randomPoints, unsigned seed) {
+    std::mt19937 gen(seed);
+    const auto & box = ring.getBoundingBox();
+    double margin = (box.right - box.left) / 10;
+    std::uniform_real_distribution<double> x(box.left-margin,box.right+margin);
+    std::uniform_real_distribution<double> y(box.bottom-margin,box.top+margin);
+    std::vector<Vec2D<double>> points;
+    for(const auto & s: ring.getSegments()) {
+        points.push_back(s.p());
+        points.push_back(s.p() + (s.q()-s.p()) * 0.5);
+        points.emplace_back(x(gen),s.p().y);
+        points.emplace_back(std::round(x(gen)),s.p().y);
+    }
+    for(size_t i = 0; i < randomPoints; ++i) {
+        points.emplace_back(x(gen),y(gen));
+        points.emplace_back(std::round(x(gen)),std::round(y(gen)));
+    }
+    return points;
+}
+
+static void expectSameLocations(const Ring<double> & ring, const std::vector<Vec2D<double>> & points) {
+    PreparedRing prepared {ring};
+    auto batch = prepared.locate(points);
+    ASSERT_EQ(batch.size(),points.size());
+    for(size_t i = 0; i < points.size(); ++i) {
+        const auto & p = points[i];
+        EXPECT_EQ(ring.contains(p),prepared.contains(p)) << p.toString();
+        EXPECT_EQ(ring.isInside(p),prepared.isInside(p)) << p.toString();
+        EXPECT_EQ(ring.isOnBoundary(p),prepared.isOnBoundary(p)) << p.toString();
+        EXPECT_EQ(prepared.getPointLocation(p),batch[i]) << p.toString();
+    }
+}
+
+TEST(PreparedRingTest, complexRing) {
+    expectSameLocations(LinearRingSamples::COMPLEX_RING,queryPoints(LinearRingSamples::COMPLEX_RING,1000,42));
+}
+
+TEST(PreparedRingTest, rectangle) {
+    auto box = LinearRingSamples::aaBB({0,10},{10,0});
+    PreparedRing prepared {box};
+    EXPECT_TRUE(prepared.isInside(Vec2D(5.0,5.0)));
+    EXPECT_TRUE(prepared.isOnBoundary(Vec2D(0.0,5.0)));
+    EXPECT_TRUE(prepared.isOnBoundary(Vec2D(10.0,10.0)));
+    EXPECT_TRUE(prepared.isOutside(Vec2D(-1.0,10.0)));
+    EXPECT_TRUE(prepared.isOutside(Vec2D(11.0,5.0)));
+    EXPECT_TRUE(prepared.isOutside(Vec2D(5.0,-0.5)));
+    expectSameLocations(box,queryPoints(box,200,7));
+}
+
+TEST(PreparedRingTest, randomStars) {
+    for(unsigned seed = 0; seed < 5; ++seed) {
+        auto star = randomStar(500,seed);
+        expectSameLocations(star,queryPoints(star,2000,seed));
+    }
+}
+
+TEST(PreparedRingTest, integerRing) {
+    Ring<int> square {std::vector<Vec2D<int>>{Vec2D(0,0),Vec2D(0,4),Vec2D(2,2),Vec2D(4,4),Vec2D(4,0)}};
+    PreparedRing prepared {square};
+    for(double x = -1; x <= 5; x += 0.25) {
+        for(double y = -1; y <= 5; y += 0.25) {
+            Vec2D<double> p {x,y};
+            EXPECT_EQ(square.contains(p),prepared.contains(p)) << p.toString();
+            EXPECT_EQ(square.isOnBoundary(p),prepared.isOnBoundary(p)) << p.toString();
+        }
+    }
+}
+
+TEST(PreparedRingTest, containsSegmentsAndRings) {
+    auto star = randomStar(300,11);
+    PreparedRing prepared {star};
+    auto points = queryPoints(star,200,3);
+    for(size_t i = 0; i + 1 < points.size(); ++i) {
+        Segment<double> s {points[i],points[i+1]};
+        EXPECT_EQ(star.contains(s),prepared.contains(s)) << s.toString();
+    }
+    for(size_t i = 0; i + 2 < points.size(); i += 3) {
+        if(fishnet::math::isZero((points[i+1]-points[i]).cross(points[i+2]-points[i])))
+            continue; // collinear
+        auto triangle = LinearRingSamples::triangle(points[i],points[i+1],points[i+2]);
+        EXPECT_EQ(star.contains(triangle),prepared.contains(triangle)) << triangle.toString();
+    }
+    EXPECT_TRUE(prepared.contains(LinearRingSamples::aaRhombus({0,0},500)));
+    EXPECT_FALSE(prepared.contains(LinearRingSamples::aaRhombus({0,0},50000)));
+}
+
+TEST(PreparedRingTest, intersectsSegments) {
+    for(unsigned seed = 0; seed < 3; ++seed) {
+        auto star = randomStar(400,seed);
+        PreparedRing prepared {star};
+        auto points = queryPoints(star,300,seed);
+        for(size_t i = 0; i + 1 < points.size(); ++i) {
+            Segment<double> s {points[i],points[i+1]};
+            EXPECT_EQ(star.intersects(s),prepared.intersects(s)) << s.toString();
+        }
+        for(const auto & s: star.getSegments()) {
+            EXPECT_FALSE(prepared.intersects(s)) << s.toString();
+        }
+    }
+}
+
+static Ring<double> transformed(const Ring<double> & ring, double scale, Vec2D<double> offset) {
+    std::vector<Vec2D<double>> points;
+    for(const auto & p: ring.getPoints()) {
+        points.push_back(p * scale + offset);
+    }
+    return Ring<double>(points);
+}
+
+TEST(PreparedRingTest, largeRingRelations) {
+    auto star = randomStar(500,21);
+    auto other = randomStar(500,22);
+    auto inner = transformed(other,0.1,{0,0});
+    auto shifted = transformed(other,1,{6000,0});
+    auto farAway = transformed(other,1,{50000,0});
+    auto pairwiseCrosses = [](const Ring<double> & lhs, const Ring<double> & rhs){
+        return std::ranges::any_of(lhs.getSegments(),[&rhs](const auto & s){return rhs.intersects(s);})
+            || std::ranges::any_of(rhs.getSegments(),[&lhs](const auto & s){return lhs.intersects(s);});
+    };
+    auto pairwiseContains = [](const Ring<double> & lhs, const Ring<double> & rhs){
+        return std::ranges::all_of(rhs.getSegments(),[&lhs](const auto & s){return lhs.contains(s);});
+    };
+    for(const auto & ring: {other,inner,shifted,farAway,star}) {
+        EXPECT_EQ(star.crosses(ring),pairwiseCrosses(star,ring));
+        EXPECT_EQ(ring.crosses(star),pairwiseCrosses(ring,star));
+        EXPECT_EQ(star.contains(ring),pairwiseContains(star,ring));
+        EXPECT_EQ(ring.contains(star),pairwiseContains(ring,star));
+    }
+    EXPECT_TRUE(star.contains(inner));
+    EXPECT_FALSE(star.crosses(inner));
+    EXPECT_FALSE(inner.contains(star));
+    EXPECT_TRUE(star.crosses(shifted));
+    EXPECT_FALSE(star.contains(shifted));
+    EXPECT_FALSE(star.crosses(farAway));
+    EXPECT_FALSE(star.contains(farAway));
+    EXPECT_FALSE(star.touches(farAway));
+}
+
+TEST(PreparedRingTest, largeRingTouchesAndDistance) {
+    auto star = randomStar(500,23);
+    auto rightMost = std::ranges::max(star.getPoints(),{},[](const auto & p){return p.x;});
+    std::vector<Vec2D<double>> points {rightMost};
+    for(size_t i = 0; i <= 50; ++i) {
+        double angle = std::numbers::pi * (0.5 - double(i) / 50);
+        points.emplace_back(rightMost.x + 100 + 5000 * std::cos(angle),rightMost.y + 3000 * std::sin(angle));
+    }
+    Ring<double> touching {points};
+    auto inner = transformed(star,0.1,{0,0});
+    auto farAway = transformed(star,1,{50000,0});
+    EXPECT_TRUE(star.touches(touching));
+    EXPECT_TRUE(touching.touches(star));
+    EXPECT_FALSE(star.touches(inner));
+    EXPECT_FALSE(star.touches(star));
+    EXPECT_DOUBLE_EQ(star.distance(touching),0);
+    EXPECT_EQ(star.distance(inner),-1);
+    EXPECT_EQ(inner.distance(star),-1);
+    EXPECT_GT(star.distance(farAway),0);
+}
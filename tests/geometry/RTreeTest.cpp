@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <fishnet/RTree.hpp>
+#include <fishnet/Vec2D.hpp>
+#include "Testutil.h"
+
+using namespace fishnet::geometry;
+using namespace testutil;
+using Box = AABB<double>;
+
+static std::vector<Box> randomBoxes(size_t count, unsigned seed) {
+    std::mt19937 generator {seed};
+    std::uniform_real_distribution<double> position {-1000,1000};
+    std::uniform_real_distribution<double> extent {0,25};
+    std::vector<Box> boxes;
+    for(size_t i = 0; i < count; ++i) {
+        double left = position(generator);
+        double bottom = position(generator);
+        boxes.emplace_back(left,bottom+extent(generator),left+extent(generator),bottom);
+    }
+    return boxes;
+}
+
+static std::vector<size_t> bruteForceQuery(const std::vector<Box> & boxes, const Box & query) {
+    std::vector<size_t> result;
+    for(size_t i = 0; i < boxes.size(); ++i) {
+        if(boxes[i].overlap(query))
+            result.push_back(i);
+    }
+    return result;
+}
+
+TEST(RTreeTest, empty) {
+    PackedRTree<> tree {std::vector<Box>()};
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.height(),0);
+    EXPECT_EMPTY(tree.query(Box(0,1,1,0)));
+    EXPECT_ANY_THROW(tree.bounds());
+}
+
+TEST(RTreeTest, singleLeaf) {
+    std::vector<Box> boxes = {Box(0,1,1,0),Box(2,3,3,2),Box(0.5,2.5,2.5,0.5)};
+    PackedRTree<> tree {boxes};
+    EXPECT_EQ(tree.size(),3);
+    EXPECT_EQ(tree.height(),1);
+    EXPECT_EQ(tree.bounds(),Box(0,3,3,0));
+    auto result = tree.query(Box(0.9,1.1,1.1,0.9));
+    std::ranges::sort(result);
+    EXPECT_EQ(result,(std::vector<size_t>{0,2}));
+    EXPECT_EQ(tree.query(Box(3,4,4,3)),std::vector<size_t>{1}); // touching corner
+    EXPECT_EMPTY(tree.query(Box(4,5,5,4)));
+}
+
+TEST(RTreeTest, matchesBruteForce) {
+    auto boxes = randomBoxes(5000,42);
+    PackedRTree<> tree {boxes};
+    EXPECT_EQ(tree.size(),boxes.size());
+    EXPECT_GT(tree.height(),2);
+    for(const auto & query : randomBoxes(200,7)) {
+        auto result = tree.query(query);
+        std::ranges::sort(result);
+        EXPECT_EQ(result,bruteForceQuery(boxes,query));
+    }
+}
+
+TEST(RTreeTest, elementMapper) {
+    std::vector<Vec2D<double>> points = {{0,0},{5,5},{10,10}};
+    PackedRTree<> tree {points,[](const Vec2D<double> & p){return Box(p.x-1,p.y+1,p.x+1,p.y-1);}};
+    EXPECT_EQ(tree.query(Box(4,6,6,4)),std::vector<size_t>{1});
+    EXPECT_SIZE(tree.query(Box(-1,10,10,-1)),3);
+}
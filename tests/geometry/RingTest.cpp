@@ -91,6 +91,14 @@ TEST_F(RingTest, castToDouble) {
     EXPECT_TYPE<Ring<double>>(squareAsDoubleRing);
 }
 
+TEST_F(RingTest, castToInt) {
+    Ring<double> triangle {std::vector<Vec2D<double>>{Vec2D(0.0,0.0),Vec2D(0.2,2.3),Vec2D(2.1,2.2)}};
+    auto triangleAsIntRing = static_cast<Ring<int>>(triangle);
+    EXPECT_EQ(triangleAsIntRing,Ring<int>({Vec2D(0,0),Vec2D(0,2),Vec2D(2,2)}));
+    Ring<double> collapsing {std::vector<Vec2D<double>>{Vec2D(0.0,0.0),Vec2D(0.2,0.3),Vec2D(0.4,0.1)}};
+    EXPECT_ANY_THROW(static_cast<Ring<int>>(collapsing));
+}
+
 TEST_F(RingTest, getter){
     EXPECT_RANGE_EQ(ring->getPoints(),points);
     std::vector<Segment<double>> expectedRingSegments {
@@ -126,6 +134,12 @@ TEST_F(RingTest, aaBB){
     EXPECT_EQ(square->aaBB(),*square);
 }
 
+TEST_F(RingTest, getBoundingBox){
+    EXPECT_EQ(ring->getBoundingBox(),AABB<double>(-3,4,4,-1));
+    EXPECT_EQ(convex->getBoundingBox(),AABB<double>(3,5,5,3));
+    EXPECT_EQ(square->getBoundingBox(),AABB<int>(0,1,1,0));
+}
+
 TEST_F(RingTest, containsPoint){
     for(const auto & p: points){
         EXPECT_TRUE(ring->contains(p));
@@ -217,6 +231,16 @@ TEST_F(RingTest, equality){
     EXPECT_NE(*square, someMatching);
 }
 
+TEST_F(RingTest, hash){
+    auto hasher = std::hash<Ring<int>>();
+    auto squareReordered = Ring<int>(std::vector<Vec2D<int>>{Vec2D(1,1),Vec2D(1,0),Vec2D(0,0),Vec2D(0,1),});
+    auto squareCCW = Ring<int>(std::vector<Vec2D<int>>{Vec2D(1,1),Vec2D(0,1),Vec2D(0,0),Vec2D(1,0)});
+    EXPECT_EQ(hasher(*square),hasher(squareReordered));
+    EXPECT_EQ(hasher(*square),hasher(squareCCW));
+    Ring<int> copy = *square;
+    EXPECT_EQ(hasher(copy),hasher(*square));
+}
+
 TEST_F(RingTest, crosses){
     EXPECT_FALSE(ring->crosses(*convex));
     EXPECT_FALSE(ring->crosses(*square));
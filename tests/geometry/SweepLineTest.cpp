@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <fishnet/SweepLine.hpp>
+#include <fishnet/FlatSweepLine.hpp>
 #include <fishnet/Vec2D.hpp>
 #include <fishnet/PolygonFilter.hpp>
 #include "ShapeSamples.h"
@@ -91,4 +92,50 @@ TEST(SweepLineTest, polygonFiltering) {
     auto filtered_view = filter(std::views::all(polygons) | std::views::transform([](const auto & v){return v;}),binaryFilterCondition,areaFilter);
     EXPECT_SIZE(filtered_view, 1); //added test for views, to discover reference errors
 
-}
\ No newline at end of file
+}
+
+using MyFlatSweepLine = FlatSweepLine<const Vec2D<double> *,std::vector<std::string>>;
+
+TEST(SweepLineTest, flatSweepLineOrder) {
+    std::vector<Vec2D<double>>  points  =  {
+        {1,1},{2,1},{2,5},{5,1},{-2,4},{3,4},{0,1},{7,5}
+    };
+    auto eventMapper = [](const Vec2D<double> & vec){
+        std::vector<MySweepLine::eventPointer> events;
+        events.emplace_back(std::make_unique<MyPointInsertEvent>(vec));
+        events.emplace_back(std::make_unique<MyPointRemoveEvent>(vec));
+        return events;
+    };
+    std::vector<std::string> expected;
+    MySweepLine sweepLine;
+    sweepLine.addEvents(points,eventMapper);
+    sweepLine.sweep(expected);
+
+    MyFlatSweepLine flatSweepLine;
+    flatSweepLine.reserve(2*points.size());
+    for(const auto & p: points) {
+        flatSweepLine.addInsertEvent(p.y,&p);
+        flatSweepLine.addRemoveEvent(p.y,&p);
+    }
+    EXPECT_EQ(flatSweepLine.size(),2*points.size());
+    flatSweepLine.sweep([](const MyFlatSweepLine::Event & event, std::vector<std::string> & output){
+        if(event.type == EventType::INSERT)
+            output.push_back("Inserting: "+event.payload->toString());
+        else
+            output.push_back("Removing: "+event.payload->toString());
+    });
+    EXPECT_EQ(flatSweepLine.getStatus(),expected);
+    EXPECT_EQ(flatSweepLine.size(),0);
+}
+
+TEST(SweepLineTest, flatSweepLineStop) {
+    FlatSweepLine<int,std::vector<int>,false,std::less<double>> sweepLine;
+    for(int i = 5; i >= 0; --i) {
+        sweepLine.addInsertEvent(i,i);
+    }
+    sweepLine.sweep([](const auto & event, std::vector<int> & visited){
+        visited.push_back(event.payload);
+        return event.payload < 3;
+    });
+    EXPECT_EQ(sweepLine.getStatus(),(std::vector<int>{0,1,2,3}));
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <random>
 #include <fishnet/NearestNeighbours.hpp>
 #include "Testutil.h"
 
@@ -51,3 +52,27 @@ TEST_F(kNearestNeighboursTest, SingleNeighbourAvailable){
     points.insert(Vec2D(0,0));
     EXPECT_EQ(nearestNeighbour(Vec2D<double>(1,1),points),Vec2D<double>(0,0));
 }
+
+TEST_F(kNearestNeighboursTest, OrderedByDistance){
+    std::set<Vec2D<double>,LexicographicOrder> orderedPoints {points.begin(),points.end()};
+    auto neighbours = kNearestNeighbours(A,orderedPoints,3);
+    EXPECT_EQ(neighbours,(std::vector<Vec2D<double>>{B,C,D}));
+    EXPECT_EQ(kNearestNeighbours(A,orderedPoints,100).size(),points.size()-1);
+}
+
+TEST_F(kNearestNeighboursTest, ParallelMatchesSequential){
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> coordinate(-500,500);
+    std::vector<Vec2D<double>> randomPoints;
+    for(size_t i = 0; i < 3000; ++i) {
+        randomPoints.emplace_back(coordinate(gen),coordinate(gen));
+    }
+    fishnet::util::WorkStealingThreadPool pool {4};
+    auto sequential = AllKNearestNeighbours<double>(randomPoints,6);
+    auto parallel = AllKNearestNeighbours<double>(randomPoints,6,pool);
+    EXPECT_EQ(sequential,parallel);
+    std::set<Vec2D<double>,LexicographicOrder> orderedPoints {randomPoints.begin(),randomPoints.end()};
+    for(const auto & [point,neighbours]: sequential) {
+        EXPECT_EQ(neighbours,kNearestNeighbours(point,orderedPoints,6));
+    }
+}
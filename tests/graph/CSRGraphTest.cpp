@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <fishnet/Graph.hpp>
+#include <fishnet/BFSAlgorithm.hpp>
+#include <fishnet/DegreeCentrality.hpp>
+#include "Testutil.h"
+#include "IDNode.h"
+#include "GraphTestUtil.h"
+
+using namespace fishnet::graph;
+using namespace testutil;
+
+static_assert(Graph<decltype(GraphFactory::CSRGraph(UndirectedGraph<IDNode>()))>);
+static_assert(Graph<decltype(GraphFactory::CSRGraph(DirectedGraph<IDNode>()))>);
+static_assert(AdjacencyContainer<CSRAdjacency<IDNode>,IDNode>);
+
+static std::vector<int> sortedIds(std::ranges::input_range auto && nodes) {
+    std::vector<int> ids;
+    for(const IDNode & node: nodes) {
+        ids.push_back(node.getId());
+    }
+    std::ranges::sort(ids);
+    return ids;
+}
+
+static std::vector<std::pair<int,int>> sortedEdges(const std::ranges::input_range auto & edges) {
+    std::vector<std::pair<int,int>> pairs;
+    for(const auto & edge: edges) {
+        auto from = edge.getFrom().getId();
+        auto to = edge.getTo().getId();
+        if(not edge.isDirected() && to < from)
+            std::swap(from,to);
+        pairs.emplace_back(from,to);
+    }
+    std::ranges::sort(pairs);
+    return pairs;
+}
+
+class CSRGraphTest: public ::testing::Test{
+protected:
+    void SetUp() override {
+        undirected.addNodes(nodes);
+        undirected.addEdge(nodes[0],nodes[1]);
+        undirected.addEdge(nodes[1],nodes[2]);
+        undirected.addEdge(nodes[2],nodes[0]);
+        undirected.addEdge(nodes[3],nodes[4]);
+        directed.addNodes(nodes);
+        directed.addEdge(nodes[0],nodes[1]);
+        directed.addEdge(nodes[0],nodes[2]);
+        directed.addEdge(nodes[2],nodes[1]);
+        directed.addEdge(nodes[4],nodes[3]);
+    }
+    std::vector<IDNode> nodes = getVectorOfNodes(6);
+    UndirectedGraph<IDNode> undirected;
+    DirectedGraph<IDNode> directed;
+};
+
+TEST_F(CSRGraphTest, undirected) {
+    auto csr = GraphFactory::CSRGraph(undirected);
+    EXPECT_EQ(csr.size(),nodes.size());
+    EXPECT_EQ(sortedIds(csr.getNodes()),sortedIds(undirected.getNodes()));
+    for(const auto & node: nodes) {
+        EXPECT_TRUE(csr.containsNode(node));
+        EXPECT_EQ(sortedIds(csr.getNeighbours(node)),sortedIds(undirected.getNeighbours(node)));
+        EXPECT_EQ(sortedIds(csr.getReachableFrom(node)),sortedIds(undirected.getReachableFrom(node)));
+    }
+    EXPECT_TRUE(csr.containsEdge(nodes[1],nodes[0]));
+    EXPECT_FALSE(csr.containsEdge(nodes[0],nodes[3]));
+    EXPECT_EQ(sortedEdges(csr.getEdges()),sortedEdges(undirected.getEdges()));
+    EXPECT_FALSE(csr.containsNode(IDNode()));
+    EXPECT_EMPTY(csr.getNeighbours(IDNode()));
+}
+
+TEST_F(CSRGraphTest, directed) {
+    auto csr = GraphFactory::CSRGraph(directed);
+    for(const auto & node: nodes) {
+        EXPECT_EQ(sortedIds(csr.getNeighbours(node)),sortedIds(directed.getNeighbours(node)));
+        EXPECT_EQ(sortedIds(csr.getReachableFrom(node)),sortedIds(directed.getReachableFrom(node)));
+        EXPECT_EQ(sortedEdges(csr.getInboundEdges(node)),sortedEdges(directed.getInboundEdges(node)));
+    }
+    EXPECT_TRUE(csr.containsEdge(nodes[2],nodes[1]));
+    EXPECT_FALSE(csr.containsEdge(nodes[1],nodes[2]));
+    EXPECT_EQ(sortedEdges(csr.getEdges()),sortedEdges(directed.getEdges()));
+}
+
+TEST_F(CSRGraphTest, ids) {
+    auto csr = GraphFactory::CSRGraph(directed);
+    auto id = csr.id(nodes[0]);
+    ASSERT_TRUE(id.has_value());
+    EXPECT_EQ(csr.node(id.value()),nodes[0]);
+    EXPECT_SIZE(csr.neighbourIds(id.value()),2);
+    EXPECT_EMPTY(csr.reachableFromIds(id.value()));
+    EXPECT_SIZE(csr.reachableFromIds(csr.id(nodes[1]).value()),2);
+    EXPECT_FALSE(csr.id(IDNode()).has_value());
+}
+
+TEST_F(CSRGraphTest, immutable) {
+    auto csr = GraphFactory::CSRGraph(undirected);
+    EXPECT_THROW(csr.addNode(IDNode()),std::logic_error);
+    EXPECT_THROW(csr.addEdge(nodes[0],nodes[5]),std::logic_error);
+    EXPECT_THROW(csr.removeNode(nodes[0]),std::logic_error);
+    EXPECT_THROW(csr.removeEdge(nodes[0],nodes[1]),std::logic_error);
+    csr.clear();
+    EXPECT_EMPTY(csr.getNodes());
+}
+
+TEST_F(CSRGraphTest, algorithms) {
+    auto csr = GraphFactory::CSRGraph(undirected);
+    auto components = BFS::connectedComponents(csr).asMap();
+    auto expected = BFS::connectedComponents(undirected).asMap();
+    for(const auto & u: nodes) {
+        for(const auto & v: nodes) {
+            EXPECT_EQ(components.at(u)==components.at(v),expected.at(u)==expected.at(v));
+        }
+    }
+    auto degrees = DegreeCentrality()(csr);
+    EXPECT_SIZE(degrees,nodes.size());
+    for(const auto & [node,degree]: degrees) {
+        EXPECT_EQ(degree,fishnet::util::size(undirected.getNeighbours(node)));
+    }
+}
+
+TEST_F(CSRGraphTest, completeGraph) {
+    auto complete = getCompleteIDGraph(50);
+    auto csr = GraphFactory::CSRGraph(complete);
+    EXPECT_EQ(csr.getAdjacencyContainer().adjacencyCount(),50*49);
+    EXPECT_SIZE(csr.getEdges(),50*49/2);
+    for(const auto & node: complete.getNodes()) {
+        EXPECT_SIZE(csr.getNeighbours(node),49);
+    }
+}
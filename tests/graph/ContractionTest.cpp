@@ -3,10 +3,13 @@
 #include <fishnet/WeightedGraph.hpp>
 #include "XYNode.h"
 #include "GraphTestUtil.h"
+#include "Testutil.h"
 #include <fishnet/StopWatch.h>
 #include <queue>
 #include <fstream>
 
+using namespace testutil;
+
 
 struct MergePredicate{
     bool operator()(const XYNode & n1, const XYNode & n2)const{
@@ -63,3 +66,97 @@ TEST_F(ContractionTest, SingleWorker){
         EXPECT_FALSE(Predicate(e.getFrom(),e.getTo()));
     }
 }
+
+struct MinXReduceFunction{
+    XYNode operator()(const std::vector<XYNode> & nodes) const {
+        return std::ranges::min(nodes,{},&XYNode::getX);
+    }
+};
+
+struct MinIdReduceFunction{
+    IDNode operator()(const std::vector<IDNode> & nodes) const {
+        return std::ranges::min(nodes,{},&IDNode::getId);
+    }
+};
+
+/**
+ * @brief Builds the contracted graph from the node and edge sinks of the streaming contraction
+ */
+template<fishnet::graph::Graph G>
+G contractStreamingToGraph(const G & source, auto const & predicate, auto const & reduceFunction, u_int8_t workers, size_t queueCapacity) {
+    using N = typename G::node_type;
+    std::unordered_map<int,N> merged;
+    std::vector<std::pair<int,int>> edges;
+    int components = fishnet::graph::contractStreaming(source,predicate,reduceFunction,
+        [&merged](int componentId, N && node){EXPECT_TRUE(merged.try_emplace(componentId,std::move(node)).second);},
+        [&edges](int from, int to){edges.emplace_back(from,to);},
+        workers,queueCapacity);
+    EXPECT_EQ(size_t(components),merged.size());
+    G result;
+    for(const auto & [_,node]: merged){
+        result.addNode(node);
+    }
+    for(const auto & [from,to]: edges){
+        result.addEdge(merged.at(from),merged.at(to));
+    }
+    return result;
+}
+
+TEST_F(ContractionTest, StreamingMatchesContract){
+    auto predicate = [](const XYNode & n1, const XYNode & n2){return n1.distanceTo(n2) <= 15.0;};
+    auto expected = fishnet::graph::contract(g,predicate,MinXReduceFunction());
+    for(u_int8_t workers: {u_int8_t(1),u_int8_t(4)}){
+        auto result = contractStreamingToGraph(g,predicate,MinXReduceFunction(),workers,2);
+        EXPECT_UNSORTED_RANGE_EQ(result.getNodes(),expected.getNodes());
+        EXPECT_EQ(fishnet::util::size(result.getEdges()),fishnet::util::size(expected.getEdges()));
+        for(const auto & edge: expected.getEdges()){
+            EXPECT_TRUE(result.containsEdge(edge.getFrom(),edge.getTo()));
+        }
+    }
+}
+
+TEST(StreamingContractionTest, DirectedEdges){
+    auto nodes = getVectorOfNodes(6);
+    fishnet::graph::DirectedGraph<IDNode> g;
+    g.addNodes(nodes);
+    g.addEdge(nodes[0],nodes[1]); // contracted
+    g.addEdge(nodes[2],nodes[0]);
+    g.addEdge(nodes[1],nodes[3]);
+    g.addEdge(nodes[3],nodes[4]); // contracted
+    g.addEdge(nodes[5],nodes[4]);
+    auto predicate = [&nodes](const IDNode & from, const IDNode & to){
+        return (from == nodes[0] && to == nodes[1]) || (from == nodes[3] && to == nodes[4]);
+    };
+    auto expected = fishnet::graph::contract(g,predicate,MinIdReduceFunction());
+    auto result = contractStreamingToGraph(g,predicate,MinIdReduceFunction(),2,1);
+    EXPECT_UNSORTED_RANGE_EQ(result.getNodes(),expected.getNodes());
+    EXPECT_EQ(fishnet::util::size(result.getEdges()),fishnet::util::size(expected.getEdges()));
+    for(const auto & edge: expected.getEdges()){
+        EXPECT_TRUE(result.containsEdge(edge.getFrom(),edge.getTo()));
+        EXPECT_FALSE(result.containsEdge(edge.getTo(),edge.getFrom()));
+    }
+}
+
+TEST(StreamingContractionTest, SinkExceptionIsRethrown){
+    auto nodes = getVectorOfNodes(100);
+    fishnet::graph::UndirectedGraph<IDNode> g;
+    g.addNodes(nodes);
+    auto never = [](const IDNode &, const IDNode &){return false;};
+    EXPECT_THROW(fishnet::graph::contractStreaming(g,never,MinIdReduceFunction(),
+        [](int, IDNode &&){throw std::runtime_error("Sink failed");},
+        [](int,int){},
+        2,4),std::runtime_error);
+}
+
+TEST(ContractionExceptionTest, ReduceExceptionIsRethrown){
+    auto nodes = getVectorOfNodes(4000);
+    fishnet::graph::UndirectedGraph<IDNode> g;
+    g.addNodes(nodes);
+    for(size_t i = 0; i + 1 < nodes.size(); i+=2){
+        g.addEdge(nodes[i],nodes[i+1]); // more components than fit into the queue
+    }
+    auto always = [](const IDNode &, const IDNode &){return true;};
+    auto failingReduce = [](const std::vector<IDNode> &) -> IDNode {throw std::runtime_error("Reduce failed");};
+    fishnet::graph::UndirectedGraph<IDNode> result;
+    EXPECT_THROW(fishnet::graph::contract(g,always,failingReduce,result,2),std::runtime_error);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <fishnet/Graph.hpp>
+#include <fishnet/BFSAlgorithm.hpp>
+#include <fishnet/UnionFind.hpp>
+#include "Testutil.h"
+#include "IDNode.h"
+#include "GraphTestUtil.h"
+
+using namespace fishnet::graph;
+using namespace testutil;
+
+static std::set<std::set<int>> asSets(const std::vector<std::vector<IDNode>> & components) {
+    std::set<std::set<int>> sets;
+    for(const auto & component: components) {
+        std::set<int> ids;
+        for(const auto & node: component) {
+            ids.insert(node.getId());
+        }
+        sets.insert(std::move(ids));
+    }
+    return sets;
+}
+
+static UndirectedGraph<IDNode> randomGraph(size_t nodeCount, size_t edgeCount, unsigned seed) {
+    auto nodes = getVectorOfNodes(nodeCount);
+    UndirectedGraph<IDNode> graph(nodes);
+    std::mt19937 generator {seed};
+    std::uniform_int_distribution<size_t> index {0,nodeCount-1};
+    for(size_t i = 0; i < edgeCount; ++i) {
+        graph.addEdge(nodes[index(generator)],nodes[index(generator)]);
+    }
+    return graph;
+}
+
+TEST(UnionFindTest, disjointSet) {
+    ConcurrentDisjointSet sets {5};
+    EXPECT_TRUE(sets.unite(3,4));
+    EXPECT_TRUE(sets.unite(4,1));
+    EXPECT_FALSE(sets.unite(1,3));
+    EXPECT_EQ(sets.find(3),1);
+    EXPECT_TRUE(sets.sameSet(4,1));
+    EXPECT_FALSE(sets.sameSet(0,4));
+    EXPECT_EQ(sets.find(2),2);
+}
+
+TEST(UnionFindTest, concurrentUnite) {
+    constexpr size_t size = 100000;
+    ConcurrentDisjointSet sets {size};
+    std::vector<std::future<void>> futures;
+    for(size_t worker = 0; worker < 8; ++worker) {
+        futures.push_back(std::async(std::launch::async,[&sets,worker](){
+            for(size_t i = worker; i+2 < size; i += 8) {
+                sets.unite(i,i+2); // even and odd ids form one set each
+            }
+        }));
+    }
+    for(auto & future: futures)
+        future.get();
+    for(size_t i = 0; i < size; ++i) {
+        EXPECT_EQ(sets.find(i),i%2);
+    }
+}
+
+TEST(UnionFindTest, matchesBFS) {
+    for(size_t workers : {1,2,8}) {
+        for(unsigned seed = 0; seed < 5; ++seed) {
+            auto graph = randomGraph(2000,1500,seed);
+            auto expected = asSets(BFS::connectedComponents(graph).get());
+            EXPECT_EQ(asSets(UnionFind::connectedComponents(graph,workers)),expected);
+            EXPECT_EQ(asSets(UnionFind::connectedComponents(GraphFactory::CSRGraph(graph),workers)),expected);
+        }
+    }
+}
+
+TEST(UnionFindTest, nodesAndEdges) {
+    auto nodes = getVectorOfNodes(5);
+    std::vector<std::pair<IDNode,IDNode>> edges {{nodes[0],nodes[3]},{nodes[4],nodes[3]}};
+    auto components = UnionFind::connectedComponents<IDNode>(nodes,edges,2);
+    ASSERT_EQ(components.size(),3);
+    EXPECT_EQ(components[0],std::vector<IDNode>({nodes[0],nodes[3],nodes[4]}));
+    EXPECT_EQ(components[1],std::vector<IDNode>({nodes[1]}));
+    EXPECT_EQ(components[2],std::vector<IDNode>({nodes[2]}));
+    EXPECT_EMPTY(UnionFind::connectedComponents<IDNode>(std::vector<IDNode>(),std::vector<std::pair<IDNode,IDNode>>()));
+}
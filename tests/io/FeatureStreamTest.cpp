@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <fishnet/FeatureStream.hpp>
+#include <fishnet/VectorIO.hpp>
+#include <fishnet/Rectangle.hpp>
+#include <fishnet/PathHelper.h>
+#include <fishnet/TemporaryDirectiory.h>
+#include "Testutil.h"
+
+using namespace fishnet;
+using namespace fishnet::geometry;
+using namespace testutil;
+
+class FeatureStreamTest: public ::testing::Test {
+protected:
+    Shapefile sample {util::PathHelper::projectDirectory() / std::filesystem::path("data/testing/Punjab_Small/Punjab_Small.shp")};
+    VectorLayer<Polygon<double>> sampleLayer = VectorIO::read<Polygon<double>>(sample);
+    FeatureStream<Polygon<double>> stream = VectorIO::stream<Polygon<double>>(sample);
+
+    std::vector<size_t> ids(auto && features) {
+        auto idField = stream.getSchema().getSizeField("FISHNET_ID").value();
+        std::vector<size_t> result;
+        for(const auto & feature: features) {
+            result.push_back(feature.getAttribute(idField).value());
+        }
+        return result;
+    }
+
+    Rectangle<double> boundingBox() {
+        Rectangle<double> aaBB {sampleLayer.getGeometries().front()};
+        double left = aaBB.left(), right = aaBB.right(), top = aaBB.top(), bottom = aaBB.bottom();
+        for(const auto & polygon: sampleLayer.getGeometries()) {
+            Rectangle<double> box {polygon};
+            left = std::min(left,box.left());
+            right = std::max(right,box.right());
+            top = std::max(top,box.top());
+            bottom = std::min(bottom,box.bottom());
+        }
+        return Rectangle<double>(left,top,right,bottom);
+    }
+};
+
+TEST_F(FeatureStreamTest, streamAllFeatures) {
+    std::vector<Polygon<double>> geometries;
+    for(auto & feature: stream) {
+        geometries.push_back(feature.getGeometry());
+    }
+    EXPECT_EQ(geometries.size(),sampleLayer.size());
+    EXPECT_UNSORTED_RANGE_EQ(geometries,sampleLayer.getGeometries());
+    EXPECT_EQ(stream.featureCount(),sampleLayer.size());
+    EXPECT_TRUE(stream.getSpatialReference().IsSame(&sampleLayer.getSpatialReference()));
+}
+
+TEST_F(FeatureStreamTest, restartReading) {
+    auto first = ids(stream);
+    auto second = ids(stream);
+    EXPECT_EQ(first.size(),sampleLayer.size());
+    EXPECT_EQ(first,second);
+}
+
+TEST_F(FeatureStreamTest, attributeFilter) {
+    stream.setAttributeFilter("FISHNET_ID < 10");
+    auto filtered = ids(stream);
+    EXPECT_EQ(filtered.size(),10);
+    EXPECT_TRUE(std::ranges::all_of(filtered,[](size_t id){return id < 10;}));
+    EXPECT_EQ(stream.featureCount(),10);
+    stream.setAttributeFilter("");
+    EXPECT_EQ(ids(stream).size(),sampleLayer.size());
+    EXPECT_THROW(stream.setAttributeFilter("NOT_A_FIELD <<< 3"),std::invalid_argument);
+}
+
+TEST_F(FeatureStreamTest, spatialFilter) {
+    Rectangle<double> aaBB = boundingBox();
+    double middle = (aaBB.left() + aaBB.right()) / 2;
+    Rectangle<double> westernHalf {aaBB.left(),aaBB.top(),middle,aaBB.bottom()};
+    stream.setSpatialFilter(westernHalf);
+    auto filtered = stream.collect();
+    EXPECT_GT(filtered.size(),0);
+    EXPECT_LT(filtered.size(),sampleLayer.size());
+    for(const auto & polygon: filtered.getGeometries()) {
+        EXPECT_LE(Rectangle<double>(polygon).left(),middle);
+    }
+    for(const auto & polygon: sampleLayer.getGeometries()) {
+        if(Rectangle<double>(polygon).right() < middle){
+            EXPECT_TRUE(filtered.containsGeometry(polygon));
+        }
+    }
+    stream.clearSpatialFilter();
+    EXPECT_EQ(stream.collect().size(),sampleLayer.size());
+}
+
+TEST_F(FeatureStreamTest, combinedFilters) {
+    stream.setAttributeFilter("FISHNET_ID >= 100").setSpatialFilter(boundingBox());
+    auto filtered = stream.collect();
+    EXPECT_EQ(filtered.size(),sampleLayer.size()-100);
+    EXPECT_TRUE(filtered.getSizeField("FISHNET_ID").has_value());
+}
+
+TEST_F(FeatureStreamTest, fileDoesNotExist) {
+    auto result = VectorIO::tryStream<Polygon<double>>(Shapefile(util::PathHelper::projectDirectory() / std::filesystem::path("tests/io/does_not_exist.shp")));
+    EXPECT_FALSE(result.has_value());
+    EXPECT_THROW(VectorIO::stream<Polygon<double>>(Shapefile(util::PathHelper::projectDirectory() / std::filesystem::path("tests/io/does_not_exist.shp"))),std::runtime_error);
+}
+
+TEST_F(FeatureStreamTest, writeIncrementally) {
+    util::AutomaticTemporaryDirectory directory;
+    Shapefile output {directory.get() / std::filesystem::path("Punjab_Small_Copy.shp")};
+    {
+        auto writer = VectorIO::openWriter(sampleLayer,output);
+        for(auto & feature: stream) {
+            writer.write(feature);
+        }
+        EXPECT_EQ(writer.size(),sampleLayer.size());
+        writer.close();
+        EXPECT_THROW(writer.write(sampleLayer.getFeatures().front()),std::runtime_error);
+    }
+    auto written = VectorIO::read<Polygon<double>>(output);
+    EXPECT_EQ(written.size(),sampleLayer.size());
+    EXPECT_TRUE(written.getSpatialReference().IsSame(&sampleLayer.getSpatialReference()));
+    EXPECT_UNSORTED_RANGE_EQ(written.getGeometries(),sampleLayer.getGeometries());
+    auto idField = written.getSizeField("FISHNET_ID");
+    ASSERT_TRUE(idField.has_value());
+    std::vector<size_t> writtenIds;
+    for(const auto & feature: written.getFeatures()) {
+        writtenIds.push_back(feature.getAttribute(idField.value()).value());
+    }
+    EXPECT_UNSORTED_RANGE_EQ(writtenIds,ids(stream));
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <fishnet/GISConverter.hpp>
+#include <fishnet/VectorIO.hpp>
+#include <fishnet/MultiPolygon.hpp>
+#include <fishnet/PathHelper.h>
+#include <fishnet/TemporaryDirectiory.h>
+#include <gdal/gdal_priv.h>
+#include <ogrsf_frmts.h>
+#include "Testutil.h"
+
+using namespace fishnet;
+using namespace fishnet::geometry;
+using namespace testutil;
+
+class GISConverterTest: public ::testing::Test {
+protected:
+    GeoTiff sample {util::PathHelper::projectDirectory() / std::filesystem::path("data/testing/Wuerzburg/Wuerzburg_DE.tiff")};
+    util::AutomaticTemporaryDirectory directory;
+
+    Shapefile destination(const std::string & name) {
+        return Shapefile(directory.get() / std::filesystem::path(name + ".shp"));
+    }
+
+    /**
+     * @brief Pixel value and area of each polygon, sorted
+     */
+    static std::vector<std::pair<int,double>> polygonAreas(const Shapefile & shapefile) {
+        auto layer = VectorIO::read<MultiPolygon<Polygon<double>>>(shapefile);
+        auto pixelValue = layer.getIntegerField("pixel_val").value();
+        std::vector<std::pair<int,double>> result;
+        for(const auto & feature: layer.getFeatures()) {
+            result.emplace_back(int(feature.getAttribute(pixelValue).value()),feature.getGeometry().area());
+        }
+        std::ranges::sort(result);
+        return result;
+    }
+
+    /**
+     * @brief Pixel value, geometry type and the sorted vertices of all rings of each polygon, sorted
+     */
+    static std::vector<std::tuple<int,OGRwkbGeometryType,std::vector<std::pair<double,double>>>> polygonVertices(const Shapefile & shapefile) {
+        GDALDatasetUniquePtr dataset {GDALDataset::Open(shapefile.getPath().c_str(),GDAL_OF_VECTOR | GDAL_OF_READONLY)};
+        std::vector<std::tuple<int,OGRwkbGeometryType,std::vector<std::pair<double,double>>>> result;
+        if(not dataset)
+            return result;
+        OGRLayer * layer = dataset->GetLayer(0);
+        int pixelValue = layer->GetLayerDefn()->GetFieldIndex("pixel_val");
+        for(auto & feature: layer) {
+            const OGRGeometry * geometry = feature->GetGeometryRef();
+            std::vector<std::pair<double,double>> vertices;
+            auto addRing = [&vertices](const OGRLinearRing * ring){
+                for(int i = 0; i+1 < ring->getNumPoints(); ++i) // closed ring, last point equals the first point
+                    vertices.emplace_back(ring->getX(i),ring->getY(i));
+            };
+            if(wkbFlatten(geometry->getGeometryType()) == wkbPolygon) {
+                for(const auto * ring: *geometry->toPolygon())
+                    addRing(ring);
+            } else if(wkbFlatten(geometry->getGeometryType()) == wkbMultiPolygon) {
+                for(const auto * polygon: *geometry->toMultiPolygon())
+                    for(const auto * ring: *polygon)
+                        addRing(ring);
+            }
+            std::ranges::sort(vertices);
+            result.emplace_back(feature->GetFieldAsInteger(pixelValue),wkbFlatten(geometry->getGeometryType()),std::move(vertices));
+        }
+        std::ranges::sort(result);
+        return result;
+    }
+
+    void expectSamePolygons(const Shapefile & expected, const Shapefile & actual) {
+        auto expectedAreas = polygonAreas(expected);
+        auto actualAreas = polygonAreas(actual);
+        ASSERT_EQ(expectedAreas.size(),actualAreas.size());
+        for(size_t i = 0; i < expectedAreas.size(); ++i) {
+            EXPECT_EQ(expectedAreas[i].first,actualAreas[i].first);
+            EXPECT_NEAR(expectedAreas[i].second,actualAreas[i].second,1e-9 * std::max(1.0,expectedAreas[i].second));
+        }
+        auto expectedVertices = polygonVertices(expected);
+        auto actualVertices = polygonVertices(actual);
+        ASSERT_EQ(expectedVertices.size(),actualVertices.size());
+        for(size_t i = 0; i < expectedVertices.size(); ++i) {
+            const auto & [expectedValue,expectedType,expectedPoints] = expectedVertices[i];
+            const auto & [actualValue,actualType,actualPoints] = actualVertices[i];
+            EXPECT_EQ(expectedValue,actualValue);
+            EXPECT_EQ(expectedType,actualType);
+            ASSERT_EQ(expectedPoints.size(),actualPoints.size());
+            for(size_t j = 0; j < expectedPoints.size(); ++j) {
+                EXPECT_DOUBLE_EQ(expectedPoints[j].first,actualPoints[j].first);
+                EXPECT_DOUBLE_EQ(expectedPoints[j].second,actualPoints[j].second);
+            }
+        }
+    }
+};
+
+TEST_F(GISConverterTest, tiledEqualsSequential) {
+    auto sequential = GISConverter::convertSequential(sample,destination("sequential"));
+    ASSERT_TRUE(sequential.has_value());
+    for(size_t tileRows: {1,7,64,100000}) {
+        auto tiled = GISConverter::convert(sample,destination("tiled_"+std::to_string(tileRows)),true,false,tileRows,4);
+        ASSERT_TRUE(tiled.has_value());
+        expectSamePolygons(sequential.value(),tiled.value());
+    }
+}
+
+TEST_F(GISConverterTest, tiledEqualsSequentialWithoutMask) {
+    auto sequential = GISConverter::convertSequential(sample,destination("sequential"),false);
+    ASSERT_TRUE(sequential.has_value());
+    auto tiled = GISConverter::convert(sample,destination("tiled"),false,false,16,4);
+    ASSERT_TRUE(tiled.has_value());
+    expectSamePolygons(sequential.value(),tiled.value());
+}
+
+TEST_F(GISConverterTest, diagonalCornerAcrossSeam) {
+    GeoTiff raster {directory.get() / std::filesystem::path("diagonal.tiff")};
+    {
+        GDALAllRegister();
+        GDALDatasetUniquePtr dataset {GetGDALDriverManager()->GetDriverByName("GTiff")->Create(raster.getPath().c_str(),4,4,1,GDT_Byte,nullptr)};
+        ASSERT_TRUE(dataset);
+        std::array<GByte,16> pixels {
+            1,0,0,1,
+            0,1,1,0,
+            0,1,1,0,
+            1,0,0,1
+        }; // the corners touch the center only diagonally, across each seam for one row per tile
+        ASSERT_EQ(dataset->GetRasterBand(1)->RasterIO(GF_Write,0,0,4,4,pixels.data(),4,4,GDT_Byte,0,0,nullptr),CE_None);
+    }
+    auto sequential = GISConverter::convertSequential(raster,destination("diagonal_sequential"));
+    ASSERT_TRUE(sequential.has_value());
+    for(size_t tileRows: {1,2,3}) {
+        auto tiled = GISConverter::convert(raster,destination("diagonal_tiled_"+std::to_string(tileRows)),true,false,tileRows,2);
+        ASSERT_TRUE(tiled.has_value());
+        expectSamePolygons(sequential.value(),tiled.value());
+    }
+}
+
+TEST_F(GISConverterTest, windowBudgetMergesTiles) {
+    for(bool maskZero: {true,false}) {
+        auto sequential = GISConverter::convertSequential(sample,destination("sequential_"+std::to_string(maskZero)),maskZero);
+        ASSERT_TRUE(sequential.has_value());
+        // every window spans at least two tiles and exceeds the budget, hence all polygons across seams are merged from their tiles
+        auto tiled = GISConverter::convert(sample,destination("merged_"+std::to_string(maskZero)),maskZero,false,16,4,16);
+        ASSERT_TRUE(tiled.has_value());
+        auto expectedAreas = polygonAreas(sequential.value());
+        auto actualAreas = polygonAreas(tiled.value());
+        ASSERT_EQ(expectedAreas.size(),actualAreas.size());
+        for(size_t i = 0; i < expectedAreas.size(); ++i) {
+            EXPECT_EQ(expectedAreas[i].first,actualAreas[i].first);
+            EXPECT_NEAR(expectedAreas[i].second,actualAreas[i].second,1e-9 * std::max(1.0,expectedAreas[i].second));
+        }
+    }
+}
+
+TEST_F(GISConverterTest, fileDoesNotExist) {
+    GeoTiff missing {directory.get() / std::filesystem::path("does_not_exist.tiff")};
+    EXPECT_FALSE(GISConverter::convert(missing,destination("missing")).has_value());
+    EXPECT_FALSE(GISConverter::convertSequential(missing,destination("missing")).has_value());
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <limits>
+#include <fishnet/GeometryCacheIO.hpp>
+#include <fishnet/VectorIO.hpp>
+#include <fishnet/PathHelper.h>
+#include <fishnet/TemporaryDirectiory.h>
+#include "Testutil.h"
+
+using namespace fishnet;
+using namespace fishnet::geometry;
+using namespace testutil;
+
+class GeometryCacheTest: public ::testing::Test {
+protected:
+    Shapefile sample {util::PathHelper::projectDirectory() / std::filesystem::path("data/testing/Punjab_Small/Punjab_Small.shp")};
+    VectorLayer<Polygon<double>> sampleLayer = VectorIO::read<Polygon<double>>(sample);
+    util::AutomaticTemporaryDirectory directory;
+    GeometryCache cache {directory.get() / std::filesystem::path("Punjab_Small.fgc")};
+};
+
+TEST_F(GeometryCacheTest, roundTrip) {
+    VectorIO::overwrite(GeometryCacheWriter<Polygon<double>>("FISHNET_ID"),sampleLayer,cache);
+    EXPECT_TRUE(cache.exists());
+    auto layer = VectorIO::read<Polygon<double>>(cache);
+    EXPECT_EQ(layer.size(),sampleLayer.size());
+    EXPECT_TRUE(layer.getSpatialReference().IsSame(&sampleLayer.getSpatialReference()));
+    EXPECT_UNSORTED_RANGE_EQ(layer.getGeometries(),sampleLayer.getGeometries());
+    auto expectedIdField = sampleLayer.getSizeField("FISHNET_ID").value();
+    auto idField = layer.getSizeField("FISHNET_ID");
+    ASSERT_TRUE(idField.has_value());
+    auto expectedFeatures = sampleLayer.getFeatures();
+    auto features = layer.getFeatures();
+    for(size_t i = 0; i < layer.size(); ++i) {
+        EXPECT_EQ(features[i].getGeometry(),expectedFeatures[i].getGeometry());
+        EXPECT_DOUBLE_EQ(features[i].getGeometry().area(),expectedFeatures[i].getGeometry().area());
+        EXPECT_EQ(features[i].getAttribute(idField.value()),expectedFeatures[i].getAttribute(expectedIdField));
+    }
+}
+
+TEST_F(GeometryCacheTest, mappedView) {
+    VectorIO::overwrite(GeometryCacheWriter<Polygon<double>>("FISHNET_ID"),sampleLayer,cache);
+    auto mapped = MappedGeometryCache::open(cache);
+    ASSERT_TRUE(mapped.has_value());
+    const auto & view = mapped.value();
+    EXPECT_EQ(view.size(),sampleLayer.size());
+    EXPECT_EQ(view.geometryType(),GeometryType::POLYGON);
+    EXPECT_EQ(view.xCoordinates().size(),view.yCoordinates().size());
+    EXPECT_EQ(view.ringPointOffsets().back(),view.xCoordinates().size());
+    auto idField = sampleLayer.getSizeField("FISHNET_ID").value();
+    auto features = sampleLayer.getFeatures();
+    for(size_t i = 0; i < view.size(); ++i) {
+        const auto & polygon = features[i].getGeometry();
+        Rectangle<double> expectedBox {polygon};
+        auto box = view.boundingBox(i);
+        EXPECT_DOUBLE_EQ(box.left(),expectedBox.left());
+        EXPECT_DOUBLE_EQ(box.right(),expectedBox.right());
+        EXPECT_DOUBLE_EQ(box.top(),expectedBox.top());
+        EXPECT_DOUBLE_EQ(box.bottom(),expectedBox.bottom());
+        EXPECT_EQ(view.featureIds()[i],features[i].getAttribute(idField).value());
+        EXPECT_EQ(view.geometry<Polygon<double>>(i),polygon);
+    }
+}
+
+TEST_F(GeometryCacheTest, multiPolygons) {
+    VectorLayer<MultiPolygon<Polygon<double>>> multiLayer {sampleLayer.getSpatialReference()};
+    auto geometries = sampleLayer.getGeometries();
+    std::vector<Polygon<double>> polygons {geometries.begin(),geometries.end()};
+    multiLayer.addGeometry(MultiPolygon<Polygon<double>>(polygons,true));
+    multiLayer.addGeometry(MultiPolygon<Polygon<double>>(polygons.front()));
+    VectorIO::overwrite(multiLayer,cache);
+    auto layer = VectorIO::read<MultiPolygon<Polygon<double>>>(cache);
+    EXPECT_UNSORTED_RANGE_EQ(layer.getGeometries(),multiLayer.getGeometries());
+    auto polygonLayer = VectorIO::read<Polygon<double>>(cache); // only features consisting of a single polygon
+    ASSERT_EQ(polygonLayer.size(),1);
+    EXPECT_EQ(polygonLayer.getGeometries().front(),polygons.front());
+    auto mapped = MappedGeometryCache::open(cache);
+    ASSERT_TRUE(mapped.has_value());
+    EXPECT_EQ(mapped->featureIds()[1],1);
+    EXPECT_EQ(mapped->featurePolygonOffsets()[1],polygons.size());
+}
+
+TEST_F(GeometryCacheTest, readByExtension) {
+    auto path = VectorIO::overwrite(sampleLayer,cache.getPath());
+    EXPECT_EQ(path,cache.getPath());
+    EXPECT_EQ(VectorIO::read<Polygon<double>>(path).size(),sampleLayer.size());
+    EXPECT_EQ(VectorIO::read<Polygon<double>>(sample.getPath()).size(),sampleLayer.size());
+    EXPECT_FALSE(VectorIO::tryRead<Polygon<double>>(directory.get() / std::filesystem::path("Punjab_Small.gpkg")).has_value());
+}
+
+TEST_F(GeometryCacheTest, invalidFile) {
+    EXPECT_FALSE(VectorIO::tryRead(GeometryCacheReader<Polygon<double>>(),cache).has_value());
+    std::ofstream(cache.getPath()) << "not a geometry cache";
+    EXPECT_FALSE(MappedGeometryCache::open(cache).has_value());
+    EXPECT_THROW(VectorIO::read<Polygon<double>>(cache),std::runtime_error);
+}
+
+TEST_F(GeometryCacheTest, polygonWithoutRings) {
+    VectorIO::overwrite(sampleLayer,cache);
+    __impl::geometry_cache::Header header;
+    std::fstream file {cache.getPath(),std::ios::in | std::ios::out | std::ios::binary};
+    file.read(reinterpret_cast<char *>(&header),sizeof(header));
+    ASSERT_TRUE(file.good());
+    ASSERT_GT(header.polygonCount,1u);
+    uint64_t firstRing = 0;
+    file.seekp(std::streamoff(header.polygonRings + sizeof(uint64_t)));
+    file.write(reinterpret_cast<const char *>(&firstRing),sizeof(firstRing)); // first polygon has no rings
+    file.close();
+    EXPECT_FALSE(MappedGeometryCache::open(cache).has_value());
+    EXPECT_THROW(VectorIO::read<Polygon<double>>(cache),std::runtime_error);
+}
+
+TEST_F(GeometryCacheTest, countOverflow) {
+    VectorIO::overwrite(sampleLayer,cache);
+    __impl::geometry_cache::Header header;
+    std::fstream file {cache.getPath(),std::ios::in | std::ios::out | std::ios::binary};
+    file.read(reinterpret_cast<char *>(&header),sizeof(header));
+    ASSERT_TRUE(file.good());
+    uint64_t lastPolygon = std::numeric_limits<uint64_t>::max();
+    file.seekp(std::streamoff(header.featurePolygons + header.featureCount * sizeof(uint64_t)));
+    file.write(reinterpret_cast<const char *>(&lastPolygon),sizeof(lastPolygon)); // last feature ends at polygon UINT64_MAX
+    header.polygonCount = std::numeric_limits<uint64_t>::max(); // polygonCount+1 wraps to 0
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header),sizeof(header));
+    file.close();
+    EXPECT_FALSE(MappedGeometryCache::open(cache).has_value());
+    EXPECT_THROW(VectorIO::read<Polygon<double>>(cache),std::runtime_error);
+}
+
+TEST_F(GeometryCacheTest, ringWithTwoPoints) {
+    VectorIO::overwrite(sampleLayer,cache);
+    __impl::geometry_cache::Header header;
+    std::fstream file {cache.getPath(),std::ios::in | std::ios::out | std::ios::binary};
+    file.read(reinterpret_cast<char *>(&header),sizeof(header));
+    ASSERT_TRUE(file.good());
+    ASSERT_GT(header.ringCount,1u);
+    uint64_t secondRing = 2;
+    file.seekp(std::streamoff(header.ringPoints + sizeof(uint64_t)));
+    file.write(reinterpret_cast<const char *>(&secondRing),sizeof(secondRing)); // first ring has two points
+    file.close();
+    EXPECT_FALSE(MappedGeometryCache::open(cache).has_value());
+    EXPECT_THROW(VectorIO::read<Polygon<double>>(cache),std::runtime_error);
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <fishnet/WGS84Ellipsoid.hpp>
+#include <fishnet/CoordinateTransformationCache.hpp>
+#include <thread>
+#include <random>
 #include <fishnet/Rectangle.hpp>
 #include <fishnet/VectorLayer.hpp>
 #include <fishnet/PathHelper.h>
@@ -39,6 +42,179 @@ TEST(WGS84EllipsoidTest, TokioBerlinApprox){
     EXPECT_DOUBLE_EQ(WGS84Ellipsoid::distance(lambdaBerlin,phiBerlin,lambdaTokio,phiTokio, false),distanceTokioBerlinInMeters);
 }
 
+static std::vector<Vec2DReal> randomLonLatPoints(size_t count, double maxLatitude = 85, unsigned seed = 42) {
+    std::mt19937 generator {seed};
+    std::uniform_real_distribution<double> longitude {-180,180};
+    std::uniform_real_distribution<double> latitude {-maxLatitude,maxLatitude};
+    std::vector<Vec2DReal> points;
+    for(size_t i = 0; i < count; ++i) {
+        double lon = longitude(generator);
+        points.emplace_back(lon,latitude(generator));
+    }
+    return points;
+}
+
+/**
+ * @brief Pairs of points at most maxDistance meters apart (approximately), around random points
+ */
+static std::vector<std::pair<Vec2DReal,Vec2DReal>> randomClosePairs(size_t count, double maxDistance, double maxLatitude = 85, unsigned seed = 42) {
+    std::mt19937 generator {seed};
+    std::uniform_real_distribution<double> unit {0,1};
+    std::vector<std::pair<Vec2DReal,Vec2DReal>> pairs;
+    for(const auto & p: randomLonLatPoints(count,maxLatitude,seed)) {
+        double distanceInDegrees = maxDistance * unit(generator) / 111000;
+        double azimuth = 2 * math::PI * unit(generator);
+        double latitude = std::clamp(p.y + distanceInDegrees * std::cos(azimuth),-maxLatitude,maxLatitude);
+        pairs.emplace_back(p,Vec2DReal(p.x + distanceInDegrees * std::sin(azimuth) / std::cos(p.y * math::PI / 180),latitude));
+    }
+    return pairs;
+}
+
+TEST(WGS84EllipsoidTest, BatchedDistances){
+    auto points = randomLonLatPoints(1003);
+    Vec2DReal berlin {13.4,52.516666666666667};
+    points.push_back(berlin);
+    points.emplace_back(139.76666666666667,35.7);
+    for(bool exact: {true,false}) {
+        auto distances = WGS84Ellipsoid::distances(berlin,points,exact);
+        ASSERT_EQ(distances.size(),points.size());
+        for(size_t i = 0; i < points.size()-2; ++i) {
+            double expected = WGS84Ellipsoid::distance(berlin,points[i],exact);
+            EXPECT_NEAR(distances[i],expected,1e-9*expected);
+        }
+        EXPECT_EQ(distances[points.size()-2],0);
+        EXPECT_NEAR(distances.back(),WGS84Ellipsoid::distance(berlin,points.back(),exact),1e-3);
+    }
+    EXPECT_TRUE(WGS84Ellipsoid::distances(berlin,std::vector<Vec2DReal>()).empty());
+}
+
+TEST(WGS84EllipsoidTest, BatchedDistancesShortRange){
+    for(const auto & [p,q]: randomClosePairs(1000,5000)) {
+        if(p == q)
+            continue;
+        double expected = WGS84Ellipsoid::distance(p,q);
+        EXPECT_NEAR(WGS84Ellipsoid::distances(p,std::vector{q}).front(),expected,1e-9*expected+1e-6);
+    }
+}
+
+TEST(WGS84EllipsoidTest, ScalarAndVectorizedKernel){
+    auto points = randomLonLatPoints(4099,89);
+    WGS84PointCache cache {points};
+    ASSERT_EQ(cache.size(),points.size());
+    WGS84PointCache::HalfAngles origin {-71.06,42.36};
+    for(bool exact: {true,false}) {
+        std::vector<double> scalar(cache.size());
+        std::vector<double> vectorized(cache.size());
+        fishnet::__impl::wgs84::distances(origin,cache,scalar.data(),WGS84Ellipsoid::radiusInMeter,WGS84Ellipsoid::flattening,exact,false);
+        fishnet::__impl::wgs84::distances(origin,cache,vectorized.data(),WGS84Ellipsoid::radiusInMeter,WGS84Ellipsoid::flattening,exact,true);
+        for(size_t i = 0; i < points.size(); ++i) {
+            EXPECT_NEAR(vectorized[i],scalar[i],1e-12*scalar[i]);
+        }
+    }
+}
+
+TEST(WGS84EllipsoidTest, LocalTangentPlaneDistance){
+    for(double maxDistance: {100.0,10000.0,100000.0}) {
+        for(const auto & [p,q]: randomClosePairs(2000,maxDistance,89)) {
+            if(p == q)
+                continue;
+            double expected = WGS84Ellipsoid::distance(p,q);
+            double approximation = WGS84Ellipsoid::localTangentPlaneDistance(p,q);
+            double bound = WGS84Ellipsoid::localTangentPlaneRelativeError(approximation,std::max(std::abs(p.y),std::abs(q.y)));
+            EXPECT_LE(std::abs(approximation-expected),bound*expected);
+        }
+    }
+    EXPECT_NEAR(WGS84Ellipsoid::localTangentPlaneDistance(Vec2DReal(179.999,0),Vec2DReal(-179.999,0)),WGS84Ellipsoid::distance(179.999,0,-179.999,0),0.01);
+    EXPECT_EQ(WGS84Ellipsoid::localTangentPlaneDistance(Vec2DReal(10,50),Vec2DReal(10,50)),0);
+}
+
+TEST(WGS84EllipsoidTest, WithinDistance){
+    for(const auto & [p,q]: randomClosePairs(5000,3000)) {
+        for(double maxDistance: {500.0,1000.0,2000.0}) {
+            EXPECT_EQ(WGS84Ellipsoid::withinDistance(p,q,maxDistance),WGS84Ellipsoid::distance(p,q) <= maxDistance || p == q);
+        }
+    }
+    Vec2DReal berlin {13.4,52.516666666666667};
+    Vec2DReal tokio {139.76666666666667,35.7};
+    double distance = WGS84Ellipsoid::distance(berlin,tokio);
+    EXPECT_TRUE(WGS84Ellipsoid::withinDistance(berlin,tokio,distance));
+    EXPECT_FALSE(WGS84Ellipsoid::withinDistance(berlin,tokio,distance-1));
+}
+
+TEST(WGS84EllipsoidTest, BatchedWithinDistance){
+    Vec2DReal berlin {13.4,52.516666666666667};
+    std::vector<Vec2DReal> points;
+    for(const auto & [p,q]: randomClosePairs(2000,3000)) {
+        points.push_back(q - p + berlin);
+    }
+    points.push_back(berlin);
+    points.emplace_back(139.76666666666667,35.7); // decided by the exact distance
+    for(double maxDistance: {500.0,1000.0,2000.0,WGS84Ellipsoid::distance(berlin,points.back())}) {
+        auto within = WGS84Ellipsoid::withinDistance(berlin,points,maxDistance);
+        ASSERT_EQ(within.size(),points.size());
+        for(size_t i = 0; i < points.size(); ++i) {
+            EXPECT_EQ(within[i],WGS84Ellipsoid::withinDistance(berlin,points[i],maxDistance)) << i;
+        }
+    }
+    EXPECT_TRUE(WGS84Ellipsoid::withinDistance(berlin,std::vector<Vec2DReal>(),1000).empty());
+}
+
+static Ring<double> box(Vec2DReal lowerLeft, double size) {
+    return Ring<double>(std::vector<Vec2DReal>{lowerLeft,{lowerLeft.x+size,lowerLeft.y},{lowerLeft.x+size,lowerLeft.y+size},{lowerLeft.x,lowerLeft.y+size}});
+}
+
+TEST(WGS84EllipsoidTest, ProjectedArea){
+    double expectedArea = 1.235e6; // 0.01° x 0.01° at the equator, approx. 1113m x 1110m
+    EXPECT_NEAR(WGS84Ellipsoid::area(box({0,0},0.01)),expectedArea,0.015*expectedArea);
+    EXPECT_NEAR(WGS84Ellipsoid::area(box({120,0},0.01)),expectedArea,0.015*expectedArea);
+    EXPECT_LT(WGS84Ellipsoid::area(box({10,50},0.01)),WGS84Ellipsoid::area(box({10,0},0.01)));
+}
+
+TEST(WGS84EllipsoidTest, ProjectedAreaWithHoles){
+    Polygon<double> polygon {box({10,50},0.02),std::vector<Ring<double>>{box({10.005,50.005},0.01)}};
+    double expected = WGS84Ellipsoid::area(polygon.getBoundary()) - WGS84Ellipsoid::area(box({10.005,50.005},0.01));
+    EXPECT_NEAR(WGS84Ellipsoid::area(polygon),expected,1e-6*expected);
+    EXPECT_NEAR(WGS84Ellipsoid::area(polygon),0.75*WGS84Ellipsoid::area(polygon.getBoundary()),0.01*expected);
+}
+
+TEST(WGS84EllipsoidTest, BatchedAreas){
+    std::vector<Ring<double>> rings;
+    for(double lon = -170; lon < 180; lon += 25.3) {
+        rings.push_back(box({lon,lon/4},0.01));
+    }
+    auto areas = WGS84Ellipsoid::areas(rings);
+    ASSERT_EQ(areas.size(),rings.size());
+    for(size_t i = 0; i < rings.size(); ++i) {
+        EXPECT_NEAR(areas[i],WGS84Ellipsoid::area(rings[i]),1e-6*areas[i]);
+    }
+    std::vector<Polygon<double>> polygons;
+    for(const auto & ring: rings) {
+        polygons.emplace_back(ring);
+    }
+    EXPECT_EQ(WGS84Ellipsoid::areas(polygons),areas);
+    EXPECT_TRUE(WGS84Ellipsoid::areas(std::vector<Ring<double>>()).empty());
+}
+
+TEST(WGS84EllipsoidTest, TransformationCache){
+    auto & cache = CoordinateTransformationCache::threadLocal();
+    WGS84Ellipsoid::area(box({33.2,10},0.01));
+    size_t cached = cache.size();
+    WGS84Ellipsoid::areas(std::vector<Ring<double>>{box({32.9,11},0.01),box({33.1,-5},0.01)});
+    EXPECT_EQ(cache.size(),cached);
+    size_t otherThreadCacheSize = 1;
+    std::thread([&otherThreadCacheSize](){otherThreadCacheSize = CoordinateTransformationCache::threadLocal().size();}).join();
+    EXPECT_EQ(otherThreadCacheSize,0);
+}
+
+TEST(WGS84EllipsoidTest, ClearTransformationCache){
+    auto & cache = CoordinateTransformationCache::threadLocal();
+    double area = WGS84Ellipsoid::area(box({12.4,48},0.01));
+    cache.clear();
+    EXPECT_EQ(cache.size(),0);
+    EXPECT_DOUBLE_EQ(WGS84Ellipsoid::area(box({12.4,48},0.01)),area); // transformation is created again after clearing the cache
+    EXPECT_EQ(cache.size(),1);
+}
+
 /* TEST(WGS84EllipsoidTest, SquareKilometerArea){
     auto layer = fishnet::VectorLayer<geometry::Polygon<double>>::read({util::PathHelper::projectDirectory() / std::filesystem::path("data/testing/Punjab_Small/Punjab_Small.shp")});
     geometry::Polygon<double> min = {Ring(std::vector<Vec2DReal>{{100.0,0.0},{100.0,100.0},{0.0,0.0}})};
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <fishnet/IntervalTree.hpp>
+
+using namespace fishnet::util;
+
+TEST(IntervalTreeTest, empty) {
+    IntervalTree<double> tree {std::vector<std::pair<double,double>>()};
+    EXPECT_EQ(tree.size(),0);
+    EXPECT_TRUE(tree.activeOverlapping(0,10).empty());
+    EXPECT_THROW(tree.activate(0),std::out_of_range);
+}
+
+TEST(IntervalTreeTest, activation) {
+    std::vector<std::pair<int,int>> intervals {{0,2},{5,7},{1,3},{8,9}};
+    IntervalTree<int> tree {intervals};
+    EXPECT_EQ(tree.size(),4);
+    EXPECT_TRUE(tree.activeOverlapping(0,10).empty());
+    tree.activate(0);
+    tree.activate(2);
+    tree.activate(2);
+    EXPECT_EQ(tree.activeSize(),2);
+    EXPECT_TRUE(tree.isActive(2));
+    EXPECT_FALSE(tree.isActive(1));
+    EXPECT_EQ(tree.activeOverlapping(0,10),std::vector<size_t>({0,2}));
+    EXPECT_EQ(tree.activeOverlapping(3,4),std::vector<size_t>({2})); // closed intervals
+    EXPECT_TRUE(tree.activeOverlapping(4,10).empty());
+    tree.activate(1);
+    tree.deactivate(0);
+    EXPECT_EQ(tree.activeOverlapping(0,6),std::vector<size_t>({2,1}));
+    EXPECT_EQ(tree.activeOverlapping(2,2),std::vector<size_t>({2}));
+}
+
+TEST(IntervalTreeTest, stopEarly) {
+    std::vector<std::pair<int,int>> intervals {{0,10},{1,10},{2,10}};
+    IntervalTree<int> tree {intervals};
+    for(size_t i = 0; i < intervals.size(); ++i)
+        tree.activate(i);
+    size_t visited = 0;
+    EXPECT_FALSE(tree.forEachActiveOverlapping(5,5,[&visited](size_t){return ++visited < 2;}));
+    EXPECT_EQ(visited,2);
+}
+
+TEST(IntervalTreeTest, matchesBruteForce) {
+    std::default_random_engine re;
+    std::uniform_real_distribution<double> position {0,1000};
+    std::uniform_real_distribution<double> length {0,50};
+    std::vector<std::pair<double,double>> intervals;
+    for(int i = 0; i < 500; ++i) {
+        double low = position(re);
+        intervals.emplace_back(low,low+length(re));
+    }
+    IntervalTree<double> tree {intervals};
+    std::vector<bool> active(intervals.size(),false);
+    std::uniform_int_distribution<size_t> index {0,intervals.size()-1};
+    for(int step = 0; step < 2000; ++step) {
+        size_t i = index(re);
+        active[i] = not active[i];
+        active[i] ? tree.activate(i) : tree.deactivate(i);
+        double low = position(re);
+        double high = low + length(re);
+        auto result = tree.activeOverlapping(low,high);
+        std::ranges::sort(result);
+        std::vector<size_t> expected;
+        for(size_t j = 0; j < intervals.size(); ++j) {
+            if(active[j] && intervals[j].first <= high && low <= intervals[j].second)
+                expected.push_back(j);
+        }
+        ASSERT_EQ(result,expected);
+    }
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <numeric>
+#include <fishnet/MPMCQueue.hpp>
+
+using namespace fishnet::util;
+
+TEST(MPMCQueueTest, capacity) {
+    EXPECT_EQ(MPMCQueue<int>(0).capacity(),2);
+    EXPECT_EQ(MPMCQueue<int>(5).capacity(),8);
+    EXPECT_EQ(MPMCQueue<int>(1024).capacity(),1024);
+}
+
+TEST(MPMCQueueTest, fifo) {
+    MPMCQueue<int> queue {4};
+    EXPECT_FALSE(queue.tryTake().has_value());
+    for(int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPut(i));
+    }
+    EXPECT_FALSE(queue.tryPut(4));
+    EXPECT_EQ(queue.size(),4);
+    for(int i = 0; i < 4; ++i) {
+        EXPECT_EQ(queue.tryTake(),i);
+    }
+    EXPECT_FALSE(queue.tryTake().has_value());
+    EXPECT_EQ(queue.size(),0);
+}
+
+TEST(MPMCQueueTest, moveOnly) {
+    MPMCQueue<std::unique_ptr<int>> queue {8};
+    queue.put(std::make_unique<int>(42));
+    std::vector<std::unique_ptr<int>> values;
+    values.push_back(std::make_unique<int>(1));
+    values.push_back(std::make_unique<int>(2));
+    queue.putBatch(std::move(values));
+    queue.close();
+    std::vector<std::unique_ptr<int>> result;
+    EXPECT_EQ(queue.takeBatch(std::back_inserter(result),10),3);
+    EXPECT_EQ(*result[0],42);
+    EXPECT_EQ(*result[2],2);
+    EXPECT_EQ(queue.takeBatch(std::back_inserter(result),10),0);
+}
+
+TEST(MPMCQueueTest, close) {
+    MPMCQueue<int> queue {8};
+    queue.put(1);
+    queue.close();
+    EXPECT_TRUE(queue.isClosed());
+    EXPECT_THROW(queue.put(2),std::runtime_error);
+    EXPECT_EQ(queue.take(),1);
+    EXPECT_FALSE(queue.take().has_value());
+}
+
+TEST(MPMCQueueTest, destroysRemainingElements) {
+    auto shared = std::make_shared<int>(0);
+    {
+        MPMCQueue<std::shared_ptr<int>> queue {4};
+        queue.put(shared);
+        queue.put(shared);
+        EXPECT_EQ(shared.use_count(),3);
+    }
+    EXPECT_EQ(shared.use_count(),1);
+}
+
+TEST(MPMCQueueTest, concurrentProducersAndConsumers) {
+    constexpr int PRODUCERS = 4;
+    constexpr int CONSUMERS = 4;
+    constexpr int VALUES_PER_PRODUCER = 50000;
+    MPMCQueue<int> queue {64};
+    std::vector<std::vector<int>> consumed(CONSUMERS);
+    std::vector<std::thread> consumers;
+    for(int c = 0; c < CONSUMERS; ++c) {
+        consumers.emplace_back([&queue,&consumed,c]{
+            std::vector<int> batch;
+            while(queue.takeBatch(std::back_inserter(batch),8) > 0) {
+                consumed[c].insert(consumed[c].end(),batch.begin(),batch.end());
+                batch.clear();
+            }
+        });
+    }
+    {
+        std::vector<std::jthread> producers;
+        for(int p = 0; p < PRODUCERS; ++p) {
+            producers.emplace_back([&queue,p]{
+                for(int i = 0; i < VALUES_PER_PRODUCER; ++i) {
+                    queue.put(p*VALUES_PER_PRODUCER + i);
+                }
+            });
+        }
+    }
+    queue.close();
+    for(auto & consumer: consumers) {
+        consumer.join();
+    }
+    std::vector<int> all;
+    for(const auto & values: consumed) {
+        all.insert(all.end(),values.begin(),values.end());
+    }
+    std::ranges::sort(all);
+    std::vector<int> expected(PRODUCERS*VALUES_PER_PRODUCER);
+    std::iota(expected.begin(),expected.end(),0);
+    EXPECT_EQ(all,expected);
+}
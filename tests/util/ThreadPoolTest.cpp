@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include <fishnet/ThreadPool.hpp>
+#include <fishnet/WorkStealingThreadPool.hpp>
+
+using namespace fishnet::util;
+
+TEST(ThreadPoolTest, submitAndJoin) {
+    std::atomic_int counter = 0;
+    ThreadPool pool {4};
+    for(int i = 0; i < 10000; ++i) {
+        pool.submit([&counter]{counter++;});
+    }
+    pool.join();
+    EXPECT_EQ(counter,10000);
+    pool.join();
+}
+
+TEST(ThreadPoolTest, zeroThreads) {
+    std::atomic_int counter = 0;
+    ThreadPool pool {0};
+    EXPECT_EQ(pool.size(),1);
+    pool.submit([&counter]{counter++;});
+    pool.join();
+    EXPECT_EQ(counter,1);
+}
+
+TEST(ThreadPoolTest, nestedSubmit) {
+    std::atomic_int counter = 0;
+    {
+        WorkStealingThreadPool pool {4};
+        for(int i = 0; i < 100; ++i) {
+            pool.submit([&pool,&counter]{
+                for(int j = 0; j < 100; ++j) {
+                    pool.submit([&counter]{counter++;});
+                }
+            });
+        }
+    }
+    EXPECT_EQ(counter,10000);
+}
+
+TEST(ThreadPoolTest, futures) {
+    WorkStealingThreadPool pool {4};
+    std::vector<std::future<int>> futures;
+    for(int i = 0; i < 100; ++i) {
+        futures.push_back(pool.async([i]{return i*i;}));
+    }
+    for(int i = 0; i < 100; ++i) {
+        EXPECT_EQ(futures[i].get(),i*i);
+    }
+    auto failed = pool.async([]()->int{throw std::runtime_error("failed");});
+    EXPECT_THROW(failed.get(),std::runtime_error);
+}
+
+TEST(ThreadPoolTest, parallelFor) {
+    WorkStealingThreadPool pool {4};
+    std::vector<int> values(100003,0);
+    pool.parallelFor(0,values.size(),[&values](size_t i){values[i] = int(i % 7);});
+    for(size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(values[i],int(i % 7));
+    }
+    for(size_t chunkSize: {1,3,1000,1000000}) {
+        std::vector<std::atomic_int> visits(1000);
+        pool.parallelFor(10,1000,[&visits](size_t i){visits[i]++;},chunkSize);
+        for(size_t i = 0; i < visits.size(); ++i) {
+            ASSERT_EQ(visits[i],i < 10 ? 0 : 1);
+        }
+    }
+    pool.parallelFor(5,5,[](size_t){FAIL();});
+    EXPECT_THROW(pool.parallelFor(0,100,[](size_t i){if(i==42) throw std::runtime_error("failed");}),std::runtime_error);
+}
+
+TEST(ThreadPoolTest, nestedParallelFor) {
+    WorkStealingThreadPool pool {2};
+    std::atomic_size_t sum = 0;
+    pool.parallelFor(0,100,[&pool,&sum](size_t i){
+        pool.parallelFor(0,100,[&sum,i](size_t j){sum+=i*j;},1);
+    },1);
+    EXPECT_EQ(sum,size_t(4950*4950));
+}
+
+TEST(ThreadPoolTest, taskGroup) {
+    WorkStealingThreadPool pool {4};
+    WorkStealingThreadPool::TaskGroup group {pool};
+    std::atomic_int counter = 0;
+    for(int i = 0; i < 1000; ++i) {
+        group.run([&counter]{counter++;});
+    }
+    group.wait();
+    EXPECT_EQ(counter,1000);
+    group.run([]{throw std::runtime_error("failed");});
+    group.run([&counter]{counter++;});
+    EXPECT_THROW(group.wait(),std::runtime_error);
+    EXPECT_EQ(counter,1001);
+    group.run([&counter]{counter++;});
+    EXPECT_NO_THROW(group.wait());
+    EXPECT_EQ(counter,1002);
+}
+
+TEST(ThreadPoolTest, currentPool) {
+    EXPECT_EQ(WorkStealingThreadPool::current(),nullptr);
+    ThreadPool pool {1};
+    auto future = pool.async([]{
+        auto * current = WorkStealingThreadPool::current();
+        std::atomic_size_t sum = 0;
+        current->parallelFor(0,100,[&sum](size_t i){sum+=i;},1); // single worker executes the nested tasks while waiting
+        return std::make_pair(current,sum.load());
+    });
+    auto [current,sum] = future.get();
+    EXPECT_EQ(current,&pool);
+    EXPECT_EQ(sum,size_t(4950));
+}
+
+TEST(ThreadPoolTest, taskGroupDestroyedAfterWait) {
+    WorkStealingThreadPool pool {4};
+    std::atomic_int counter = 0;
+    for(int i = 0; i < 10000; ++i) {
+        auto group = std::make_unique<WorkStealingThreadPool::TaskGroup>(pool);
+        group->run([&counter]{counter++;});
+        group->wait();
+        group.reset(); // the finishing task must not touch the group anymore
+    }
+    EXPECT_EQ(counter,10000);
+}
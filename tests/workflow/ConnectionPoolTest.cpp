@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <fishnet/ConnectionPool.hpp>
+#include "Testutil.h"
+
+using namespace testutil;
+
+/**
+ * @brief Transport-free connection, which can be marked as broken to fail the health check
+ */
+struct FakeConnection {
+    size_t id = 0;
+    std::shared_ptr<std::atomic_bool> broken = std::make_shared<std::atomic_bool>(false);
+
+    bool execute(const CipherQuery &) const {
+        return not *broken;
+    }
+
+    bool executeAndDiscard(const CipherQuery & query) const {
+        return execute(query);
+    }
+
+    const FakeConnection & retry() const {
+        return *this;
+    }
+};
+static_assert(CipherConnection<FakeConnection>);
+
+class ConnectionPoolTest: public ::testing::Test {
+protected:
+    ConnectionPool<FakeConnection> makePool(size_t maxSize) {
+        return ConnectionPool<FakeConnection>([this]() -> fishnet::util::Either<FakeConnection,std::string> {
+            if(failingFactory)
+                return std::unexpected("Could not connect");
+            return FakeConnection{.id=created++};
+        },maxSize,[](const FakeConnection & connection){
+            return connection.executeAndDiscard(CipherQuery("RETURN 1"));
+        });
+    }
+    std::atomic_size_t created = 0;
+    bool failingFactory = false;
+};
+
+TEST_F(ConnectionPoolTest, reuseConnection) {
+    auto pool = makePool(4);
+    size_t id;
+    {
+        auto lease = pool.lease();
+        EXPECT_TRUE(lease.isPooled());
+        id = lease->id;
+        EXPECT_EQ(pool.idleCount(),0);
+    }
+    EXPECT_EQ(pool.idleCount(),1);
+    EXPECT_EQ(pool.lease()->id,id);
+    EXPECT_EQ(created,1);
+    EXPECT_EQ(pool.size(),1);
+}
+
+TEST_F(ConnectionPoolTest, bounded) {
+    auto pool = makePool(2);
+    auto first = pool.lease();
+    auto second = pool.lease();
+    EXPECT_NE(first->id,second->id);
+    EXPECT_FALSE(pool.tryLease(std::chrono::milliseconds(10)).has_value());
+    first = std::move(second);
+    auto third = pool.tryLease();
+    ASSERT_TRUE(third.has_value());
+    EXPECT_EQ(pool.size(),2);
+    EXPECT_EQ(created,2);
+}
+
+TEST_F(ConnectionPoolTest, waitForReturnedConnection) {
+    auto pool = makePool(1);
+    auto lease = std::make_optional(pool.lease());
+    std::atomic_bool leased = false;
+    std::thread waiting {[&pool,&leased](){
+        auto other = pool.lease();
+        leased = true;
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(leased);
+    lease.reset();
+    waiting.join();
+    EXPECT_TRUE(leased);
+    EXPECT_EQ(created,1);
+}
+
+TEST_F(ConnectionPoolTest, healthCheckOnBorrow) {
+    auto pool = makePool(1);
+    size_t brokenId;
+    {
+        auto lease = pool.lease();
+        brokenId = lease->id;
+        *lease->broken = true;
+    }
+    auto lease = pool.lease();
+    EXPECT_NE(lease->id,brokenId);
+    EXPECT_EQ(pool.size(),1);
+    EXPECT_EQ(created,2);
+}
+
+TEST_F(ConnectionPoolTest, invalidate) {
+    auto pool = makePool(1);
+    auto lease = pool.lease();
+    lease.invalidate();
+    EXPECT_FALSE(lease.isPooled());
+    EXPECT_EQ(pool.size(),0);
+    EXPECT_TRUE(pool.tryLease().has_value());
+}
+
+TEST_F(ConnectionPoolTest, failingFactory) {
+    auto pool = makePool(1);
+    failingFactory = true;
+    EXPECT_THROW(pool.lease(),std::runtime_error);
+    EXPECT_EQ(pool.size(),0);
+    failingFactory = false;
+    EXPECT_NO_THROW(pool.lease());
+}
+
+TEST_F(ConnectionPoolTest, moveOnlyLease) {
+    static_assert(not std::copy_constructible<ConnectionPool<FakeConnection>::Lease>);
+    static_assert(not std::is_copy_assignable_v<ConnectionPool<FakeConnection>::Lease>);
+    auto pool = makePool(1);
+    auto lease = pool.lease();
+    auto moved = std::move(lease);
+    EXPECT_TRUE(moved.isPooled());
+    EXPECT_FALSE(lease.isPooled());
+    EXPECT_EQ(pool.size(),1);
+}
+
+TEST_F(ConnectionPoolTest, setupOncePerPool) {
+    auto pool = makePool(2);
+    size_t setups = 0;
+    auto setup = [&setups](const FakeConnection &){return ++setups > 1;}; // first setup fails
+    EXPECT_FALSE(pool.lease().setupOnce(setup));
+    auto first = pool.lease();
+    auto second = pool.lease();
+    EXPECT_TRUE(first.setupOnce(setup));
+    EXPECT_TRUE(second.setupOnce(setup));
+    EXPECT_EQ(setups,2);
+    ConnectionPool<FakeConnection>::Lease unpooled {FakeConnection{.id=42}};
+    EXPECT_TRUE(unpooled.setupOnce(setup));
+    EXPECT_TRUE(unpooled.setupOnce(setup));
+    EXPECT_EQ(setups,4);
+}
+
+TEST_F(ConnectionPoolTest, leaseOutlivesPool) {
+    std::optional<ConnectionPool<FakeConnection>::Lease> lease;
+    {
+        auto pool = makePool(1);
+        lease = pool.lease();
+    }
+    EXPECT_EQ((*lease)->id,0);
+    EXPECT_NO_FATAL_FAILURE(lease.reset());
+}
+
+TEST_F(ConnectionPoolTest, concurrentLeases) {
+    constexpr size_t maxSize = 3;
+    auto pool = makePool(maxSize);
+    std::atomic_size_t inUse = 0;
+    std::atomic_size_t maxInUse = 0;
+    std::vector<std::thread> threads;
+    for(size_t thread = 0; thread < 8; ++thread) {
+        threads.emplace_back([&](){
+            for(size_t i = 0; i < 1000; ++i) {
+                auto lease = pool.lease();
+                size_t current = ++inUse;
+                size_t previousMax = maxInUse;
+                while(previousMax < current && not maxInUse.compare_exchange_weak(previousMax,current));
+                EXPECT_TRUE(lease->execute(CipherQuery("RETURN 1")));
+                --inUse;
+            }
+        });
+    }
+    for(auto & thread: threads) {
+        thread.join();
+    }
+    EXPECT_LE(maxInUse,maxSize);
+    EXPECT_LE(created,maxSize);
+    EXPECT_EQ(pool.idleCount(),pool.size());
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <deque>
+#include <fishnet/MemgraphClient.hpp>
+#include "Testutil.h"
+
+using namespace testutil;
+
+/**
+ * @brief In-process connection answering the batched edge existence query from a set of edges, without a database
+ */
+class MockConnection {
+public:
+    struct Cursor {
+        std::deque<std::vector<mg::Value>> rows;
+
+        std::optional<std::vector<mg::Value>> FetchOne() {
+            if(rows.empty())
+                return std::nullopt;
+            auto row = std::move(rows.front());
+            rows.pop_front();
+            return row;
+        }
+    };
+
+    std::set<std::pair<NodeIdType,NodeIdType>> edges;
+    mutable Cursor cursor;
+    mutable size_t queries = 0;
+    bool fail = false;
+
+    bool execute(const CipherQuery & query) const {
+        queries++;
+        cursor.rows.clear();
+        if(fail)
+            return false;
+        EXPECT_TRUE(query.asString().starts_with("UNWIND $data"));
+        for(const auto & edge: query.getParameters().at("data").ValueList()) {
+            auto attributes = edge.ValueMap();
+            auto from = asNodeIdType(attributes["from"].ValueInt());
+            auto to = asNodeIdType(attributes["to"].ValueInt());
+            if(edges.contains({from,to})) {
+                cursor.rows.push_back({mg::Value(attributes["index"].ValueInt())});
+            }
+        }
+        return true;
+    }
+
+    bool executeAndDiscard(const CipherQuery & query) const {
+        bool success = execute(query);
+        cursor.rows.clear();
+        return success;
+    }
+
+    const MockConnection & retry() const {
+        return *this;
+    }
+
+    Cursor * operator->() const noexcept {
+        return &cursor;
+    }
+};
+static_assert(CipherConnection<MockConnection>);
+
+class MemgraphClientTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        for(NodeIdType id = 0; id < 100; id += 2) {
+            connection.edges.emplace(id,id+1);
+        }
+        for(NodeIdType id = 0; id < 100; ++id) {
+            queriedEdges.emplace_back(id,id+1);
+        }
+    }
+    MockConnection connection;
+    std::vector<std::pair<NodeIdType,NodeIdType>> queriedEdges;
+};
+
+TEST_F(MemgraphClientTest, containsEdges) {
+    auto existing = MemgraphClient::containsEdges(connection,queriedEdges);
+    ASSERT_EQ(existing.size(),queriedEdges.size());
+    for(size_t i = 0; i < queriedEdges.size(); ++i) {
+        EXPECT_EQ(existing[i],connection.edges.contains(queriedEdges[i]));
+    }
+    EXPECT_EQ(connection.queries,1);
+}
+
+TEST_F(MemgraphClientTest, batches) {
+    auto existing = MemgraphClient::containsEdges(connection,queriedEdges,30);
+    ASSERT_EQ(existing.size(),queriedEdges.size());
+    for(size_t i = 0; i < queriedEdges.size(); ++i) {
+        EXPECT_EQ(existing[i],i % 2 == 0);
+    }
+    EXPECT_EQ(connection.queries,4);
+}
+
+TEST_F(MemgraphClientTest, empty) {
+    EXPECT_EMPTY(MemgraphClient::containsEdges(connection,std::vector<std::pair<NodeIdType,NodeIdType>>()));
+    EXPECT_EQ(connection.queries,0);
+}
+
+TEST_F(MemgraphClientTest, failedQuery) {
+    connection.fail = true;
+    auto existing = MemgraphClient::containsEdges(connection,queriedEdges,10);
+    EXPECT_SIZE(existing,queriedEdges.size());
+    EXPECT_TRUE(std::ranges::none_of(existing,[](bool exists){return exists;}));
+    EXPECT_EQ(connection.queries,10);
+}
@@ -84,9 +84,26 @@ TEST_F(MemgraphTest, addAdjacencies){
         edges.emplace_back(ExampleNode(index,fileRef),ExampleNode(index+1,fileRef));
     }
     EXPECT_TRUE(mgAdj->addAdjacencies(edges));
-    for(const auto & [from,to]:edges) {
-        EXPECT_TRUE(mgAdj->hasAdjacency(from,to));
+    EXPECT_TRUE(std::ranges::all_of(mgAdj->hasAdjacencies(edges),std::identity()));
+}
+
+TEST_F(MemgraphTest, hasAdjacencies){
+    std::vector<std::pair<ExampleNode,ExampleNode>> edges;
+    for(size_t index = 0;index < 20;index += 2){
+        edges.emplace_back(ExampleNode(index,fileRef),ExampleNode(index+1,fileRef));
     }
+    EXPECT_TRUE(mgAdj->addAdjacencies(edges | std::views::take(5)));
+    auto existing = mgAdj->hasAdjacencies(edges);
+    auto existingInDatabase = mgAdj->getDatabaseConnection().containsEdges(edges | std::views::transform([](const auto & pair){
+        return std::make_pair(pair.first.key(),pair.second.key());
+    }),3);
+    ASSERT_EQ(existing.size(),edges.size());
+    for(size_t i = 0; i < edges.size(); ++i) {
+        EXPECT_EQ(existing[i],i < 5);
+        EXPECT_EQ(existingInDatabase[i],i < 5);
+    }
+    EXPECT_TRUE(mgAdj->addAdjacencies(edges));
+    EXPECT_TRUE(std::ranges::all_of(mgAdj->hasAdjacencies(edges),std::identity()));
 }
 
 TEST_F(MemgraphTest, addNode){
@@ -166,17 +183,13 @@ TEST_F(MemgraphTest, removeAdjacencies) {
         edges.emplace_back(ExampleNode(index,fileRef),ExampleNode(index+1,fileRef));
     }
     EXPECT_TRUE(mgAdj->addAdjacencies(edges));
-    for(const auto & [from,to]:edges) {
-        EXPECT_TRUE(mgAdj->hasAdjacency(from,to));
-    }
+    EXPECT_TRUE(std::ranges::all_of(mgAdj->hasAdjacencies(edges),std::identity()));
     auto removedEdges = std::views::all(edges) | std::views::filter([](const auto & pair){
         return pair.first.key() != 0;
     });
     EXPECT_SIZE(removedEdges,amount-1);
     EXPECT_TRUE(mgAdj->removeAdjacencies(removedEdges));
-    for(const auto & [from,to]:removedEdges) {
-        EXPECT_FALSE(mgAdj->hasAdjacency(from,to));
-    }
+    EXPECT_TRUE(std::ranges::none_of(mgAdj->hasAdjacencies(removedEdges),std::identity()));
     const auto & [from,to] = edges.front(); //first edge was not removed
     EXPECT_TRUE(mgAdj->hasAdjacency(from,to));
 }
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <thread>
 #include "Testutil.h"
 #include <fishnet/MemgraphClient.hpp>
 #include "JobAdjacency.hpp"
@@ -65,3 +66,31 @@ TEST_F(ConcurrentSessionsTest, reset){
 }
 
 
+
+TEST_F(ConcurrentSessionsTest, createKeepsSession){
+    std::atomic_bool changed = false;
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; ++i) {
+        threads.emplace_back([this,&changed]{ // tasks of an in-process executor create connections for the session of the process
+            for(int j = 0; j < 10; ++j) {
+                auto eitherConnection = MemgraphConnection::create(WorkflowTestEnvironment::memgraphParams(),initialSession.id());
+                if(not eitherConnection || MemgraphConnection::getSession().id() != initialSession.id())
+                    changed = true;
+            }
+        });
+    }
+    for(auto & thread: threads)
+        thread.join();
+    EXPECT_FALSE(changed);
+    EXPECT_SIZE(adj->getAdjacencyPairs(),1);
+}
+
+TEST_F(ConcurrentSessionsTest, createLoadsSession){
+    MemgraphConnection::resetSession();
+    EXPECT_TRUE(MemgraphConnection::create(WorkflowTestEnvironment::memgraphParams(),initialSession.id()).has_value());
+    EXPECT_TRUE(MemgraphConnection::hasSession());
+    EXPECT_EQ(MemgraphConnection::getSession().id(),initialSession.id());
+    Session other = Session::makeUnique(connection);
+    EXPECT_TRUE(MemgraphConnection::create(WorkflowTestEnvironment::memgraphParams(),other.id()).has_value());
+    EXPECT_EQ(MemgraphConnection::getSession().id(),other.id());
+}
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+#include "Testutil.h"
+#include <fishnet/Polygon.hpp>
+#include "ContractionTask.h"
+#include "../WorkflowTestEnvironment.hpp"
+
+using namespace testutil;
+
+class ContractionTaskTest: public ::testing::Test {
+protected:
+    MemgraphClient client {MemgraphConnection::create(WorkflowTestEnvironment::memgraphParams()).value_or_throw()};
+    FileReference fileRef;
+
+    void SetUp() override {
+        auto optFileRef = client.addFileReference("contracted.shp");
+        ASSERT_TRUE(optFileRef.has_value());
+        fileRef = optFileRef.value();
+    }
+
+    void TearDown() override {
+        client.getMemgraphConnection().executeAndDiscard(CipherQuery::DELETE_ALL());
+    }
+};
+
+TEST_F(ContractionTaskTest, resultEdgesFromBothEndpoints) {
+    using Task_t = ContractionTask<fishnet::geometry::Polygon<double>>;
+    std::vector<NodeReference> resultNodes {NodeReference{1,fileRef},NodeReference{2,fileRef},NodeReference{3,fileRef}}; // index: component-id
+    std::vector<std::pair<int,int>> resultEdges {{1,0},{2,1}}; // each edge once, leading to the component emitted before
+    ASSERT_TRUE(client.insertNodes(resultNodes));
+    ASSERT_TRUE(Task_t::insertResultEdges(client,resultNodes,resultEdges));
+    EXPECT_UNSORTED_RANGE_EQ(client.adjacency(resultNodes[0]),std::vector<NodeIdType>({2}));
+    EXPECT_UNSORTED_RANGE_EQ(client.adjacency(resultNodes[1]),std::vector<NodeIdType>({1,3}));
+    EXPECT_UNSORTED_RANGE_EQ(client.adjacency(resultNodes[2]),std::vector<NodeIdType>({2}));
+    EXPECT_TRUE(Task_t::insertResultEdges(client,resultNodes,{}));
+}
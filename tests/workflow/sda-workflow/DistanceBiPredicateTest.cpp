@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <fishnet/SimplePolygon.hpp>
+#include "DistanceBiPredicate.hpp"
+#include "ShapeSamples.h"
+using namespace fishnet::geometry;
+
+/**
+ * @brief Small boxes around random offsets of a center, in units of the coordinate system
+ */
+static std::vector<SimplePolygon<double>> randomBoxes(Vec2DReal center, double spread, double size, size_t count, unsigned seed) {
+    std::mt19937 generator {seed};
+    std::uniform_real_distribution<double> offset {-spread,spread};
+    std::vector<SimplePolygon<double>> boxes;
+    for(size_t i = 0; i < count; ++i) {
+        Vec2DReal topLeft {center.x + offset(generator),center.y + offset(generator)};
+        boxes.push_back(SimplePolygonSamples::aaBB(topLeft,{topLeft.x + size,topLeft.y - size}));
+    }
+    return boxes;
+}
+
+static void expectBatchMatchesPairwise(const auto & predicate, const std::vector<SimplePolygon<double>> & polygons) {
+    for(size_t i = 0; i < polygons.size(); i += 17) {
+        auto within = predicate.withinDistance(polygons[i],polygons);
+        ASSERT_EQ(within.size(),polygons.size());
+        for(size_t j = 0; j < polygons.size(); ++j) {
+            EXPECT_EQ(within[j],predicate(polygons[i],polygons[j])) << i << " " << j;
+        }
+    }
+}
+
+TEST(DistanceBiPredicateTest, batchMatchesPairwiseWGS84) {
+    auto polygons = randomBoxes({13.4,52.5},0.05,0.001,300,42);
+    auto far = randomBoxes({139.7,35.7},0.05,0.001,20,43); // decided by the exact distance
+    polygons.insert(polygons.end(),far.begin(),far.end());
+    for(double maxDistance: {500.0,2000.0,9e6}) {
+        expectBatchMatchesPairwise(DistanceBiPredicate<DistanceFunction>{WGS84Distance(),maxDistance},polygons);
+        expectBatchMatchesPairwise(DistanceBiPredicate<WGS84Distance>{WGS84Distance(),maxDistance},polygons);
+    }
+}
+
+TEST(DistanceBiPredicateTest, batchMatchesPairwiseMetric) {
+    auto polygons = randomBoxes({500000,5000000},5000,100,300,44);
+    for(double maxDistance: {100.0,1000.0}) {
+        expectBatchMatchesPairwise(DistanceBiPredicate<DistanceFunction>{MetricDistance(),maxDistance},polygons);
+        expectBatchMatchesPairwise(DistanceBiPredicate<MetricDistance>{MetricDistance(),maxDistance},polygons);
+    }
+}
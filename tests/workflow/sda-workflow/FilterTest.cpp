@@ -3,8 +3,11 @@
 #include "ProjectedAreaFilter.hpp"
 #include <fishnet/WGS84Ellipsoid.hpp>
 #include "InsidePolygonFilter.hpp"
+#include <fishnet/Polygon.hpp>
 #include "ShapeSamples.h"
 #include "Testutil.h"
+#include <numbers>
+#include <cmath>
 using namespace fishnet;
 
 static double SQUARE_KILOMETER_IN_SQM = 1000000.0;
@@ -33,4 +36,39 @@ TEST(FilterTest, InsideBoundaryFilter) {
     EXPECT_FALSE(filter(box,inside));
     EXPECT_FALSE(filter(box,box));
     EXPECT_TRUE(filter(box,intersecting));
-}
\ No newline at end of file
+}
+
+TEST(FilterTest, InsideBoundaryFilterLargeBoundary) {
+    using namespace fishnet::geometry;
+    std::vector<Vec2D<double>> circle;
+    for(int i = 0; i < 256; ++i) {
+        double angle = 2 * std::numbers::pi * i / 256;
+        circle.emplace_back(10 * std::cos(angle),10 * std::sin(angle));
+    }
+    Polygon<double> enclosing {Ring<double>(circle),{LinearRingSamples::aaBB({-2,2},{2,-2})}};
+    std::vector<Polygon<double>> underTest {
+        SimplePolygonSamples::triangle({4,4},{5,4},{4,5}), // contained
+        SimplePolygonSamples::aaBB({-1,1},{1,-1}), // inside the hole
+        SimplePolygonSamples::aaRhombus({10,0},2), // crosses the boundary
+        SimplePolygonSamples::aaRhombus({2,0},1), // crosses the hole
+        SimplePolygonSamples::aaBB({-3,3},{3,-3}), // contains the hole
+        SimplePolygonSamples::aaBB({20,20},{21,19}), // disjoint
+        enclosing
+    };
+    InsidePolygonFilter filter;
+    std::vector<bool> expected {false,false,true,true,true,true,false};
+    for(int repetition = 0; repetition < 2; ++repetition) { // second repetition reuses the prepared boundary
+        for(size_t i = 0; i < underTest.size(); ++i) {
+            EXPECT_EQ(filter(enclosing,underTest[i]),expected[i]) << i;
+            EXPECT_EQ(filter(enclosing,underTest[i]),ContainedOrInHoleFilter()(enclosing,underTest[i])) << i;
+        }
+    }
+    auto copy = filter;
+    std::vector<Vec2D<double>> shiftedCircle;
+    for(const auto & p: circle) {
+        shiftedCircle.push_back(p + Vec2D<double>(100,0));
+    }
+    Polygon<double> shifted {Ring<double>(shiftedCircle)};
+    EXPECT_TRUE(copy(shifted,underTest[0]));
+    EXPECT_FALSE(copy(enclosing,underTest[0]));
+}
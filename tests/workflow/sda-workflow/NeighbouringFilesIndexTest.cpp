@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "Testutil.h"
+#include "NeighbouringFilesIndex.hpp"
+
+using namespace testutil;
+
+template<typename P>
+class NeighbouringFilesIndexTest: public ::testing::Test {
+protected:
+    using Adjacency = std::unordered_map<std::filesystem::path,std::unordered_set<std::filesystem::path>>;
+
+    /**
+     * @brief Tests every pair of files with the predicate, as the job generator did before the index
+     */
+    static Adjacency pairwise(const std::vector<std::filesystem::path> & inputs) {
+        P predicate;
+        Adjacency dependencyMap;
+        for(const auto & lhsInput : inputs){
+            dependencyMap.try_emplace(lhsInput,std::unordered_set<std::filesystem::path>());
+            for(const auto & rhsInput : inputs){
+                if(lhsInput == rhsInput)
+                    continue;
+                if(predicate(lhsInput,rhsInput))
+                    dependencyMap.at(lhsInput).insert(rhsInput);
+            }
+        }
+        return dependencyMap;
+    }
+
+    std::vector<std::filesystem::path> files;
+
+    void SetUp() override {
+        for(int x = -4; x <= 4; ++x) {
+            for(int y = -4; y <= 4; ++y) {
+                if((x*7+y*3) % 5 == 0)
+                    continue; // gaps in the grid
+                files.emplace_back("input/settlements_"+std::to_string(x)+"_"+std::to_string(y)+".shp");
+            }
+        }
+        files.emplace_back("input/other_0_0.shp"); // same coordinate as another file
+        files.emplace_back("input/other_2_-1.tif"); // only matching the WSF pattern
+        files.emplace_back("input/settlements.shp"); // no coordinate
+        files.emplace_back("input/settlements_1_x.shp");
+    }
+};
+
+using Predicates = ::testing::Types<NeighbouringFileTilesPredicate,NeighbouringWSFFilesPredicate>;
+TYPED_TEST_SUITE(NeighbouringFilesIndexTest,Predicates);
+
+TYPED_TEST(NeighbouringFilesIndexTest, matchesPairwisePredicate) {
+    auto expected = this->pairwise(this->files);
+    auto actual = NeighbouringFilesIndex<TypeParam>(this->files).adjacency();
+    EXPECT_EQ(actual.size(),expected.size());
+    for(const auto & [file,neighbours]: expected) {
+        ASSERT_TRUE(actual.contains(file)) << file;
+        EXPECT_EQ(actual.at(file),neighbours) << file;
+    }
+}
+
+TYPED_TEST(NeighbouringFilesIndexTest, empty) {
+    EXPECT_TRUE(NeighbouringFilesIndex<TypeParam>(std::vector<std::filesystem::path>()).adjacency().empty());
+}